@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -770,6 +770,35 @@ public abstract class View {
         }
     }
 
+    /**
+     * Uploads only the damaged parts of the pixels. The default
+     * implementation uploads the whole pixels.
+     *
+     * @param dirtyRects the damaged rectangles stored as
+     *        (x, y, width, height) quadruples, or null for the whole view
+     */
+    protected void _uploadPixels(long ptr, Pixels pixels, int[] dirtyRects) {
+        _uploadPixels(ptr, pixels);
+    }
+    /**
+     * This method dumps the damaged parts of the pixels on to the view.
+     * The rest of the view is expected to be up to date already.
+     *
+     * @param pixels the pixels of the whole view
+     * @param dirtyRects the damaged rectangles stored as
+     *        (x, y, width, height) quadruples, or null for the whole view
+     */
+    public void uploadPixels(Pixels pixels, int[] dirtyRects) {
+        Application.checkEventThread();
+        checkNotClosed();
+        lock();
+        try {
+            _uploadPixels(this.ptr, pixels, dirtyRects);
+        } finally {
+            unlock();
+        }
+    }
+
 
     //-------- FULLSCREEN --------//
 
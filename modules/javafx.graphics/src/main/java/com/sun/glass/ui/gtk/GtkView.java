@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -85,25 +85,30 @@ final class GtkView extends View {
 
     @Override
     protected void _uploadPixels(long ptr, Pixels pixels) {
+        _uploadPixels(ptr, pixels, null);
+    }
+
+    @Override
+    protected void _uploadPixels(long ptr, Pixels pixels, int[] dirtyRects) {
         Buffer data = pixels.getPixels();
         if (data.isDirect() == true) {
-            _uploadPixelsDirect(ptr, data, pixels.getWidth(), pixels.getHeight());
+            _uploadPixelsDirect(ptr, data, pixels.getWidth(), pixels.getHeight(), dirtyRects);
         } else if (data.hasArray() == true) {
             if (pixels.getBytesPerComponent() == 1) {
                 ByteBuffer bytes = (ByteBuffer)data;
-                _uploadPixelsByteArray(ptr, bytes.array(), bytes.arrayOffset(), pixels.getWidth(), pixels.getHeight());
+                _uploadPixelsByteArray(ptr, bytes.array(), bytes.arrayOffset(), pixels.getWidth(), pixels.getHeight(), dirtyRects);
             } else {
                 IntBuffer ints = (IntBuffer)data;
-                _uploadPixelsIntArray(ptr, ints.array(), ints.arrayOffset(), pixels.getWidth(), pixels.getHeight());
+                _uploadPixelsIntArray(ptr, ints.array(), ints.arrayOffset(), pixels.getWidth(), pixels.getHeight(), dirtyRects);
             }
         } else {
             // gznote: what are the circumstances under which this can happen?
-            _uploadPixelsDirect(ptr, pixels.asByteBuffer(), pixels.getWidth(), pixels.getHeight());
+            _uploadPixelsDirect(ptr, pixels.asByteBuffer(), pixels.getWidth(), pixels.getHeight(), dirtyRects);
         }
     }
-    private native void _uploadPixelsDirect(long viewPtr, Buffer pixels, int width, int height);
-    private native void _uploadPixelsByteArray(long viewPtr, byte[] pixels, int offset, int width, int height);
-    private native void _uploadPixelsIntArray(long viewPtr, int[] pixels, int offset, int width, int height);
+    private native void _uploadPixelsDirect(long viewPtr, Buffer pixels, int width, int height, int[] dirtyRects);
+    private native void _uploadPixelsByteArray(long viewPtr, byte[] pixels, int offset, int width, int height, int[] dirtyRects);
+    private native void _uploadPixelsIntArray(long viewPtr, int[] pixels, int offset, int width, int height, int[] dirtyRects);
 
     @Override
     protected native boolean _enterFullscreen(long ptr, boolean animate, boolean keepRatio, boolean hideCursor);
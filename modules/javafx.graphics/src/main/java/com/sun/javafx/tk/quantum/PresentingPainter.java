@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,7 @@
 
 package com.sun.javafx.tk.quantum;
 
+import com.sun.javafx.geom.Rectangle;
 import com.sun.javafx.logging.PulseLogger;
 import static com.sun.javafx.logging.PulseLogger.PULSE_LOGGING_ENABLED;
 import com.sun.prism.Graphics;
@@ -88,15 +89,17 @@ final class PresentingPainter extends ViewPainter {
                 Graphics g = presentable.createGraphics();
 
                 ViewScene vs = (ViewScene) sceneState.getScene();
+                Rectangle dirtyRegion = null;
                 if (g != null) {
                     paintImpl(g);
                     freshBackBuffer = false;
+                    dirtyRegion = getPaintedRegion();
                 }
 
                 if (PULSE_LOGGING_ENABLED) {
                     PulseLogger.newPhase("Presenting");
                 }
-                if (!presentable.prepare(null)) {
+                if (!presentable.prepare(dirtyRegion)) {
                     disposePresentable();
                     sceneState.getScene().entireSceneNeedsRepaint();
                     return;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -99,6 +99,8 @@ abstract class ViewPainter implements Runnable {
     // and if dirty opts are turned off via a runtime flag, then these fields
     // are never initialized or used.
     private Rectangle dirtyRect;
+    private Rectangle paintedRegion;
+    private boolean paintedEverything = true;
     private RectBounds clip;
     private RectBounds dirtyRegionTemp;
     private DirtyRegionPool dirtyRegionPool;
@@ -136,6 +138,7 @@ abstract class ViewPainter implements Runnable {
             scaleTx = new Affine3D();
             clip = new RectBounds();
             dirtyRect = new Rectangle();
+            paintedRegion = new Rectangle();
             dirtyRegionTemp = new RectBounds();
             dirtyRegionPool = new DirtyRegionPool(PrismSettings.dirtyRegionCount);
             dirtyRegionContainer = dirtyRegionPool.checkOut();
@@ -162,7 +165,18 @@ abstract class ViewPainter implements Runnable {
         }
     }
 
+    /**
+     * Returns the bounds, in back buffer pixels, of the area painted by the
+     * last call to paintImpl. The returned rectangle is empty if nothing
+     * was painted, and null if the whole back buffer was painted.
+     */
+    protected final Rectangle getPaintedRegion() {
+        return paintedEverything ? null : paintedRegion;
+    }
+
     protected void paintImpl(final Graphics backBufferGraphics) {
+        paintedEverything = true;
+
         // We should not be painting anything with a width / height
         // that is <= 0, so we might as well bail right off.
         if (width <= 0 || height <= 0 || backBufferGraphics == null) {
@@ -304,6 +318,8 @@ abstract class ViewPainter implements Runnable {
             }
 
             // Paint each dirty region
+            paintedRegion.setBounds(0, 0, -1, -1);
+            paintedEverything = showDirtyOpts;
             for (int i = 0; i < dirtyRegionSize; ++i) {
                 final RectBounds dirtyRegion = dirtyRegionContainer.getDirtyRegion(i);
                 // TODO it should be impossible to have ever created a dirty region that was empty...
@@ -318,6 +334,7 @@ abstract class ViewPainter implements Runnable {
                     dirtyRect.height = (int) Math.ceil (dirtyRegion.getMaxY() * pixelScaleY) - y0;
                     g.setClipRect(dirtyRect);
                     g.setClipRectIndex(i);
+                    paintedRegion.add(dirtyRect);
                     doPaint(g, getRootPath(i));
                     getRootPath(i).clear();
                 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -148,6 +148,22 @@ public final class PiscesRenderer {
 
     private native void setCompositeRuleImpl(int compositeRule);
 
+    /**
+     * Sets the number of threads used to paint large fills. When more than one thread is
+     * requested, rectangle, image and alpha mask fills that cover many pixels are split into
+     * horizontal tiles which are painted in parallel by a shared pool of worker threads.
+     * Every tile paints its own rows, so the result is identical to single-threaded rendering.
+     * @param threads number of threads, including the calling one; 1 disables tiled rendering
+     */
+    public void setTileThreads(int threads) {
+        if (threads < 1) {
+            throw new IllegalArgumentException("Number of tile threads must be positive");
+        }
+        this.setTileThreadsImpl(threads);
+    }
+
+    private native void setTileThreadsImpl(int threads);
+
     private native void setLinearGradientImpl(int x0, int y0, int x1, int y1,
                                               int[] colors,
                                               int cycleMethod,
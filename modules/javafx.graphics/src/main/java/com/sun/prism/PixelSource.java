@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2014, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,6 +26,7 @@
 package com.sun.prism;
 
 import com.sun.glass.ui.Pixels;
+import com.sun.javafx.geom.Rectangle;
 
 /**
  * An interface to facilitate the asynchronous delivery of frames of pixels
@@ -59,6 +60,19 @@ public interface PixelSource {
      */
     public void doneWithPixels(Pixels used);
 
+    /**
+     * Gets the area of the {@code Pixels} object last returned by
+     * {@link #getLatestPixels()} that changed since the previous set of
+     * pixels was processed, including the changes of any deliveries that
+     * were superseded in the meantime.
+     * This method should only be called by the consumer between the calls
+     * to {@code getLatestPixels()} and {@code doneWithPixels()}.
+     *
+     * @return the changed area in pixels, or null if all of the pixels
+     *         need to be processed
+     */
+    public Rectangle getLatestDirtyRegion();
+
     /**
      * A one step method for skipping a pixel delivery object in the case
      * where the consumer is not ready to process any pixels.
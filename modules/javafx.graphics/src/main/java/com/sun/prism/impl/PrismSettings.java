@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -60,6 +60,7 @@ public final class PrismSettings {
     public static final boolean showOverdraw;
     public static final boolean printRenderGraph;
     public static final int minRTTSize;
+    public static final int swTileThreads;
     public static final int dirtyRegionCount;
     public static final boolean disableBadDriverWarning;
     public static final boolean forceGPU;
@@ -322,6 +323,13 @@ public final class PrismSettings {
        minRTTSize = getInt(systemProperties, "prism.minrttsize",
                PlatformUtil.isEmbedded() ? 16 : 0, "Try -Dprism.minrttsize=<number>");
 
+        /*
+         * Number of threads the software pipeline uses to paint large
+         * fills. The default of 1 keeps all rendering on the render thread.
+         */
+        swTileThreads = Utils.clamp(1, getInt(systemProperties, "prism.sw.threads",
+                1, "Try -Dprism.sw.threads=<number>"), 32);
+
         disableRegionCaching = getBoolean(systemProperties,
                                           "prism.disableRegionCaching",
                                           false);
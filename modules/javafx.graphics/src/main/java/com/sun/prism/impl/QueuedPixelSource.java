@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2014, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -27,6 +27,7 @@ package com.sun.prism.impl;
 
 import com.sun.glass.ui.Application;
 import com.sun.glass.ui.Pixels;
+import com.sun.javafx.geom.Rectangle;
 import com.sun.prism.PixelSource;
 import java.lang.ref.WeakReference;
 import java.nio.IntBuffer;
@@ -57,10 +58,22 @@ import java.util.List;
  * get really bad with multiple deliveries enqueued during the processing
  * of a single earlier delivery will we end up with three sets of
  * {@code Pixels} objects in play.
+ * <p>
+ * The area changed by each delivery can be supplied along with it. The
+ * changes of deliveries that are superseded or skipped before they are
+ * consumed are accumulated, so the consumer can update only the area that
+ * changed since the last set of pixels it processed.
  */
 public class QueuedPixelSource implements PixelSource {
     private volatile Pixels beingConsumed;
     private volatile Pixels enqueued;
+    // The dirty regions of the enqueued and consumed pixels,
+    // null when all of the pixels have to be processed.
+    private Rectangle enqueuedDirty;
+    private Rectangle consumedDirty;
+    // Set when a delivery was skipped, so that the changes it carried
+    // are not lost for the next one.
+    private boolean dirtyLost;
     private final List<WeakReference<Pixels>> saved =
          new ArrayList<>(3);
     private final boolean useDirectBuffers;
@@ -76,17 +89,25 @@ public class QueuedPixelSource implements PixelSource {
         }
         if (enqueued != null) {
             beingConsumed = enqueued;
+            consumedDirty = enqueuedDirty;
             enqueued = null;
+            enqueuedDirty = null;
         }
         return beingConsumed;
     }
 
+    @Override
+    public synchronized Rectangle getLatestDirtyRegion() {
+        return consumedDirty;
+    }
+
     @Override
     public synchronized void doneWithPixels(Pixels used) {
         if (beingConsumed != used) {
             throw new IllegalStateException("wrong pixels buffer: "+used+" != "+beingConsumed);
         }
         beingConsumed = null;
+        consumedDirty = null;
     }
 
     @Override
@@ -94,7 +115,11 @@ public class QueuedPixelSource implements PixelSource {
         if (beingConsumed != null) {
             throw new IllegalStateException("cannot skip while processing: "+beingConsumed);
         }
-        enqueued = null;
+        if (enqueued != null) {
+            enqueued = null;
+            enqueuedDirty = null;
+            dirtyLost = true;
+        }
     }
 
     private boolean usesSameBuffer(Pixels p1, Pixels p2) {
@@ -170,6 +195,31 @@ public class QueuedPixelSource implements PixelSource {
      * @param pixels the {@code Pixels} object to be enqueued
      */
     public synchronized void enqueuePixels(Pixels pixels) {
+        enqueuePixels(pixels, null);
+    }
+
+    /**
+     * Place the indicated {@code Pixels} object into the enqueued state,
+     * as {@link #enqueuePixels(Pixels)} does, along with the area that
+     * changed since the previous delivery.
+     * If the previous delivery is still enqueued its dirty region is merged
+     * into this one.
+     *
+     * @param pixels the {@code Pixels} object to be enqueued
+     * @param dirty the changed area in pixels, or null if all of the pixels
+     *        changed
+     */
+    public synchronized void enqueuePixels(Pixels pixels, Rectangle dirty) {
+        if (dirty == null || dirtyLost ||
+            (enqueued != null && enqueuedDirty == null))
+        {
+            enqueuedDirty = null;
+        } else if (enqueued != null) {
+            enqueuedDirty.add(dirty);
+        } else {
+            enqueuedDirty = new Rectangle(dirty);
+        }
+        dirtyLost = false;
         enqueued = pixels;
     }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -36,6 +36,7 @@ final class SWPresentable extends SWRTTexture implements Presentable {
 
     private final PresentableState pState;
     private Pixels pixels;
+    private Rectangle dirty;
     private QueuedPixelSource pixelSource = new QueuedPixelSource(false);
 
     public SWPresentable(PresentableState pState, SWResourceFactory factory) {
@@ -55,7 +56,6 @@ final class SWPresentable extends SWRTTexture implements Presentable {
             /*
              * RT-27374
              * TODO: make sure the imgrep matches the Pixels.getNativeFormat()
-             * TODO: dirty region support
              */
             int w = getPhysicalWidth();
             int h = getPhysicalHeight();
@@ -64,6 +64,9 @@ final class SWPresentable extends SWRTTexture implements Presentable {
             IntBuffer buf = getSurface().getDataIntBuffer();
             assert buf.hasArray();
             System.arraycopy(buf.array(), 0, pixBuf.array(), 0, w*h);
+            // Only the dirty region is uploaded to the view, the pixels
+            // outside of it are already on the screen.
+            dirty = dirtyregion;
             return true;
         } else {
             return false;
@@ -72,7 +75,7 @@ final class SWPresentable extends SWRTTexture implements Presentable {
 
     @Override
     public boolean present() {
-        pixelSource.enqueuePixels(pixels);
+        pixelSource.enqueuePixels(pixels, dirty);
         pState.uploadPixels(pixelSource);
         return true;
     }
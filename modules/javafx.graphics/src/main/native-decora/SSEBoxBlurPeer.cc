@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,6 +30,7 @@
 
 #include <jni.h>
 #include "SSEUtils.h"
+#include "SSEBoxKernels.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSEBoxBlurPeer.h"
 
 JNIEXPORT void JNICALL
@@ -53,6 +54,14 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxBlurPeer_filterHorizontal
         return;
     }
 
+    if (boxBlurHorizontalSIMD(dstPixels, dstw, dsth, dstscan,
+                              srcPixels, srcw, srcscan))
+    {
+        env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
+    }
+
     jint hsize = dstw - srcw + 1;
     jint kscale = 0x7fffffff / (hsize * 255);
     jint srcoff = 0;
@@ -111,6 +120,14 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxBlurPeer_filterVertical
         return;
     }
 
+    if (boxBlurVerticalSIMD(dstPixels, dstw, dsth, dstscan,
+                            srcPixels, srch, srcscan))
+    {
+        env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
+    }
+
     jint vsize = dsth - srch + 1;
     jint kscale = 0x7fffffff / (vsize * 255);
     jint voff = vsize * srcscan;
@@ -0,0 +1,716 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stdlib.h>
+#include "SSEBoxKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BOX_KERNELS_X86
+#endif
+
+#ifdef BOX_KERNELS_X86
+
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+/*
+ * The library is not compiled with -msse2 or -mavx2, so the kernels are
+ * compiled for their instruction set individually and only called after
+ * the CPU has been checked.  MSVC accepts the intrinsics without flags.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+enum {
+    SIMD_UNKNOWN = -1,
+    SIMD_NONE,
+    SIMD_SSE2,
+    SIMD_AVX2
+};
+
+static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex(r, (int) leaf, (int) subleaf);
+    for (int i = 0; i < 4; i++) {
+        regs[i] = (unsigned int) r[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned int xgetbv0() {
+#ifdef _MSC_VER
+    return (unsigned int) _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    // xgetbv, spelled out for assemblers that do not know the mnemonic
+    __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+#endif
+}
+
+static int detectSIMDLevel() {
+    unsigned int regs[4];
+    cpuid(0, 0, regs);
+    unsigned int maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return SIMD_NONE;
+    }
+    cpuid(1, 0, regs);
+    if ((regs[3] & (1u << 26)) == 0) {
+        return SIMD_NONE;
+    }
+    // AVX2 also needs the OS to save the YMM state (OSXSAVE + XCR0)
+    const unsigned int osxsaveAVX = (1u << 27) | (1u << 28);
+    if (maxLeaf >= 7 &&
+        (regs[2] & osxsaveAVX) == osxsaveAVX &&
+        (xgetbv0() & 0x6) == 0x6)
+    {
+        cpuid(7, 0, regs);
+        if (regs[1] & (1u << 5)) {
+            return SIMD_AVX2;
+        }
+    }
+    return SIMD_SSE2;
+}
+
+static int simdLevel() {
+    // Racing threads compute the same value, so no locking is needed
+    static volatile int level = SIMD_UNKNOWN;
+    if (level == SIMD_UNKNOWN) {
+        level = detectSIMDLevel();
+    }
+    return level;
+}
+
+/*
+ * SSE2 helpers.
+ *
+ * A blurred pixel is kept as four 32-bit channel sums in B, G, R, A lane
+ * order, which is the byte order of an INT_ARGB pixel in memory.
+ */
+
+// SSE2 has no 32-bit mullo; combine the even and odd 64-bit products.
+TARGET_SSE2
+static inline __m128i mullo_epi32(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+TARGET_SSE2
+static inline __m128i unpackPixel(jint rgb) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(rgb), zero);
+    return _mm_unpacklo_epi16(v, zero);
+}
+
+// (sum * kscale) >> 23 for each channel
+TARGET_SSE2
+static inline __m128i scaleSums(__m128i sums, __m128i kscale) {
+    return _mm_srli_epi32(mullo_epi32(sums, kscale), 23);
+}
+
+TARGET_SSE2
+static inline jint packPixel(__m128i sums, __m128i kscale) {
+    __m128i v = scaleSums(sums, kscale);
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    return _mm_cvtsi128_si32(v);
+}
+
+/*
+ * Clamps, scales and converts four alpha sums into shadow pixels, the
+ * same way the scalar loops in SSEBoxShadowPeer.cc do.
+ */
+struct ShadowScaleSSE2 {
+    __m128i kscalea, kscaler, kscaleg, kscaleb;
+    __m128i amin, amaxMinus1, shadowRGB;
+};
+
+TARGET_SSE2
+static void initShadowScale(ShadowScaleSSE2 *s,
+                            jint kscalea, jint kscaler, jint kscaleg, jint kscaleb,
+                            jint amin, jint amax, jint shadowRGB)
+{
+    s->kscalea = _mm_set1_epi32(kscalea);
+    s->kscaler = _mm_set1_epi32(kscaler);
+    s->kscaleg = _mm_set1_epi32(kscaleg);
+    s->kscaleb = _mm_set1_epi32(kscaleb);
+    s->amin = _mm_set1_epi32(amin);
+    s->amaxMinus1 = _mm_set1_epi32(amax - 1);
+    s->shadowRGB = _mm_set1_epi32(shadowRGB);
+}
+
+TARGET_SSE2
+static inline __m128i shadePixels(__m128i suma, const ShadowScaleSSE2 *s) {
+    __m128i v = _mm_slli_epi32(scaleSums(suma, s->kscalea), 24);
+    v = _mm_or_si128(v, _mm_slli_epi32(scaleSums(suma, s->kscaler), 16));
+    v = _mm_or_si128(v, _mm_slli_epi32(scaleSums(suma, s->kscaleg), 8));
+    v = _mm_or_si128(v, scaleSums(suma, s->kscaleb));
+    __m128i low = _mm_cmplt_epi32(suma, s->amin);
+    __m128i high = _mm_cmpgt_epi32(suma, s->amaxMinus1);
+    v = _mm_andnot_si128(low, v);
+    return _mm_or_si128(_mm_andnot_si128(high, v), _mm_and_si128(high, s->shadowRGB));
+}
+
+// Rows of a 4x4 tile become columns and vice versa.
+TARGET_SSE2
+static inline void transpose4x4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    r0 = _mm_unpacklo_epi64(t0, t1);
+    r1 = _mm_unpackhi_epi64(t0, t1);
+    r2 = _mm_unpacklo_epi64(t2, t3);
+    r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/*
+ * Box blur, SSE2.
+ *
+ * The horizontal pass keeps all four channels of a row in one register.
+ * The vertical pass walks the image in row order and keeps a running sum
+ * per column and channel, so that every load and store is sequential
+ * instead of striding down one column at a time.
+ */
+
+TARGET_SSE2
+static void blurRowSSE2(jint *dst, jint dstw, const jint *src, jint srcw,
+                        jint hsize, __m128i kscale)
+{
+    __m128i sum = _mm_setzero_si128();
+    for (jint x = 0; x < dstw; x++) {
+        if (x >= hsize) {
+            sum = _mm_sub_epi32(sum, unpackPixel(src[x - hsize]));
+        }
+        if (x < srcw) {
+            sum = _mm_add_epi32(sum, unpackPixel(src[x]));
+        }
+        dst[x] = packPixel(sum, kscale);
+    }
+}
+
+TARGET_SSE2
+static void blurHorizontalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srcscan)
+{
+    jint hsize = dstw - srcw + 1;
+    __m128i kscale = _mm_set1_epi32(0x7fffffff / (hsize * 255));
+    for (jint y = 0; y < dsth; y++) {
+        blurRowSSE2(dstPixels + y * dstscan, dstw,
+                    srcPixels + y * srcscan, srcw, hsize, kscale);
+    }
+}
+
+// Adds or subtracts 4 pixels to or from their 16 channel sums.
+TARGET_SSE2
+static inline void accumulate4SSE2(__m128i sums[4], const jint *src, bool add) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i p = _mm_loadu_si128((const __m128i *) src);
+    __m128i lo = _mm_unpacklo_epi8(p, zero);
+    __m128i hi = _mm_unpackhi_epi8(p, zero);
+    __m128i c[4];
+    c[0] = _mm_unpacklo_epi16(lo, zero);
+    c[1] = _mm_unpackhi_epi16(lo, zero);
+    c[2] = _mm_unpacklo_epi16(hi, zero);
+    c[3] = _mm_unpackhi_epi16(hi, zero);
+    for (int i = 0; i < 4; i++) {
+        sums[i] = add ? _mm_add_epi32(sums[i], c[i]) : _mm_sub_epi32(sums[i], c[i]);
+    }
+}
+
+/*
+ * Updates the column sums of one output row from x0 onwards and writes
+ * the row.  addRow and subRow are NULL where the box is outside the source.
+ */
+TARGET_SSE2
+static void blurColumnsSSE2(jint *sums, jint *dst, jint x0, jint dstw,
+                            const jint *addRow, const jint *subRow, __m128i kscale)
+{
+    jint x = x0;
+    for (; x + 4 <= dstw; x += 4) {
+        __m128i *s = (__m128i *) (sums + x * 4);
+        __m128i v[4];
+        for (int i = 0; i < 4; i++) {
+            v[i] = _mm_loadu_si128(s + i);
+        }
+        if (subRow != NULL) {
+            accumulate4SSE2(v, subRow + x, false);
+        }
+        if (addRow != NULL) {
+            accumulate4SSE2(v, addRow + x, true);
+        }
+        for (int i = 0; i < 4; i++) {
+            _mm_storeu_si128(s + i, v[i]);
+        }
+        __m128i lo = _mm_packs_epi32(scaleSums(v[0], kscale), scaleSums(v[1], kscale));
+        __m128i hi = _mm_packs_epi32(scaleSums(v[2], kscale), scaleSums(v[3], kscale));
+        _mm_storeu_si128((__m128i *) (dst + x), _mm_packus_epi16(lo, hi));
+    }
+    for (; x < dstw; x++) {
+        __m128i *s = (__m128i *) (sums + x * 4);
+        __m128i v = _mm_loadu_si128(s);
+        if (subRow != NULL) {
+            v = _mm_sub_epi32(v, unpackPixel(subRow[x]));
+        }
+        if (addRow != NULL) {
+            v = _mm_add_epi32(v, unpackPixel(addRow[x]));
+        }
+        _mm_storeu_si128(s, v);
+        dst[x] = packPixel(v, kscale);
+    }
+}
+
+TARGET_SSE2
+static void blurVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                             jint *srcPixels, jint srch, jint srcscan, jint *sums)
+{
+    jint vsize = dsth - srch + 1;
+    __m128i kscale = _mm_set1_epi32(0x7fffffff / (vsize * 255));
+    for (jint y = 0; y < dsth; y++) {
+        const jint *addRow = (y < srch) ? srcPixels + y * srcscan : NULL;
+        const jint *subRow = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+        blurColumnsSSE2(sums, dstPixels + y * dstscan, 0, dstw, addRow, subRow, kscale);
+    }
+}
+
+/*
+ * Box shadow, SSE2.
+ *
+ * Only the alpha channel is summed, so the horizontal pass runs four rows
+ * side by side.  Each 4x4 tile of source and destination pixels is
+ * transposed in registers so that loads and stores stay row-contiguous.
+ */
+
+static void shadowRowScalar(jint *dst, jint dstw, const jint *src, jint srcw,
+                            jint hsize, jint kscale, jint amin, jint amax)
+{
+    jint suma = 0;
+    for (jint x = 0; x < dstw; x++) {
+        if (x >= hsize) {
+            suma -= (src[x - hsize] >> 24) & 0xff;
+        }
+        if (x < srcw) {
+            suma += (src[x] >> 24) & 0xff;
+        }
+        dst[x] =
+            ((suma < amin) ? 0
+             : ((suma >= amax) ? 0xff000000
+                : (((suma * kscale) >> 23) << 24)));
+    }
+}
+
+TARGET_SSE2
+static inline __m128i alphaColumn(const jint *const rows[4], jint x) {
+    __m128i v = _mm_setr_epi32(rows[0][x], rows[1][x], rows[2][x], rows[3][x]);
+    return _mm_srli_epi32(v, 24);
+}
+
+TARGET_SSE2
+static inline void alphaTile(const jint *const rows[4], jint x, __m128i cols[4]) {
+    for (int i = 0; i < 4; i++) {
+        cols[i] = _mm_loadu_si128((const __m128i *) (rows[i] + x));
+    }
+    transpose4x4(cols[0], cols[1], cols[2], cols[3]);
+    for (int i = 0; i < 4; i++) {
+        cols[i] = _mm_srli_epi32(cols[i], 24);
+    }
+}
+
+TARGET_SSE2
+static void shadowHorizontalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                 jint *srcPixels, jint srcw, jint srcscan,
+                                 jint kscale, jint amin, jint amax)
+{
+    jint hsize = dstw - srcw + 1;
+    ShadowScaleSSE2 scale;
+    initShadowScale(&scale, kscale, 0, 0, 0, amin, amax, (jint) 0xff000000);
+    __m128i zero = _mm_setzero_si128();
+    jint y = 0;
+    for (; y + 4 <= dsth; y += 4) {
+        const jint *src[4];
+        jint *dst[4];
+        for (int i = 0; i < 4; i++) {
+            src[i] = srcPixels + (y + i) * srcscan;
+            dst[i] = dstPixels + (y + i) * dstscan;
+        }
+        __m128i suma = zero;
+        jint x = 0;
+        for (; x + 4 <= dstw; x += 4) {
+            __m128i add[4], sub[4], out[4];
+            if (x + 4 <= srcw) {
+                alphaTile(src, x, add);
+            } else {
+                for (int i = 0; i < 4; i++) {
+                    add[i] = (x + i < srcw) ? alphaColumn(src, x + i) : zero;
+                }
+            }
+            if (x >= hsize) {
+                alphaTile(src, x - hsize, sub);
+            } else {
+                for (int i = 0; i < 4; i++) {
+                    sub[i] = (x + i >= hsize) ? alphaColumn(src, x + i - hsize) : zero;
+                }
+            }
+            for (int i = 0; i < 4; i++) {
+                suma = _mm_add_epi32(_mm_sub_epi32(suma, sub[i]), add[i]);
+                out[i] = shadePixels(suma, &scale);
+            }
+            transpose4x4(out[0], out[1], out[2], out[3]);
+            for (int i = 0; i < 4; i++) {
+                _mm_storeu_si128((__m128i *) (dst[i] + x), out[i]);
+            }
+        }
+        for (; x < dstw; x++) {
+            if (x >= hsize) {
+                suma = _mm_sub_epi32(suma, alphaColumn(src, x - hsize));
+            }
+            if (x < srcw) {
+                suma = _mm_add_epi32(suma, alphaColumn(src, x));
+            }
+            __m128i out = shadePixels(suma, &scale);
+            for (int i = 0; i < 4; i++) {
+                dst[i][x] = _mm_cvtsi128_si32(out);
+                out = _mm_srli_si128(out, 4);
+            }
+        }
+    }
+    for (; y < dsth; y++) {
+        shadowRowScalar(dstPixels + y * dstscan, dstw,
+                        srcPixels + y * srcscan, srcw, hsize, kscale, amin, amax);
+    }
+}
+
+TARGET_SSE2
+static void shadowColumnsSSE2(jint *sums, jint *dst, jint x0, jint dstw,
+                              const jint *addRow, const jint *subRow,
+                              const ShadowScaleSSE2 *scale)
+{
+    jint x = x0;
+    for (; x + 4 <= dstw; x += 4) {
+        __m128i *s = (__m128i *) (sums + x);
+        __m128i suma = _mm_loadu_si128(s);
+        if (subRow != NULL) {
+            __m128i p = _mm_loadu_si128((const __m128i *) (subRow + x));
+            suma = _mm_sub_epi32(suma, _mm_srli_epi32(p, 24));
+        }
+        if (addRow != NULL) {
+            __m128i p = _mm_loadu_si128((const __m128i *) (addRow + x));
+            suma = _mm_add_epi32(suma, _mm_srli_epi32(p, 24));
+        }
+        _mm_storeu_si128(s, suma);
+        _mm_storeu_si128((__m128i *) (dst + x), shadePixels(suma, scale));
+    }
+    for (; x < dstw; x++) {
+        jint suma = sums[x];
+        if (subRow != NULL) {
+            suma -= (subRow[x] >> 24) & 0xff;
+        }
+        if (addRow != NULL) {
+            suma += (addRow[x] >> 24) & 0xff;
+        }
+        sums[x] = suma;
+        dst[x] = _mm_cvtsi128_si32(shadePixels(_mm_cvtsi32_si128(suma), scale));
+    }
+}
+
+TARGET_SSE2
+static void shadowVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srch, jint srcscan, jint *sums,
+                               jint kscalea, jint kscaler, jint kscaleg, jint kscaleb,
+                               jint amin, jint amax, jint shadowRGB)
+{
+    jint vsize = dsth - srch + 1;
+    ShadowScaleSSE2 scale;
+    initShadowScale(&scale, kscalea, kscaler, kscaleg, kscaleb, amin, amax, shadowRGB);
+    for (jint y = 0; y < dsth; y++) {
+        const jint *addRow = (y < srch) ? srcPixels + y * srcscan : NULL;
+        const jint *subRow = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+        shadowColumnsSSE2(sums, dstPixels + y * dstscan, 0, dstw, addRow, subRow, &scale);
+    }
+}
+
+/*
+ * AVX2.
+ *
+ * The horizontal blur runs two rows at once, one per 128-bit lane.  The
+ * vertical passes handle eight columns per iteration and leave the
+ * remainder of each row to the SSE2 code.
+ */
+
+TARGET_AVX2
+static inline __m256i unpackPixels2(jint rgb0, jint rgb1) {
+    __m128i p = _mm_unpacklo_epi32(_mm_cvtsi32_si128(rgb0), _mm_cvtsi32_si128(rgb1));
+    return _mm256_cvtepu8_epi32(p);
+}
+
+TARGET_AVX2
+static inline __m256i scaleSums256(__m256i sums, __m256i kscale) {
+    return _mm256_srli_epi32(_mm256_mullo_epi32(sums, kscale), 23);
+}
+
+TARGET_AVX2
+static void blurHorizontalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srcscan)
+{
+    jint hsize = dstw - srcw + 1;
+    jint k = 0x7fffffff / (hsize * 255);
+    __m256i kscale = _mm256_set1_epi32(k);
+    jint y = 0;
+    for (; y + 2 <= dsth; y += 2) {
+        const jint *src0 = srcPixels + y * srcscan;
+        const jint *src1 = src0 + srcscan;
+        jint *dst0 = dstPixels + y * dstscan;
+        jint *dst1 = dst0 + dstscan;
+        __m256i sum = _mm256_setzero_si256();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                sum = _mm256_sub_epi32(sum, unpackPixels2(src0[x - hsize], src1[x - hsize]));
+            }
+            if (x < srcw) {
+                sum = _mm256_add_epi32(sum, unpackPixels2(src0[x], src1[x]));
+            }
+            __m256i v = scaleSums256(sum, kscale);
+            v = _mm256_packs_epi32(v, v);
+            v = _mm256_packus_epi16(v, v);
+            dst0[x] = _mm_cvtsi128_si32(_mm256_castsi256_si128(v));
+            dst1[x] = _mm_cvtsi128_si32(_mm256_extracti128_si256(v, 1));
+        }
+    }
+    if (y < dsth) {
+        blurRowSSE2(dstPixels + y * dstscan, dstw,
+                    srcPixels + y * srcscan, srcw, hsize, _mm_set1_epi32(k));
+    }
+}
+
+TARGET_AVX2
+static void blurVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                             jint *srcPixels, jint srch, jint srcscan, jint *sums)
+{
+    jint vsize = dsth - srch + 1;
+    jint k = 0x7fffffff / (vsize * 255);
+    __m256i kscale = _mm256_set1_epi32(k);
+    // packs/packus interleave the 128-bit lanes; this restores pixel order
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (jint y = 0; y < dsth; y++) {
+        const jint *addRow = (y < srch) ? srcPixels + y * srcscan : NULL;
+        const jint *subRow = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+        jint *dst = dstPixels + y * dstscan;
+        jint x = 0;
+        for (; x + 8 <= dstw; x += 8) {
+            __m256i *s = (__m256i *) (sums + x * 4);
+            __m256i v[4];
+            for (int i = 0; i < 4; i++) {
+                v[i] = _mm256_loadu_si256(s + i);
+                if (subRow != NULL) {
+                    __m128i p = _mm_loadl_epi64((const __m128i *) (subRow + x + i * 2));
+                    v[i] = _mm256_sub_epi32(v[i], _mm256_cvtepu8_epi32(p));
+                }
+                if (addRow != NULL) {
+                    __m128i p = _mm_loadl_epi64((const __m128i *) (addRow + x + i * 2));
+                    v[i] = _mm256_add_epi32(v[i], _mm256_cvtepu8_epi32(p));
+                }
+                _mm256_storeu_si256(s + i, v[i]);
+            }
+            __m256i lo = _mm256_packs_epi32(scaleSums256(v[0], kscale), scaleSums256(v[1], kscale));
+            __m256i hi = _mm256_packs_epi32(scaleSums256(v[2], kscale), scaleSums256(v[3], kscale));
+            __m256i out = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(lo, hi), order);
+            _mm256_storeu_si256((__m256i *) (dst + x), out);
+        }
+        if (x < dstw) {
+            blurColumnsSSE2(sums, dst, x, dstw, addRow, subRow, _mm_set1_epi32(k));
+        }
+    }
+}
+
+TARGET_AVX2
+static inline __m256i shadePixels256(__m256i suma,
+                                     __m256i kscalea, __m256i kscaler,
+                                     __m256i kscaleg, __m256i kscaleb,
+                                     __m256i amin, __m256i amaxMinus1, __m256i shadowRGB)
+{
+    __m256i v = _mm256_slli_epi32(scaleSums256(suma, kscalea), 24);
+    v = _mm256_or_si256(v, _mm256_slli_epi32(scaleSums256(suma, kscaler), 16));
+    v = _mm256_or_si256(v, _mm256_slli_epi32(scaleSums256(suma, kscaleg), 8));
+    v = _mm256_or_si256(v, scaleSums256(suma, kscaleb));
+    __m256i low = _mm256_cmpgt_epi32(amin, suma);
+    __m256i high = _mm256_cmpgt_epi32(suma, amaxMinus1);
+    v = _mm256_andnot_si256(low, v);
+    return _mm256_blendv_epi8(v, shadowRGB, high);
+}
+
+TARGET_AVX2
+static void shadowVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srch, jint srcscan, jint *sums,
+                               jint kscalea, jint kscaler, jint kscaleg, jint kscaleb,
+                               jint amin, jint amax, jint shadowRGB)
+{
+    jint vsize = dsth - srch + 1;
+    __m256i ka = _mm256_set1_epi32(kscalea);
+    __m256i kr = _mm256_set1_epi32(kscaler);
+    __m256i kg = _mm256_set1_epi32(kscaleg);
+    __m256i kb = _mm256_set1_epi32(kscaleb);
+    __m256i vamin = _mm256_set1_epi32(amin);
+    __m256i vamaxMinus1 = _mm256_set1_epi32(amax - 1);
+    __m256i vshadowRGB = _mm256_set1_epi32(shadowRGB);
+    ShadowScaleSSE2 scale;
+    initShadowScale(&scale, kscalea, kscaler, kscaleg, kscaleb, amin, amax, shadowRGB);
+    for (jint y = 0; y < dsth; y++) {
+        const jint *addRow = (y < srch) ? srcPixels + y * srcscan : NULL;
+        const jint *subRow = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+        jint *dst = dstPixels + y * dstscan;
+        jint x = 0;
+        for (; x + 8 <= dstw; x += 8) {
+            __m256i *s = (__m256i *) (sums + x);
+            __m256i suma = _mm256_loadu_si256(s);
+            if (subRow != NULL) {
+                __m256i p = _mm256_loadu_si256((const __m256i *) (subRow + x));
+                suma = _mm256_sub_epi32(suma, _mm256_srli_epi32(p, 24));
+            }
+            if (addRow != NULL) {
+                __m256i p = _mm256_loadu_si256((const __m256i *) (addRow + x));
+                suma = _mm256_add_epi32(suma, _mm256_srli_epi32(p, 24));
+            }
+            _mm256_storeu_si256(s, suma);
+            _mm256_storeu_si256((__m256i *) (dst + x),
+                                shadePixels256(suma, ka, kr, kg, kb,
+                                               vamin, vamaxMinus1, vshadowRGB));
+        }
+        if (x < dstw) {
+            shadowColumnsSSE2(sums, dst, x, dstw, addRow, subRow, &scale);
+        }
+    }
+}
+
+bool boxBlurHorizontalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srcscan)
+{
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            blurHorizontalAVX2(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan);
+            return true;
+        case SIMD_SSE2:
+            blurHorizontalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan);
+            return true;
+    }
+    return false;
+}
+
+bool boxBlurVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                         jint *srcPixels, jint srch, jint srcscan)
+{
+    int level = simdLevel();
+    if (level == SIMD_NONE) {
+        return false;
+    }
+    jint *sums = (jint *) calloc(dstw, 4 * sizeof(jint));
+    if (sums == NULL) {
+        return false;
+    }
+    if (level == SIMD_AVX2) {
+        blurVerticalAVX2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan, sums);
+    } else {
+        blurVerticalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan, sums);
+    }
+    free(sums);
+    return true;
+}
+
+bool boxShadowHorizontalBlackSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                  jint *srcPixels, jint srcw, jint srcscan,
+                                  jint kscale, jint amin, jint amax)
+{
+    // There is no AVX2 variant; the SSE2 kernel already runs 4 rows at once
+    if (simdLevel() != SIMD_NONE) {
+        shadowHorizontalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan,
+                             kscale, amin, amax);
+        return true;
+    }
+    return false;
+}
+
+bool boxShadowVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srch, jint srcscan,
+                           jint kscalea, jint kscaler, jint kscaleg, jint kscaleb,
+                           jint amin, jint amax, jint shadowRGB)
+{
+    int level = simdLevel();
+    if (level == SIMD_NONE) {
+        return false;
+    }
+    jint *sums = (jint *) calloc(dstw, sizeof(jint));
+    if (sums == NULL) {
+        return false;
+    }
+    if (level == SIMD_AVX2) {
+        shadowVerticalAVX2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan, sums,
+                           kscalea, kscaler, kscaleg, kscaleb, amin, amax, shadowRGB);
+    } else {
+        shadowVerticalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan, sums,
+                           kscalea, kscaler, kscaleg, kscaleb, amin, amax, shadowRGB);
+    }
+    free(sums);
+    return true;
+}
+
+#else /* BOX_KERNELS_X86 */
+
+bool boxBlurHorizontalSIMD(jint *, jint, jint, jint, jint *, jint, jint)
+{
+    return false;
+}
+
+bool boxBlurVerticalSIMD(jint *, jint, jint, jint, jint *, jint, jint)
+{
+    return false;
+}
+
+bool boxShadowHorizontalBlackSIMD(jint *, jint, jint, jint, jint *, jint, jint,
+                                  jint, jint, jint)
+{
+    return false;
+}
+
+bool boxShadowVerticalSIMD(jint *, jint, jint, jint, jint *, jint, jint,
+                           jint, jint, jint, jint, jint, jint, jint)
+{
+    return false;
+}
+
+#endif /* BOX_KERNELS_X86 */
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _Included_SSEBoxKernels
+#define _Included_SSEBoxKernels
+
+#include <jni.h>
+
+/*
+ * Vectorized implementations of the box blur and box shadow passes.
+ *
+ * Each function produces exactly the same pixels as the scalar loops in
+ * SSEBoxBlurPeer.cc and SSEBoxShadowPeer.cc.  The kernel is chosen at
+ * runtime from the instruction sets reported by CPUID (AVX2, then SSE2).
+ * A function returns false without touching dstPixels if no vectorized
+ * kernel is available, in which case the caller runs its scalar loop.
+ * The source bounds that a pass does not walk are checked by the caller.
+ */
+
+bool boxBlurHorizontalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srcscan);
+
+bool boxBlurVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                         jint *srcPixels, jint srch, jint srcscan);
+
+bool boxShadowHorizontalBlackSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                  jint *srcPixels, jint srcw, jint srcscan,
+                                  jint kscale, jint amin, jint amax);
+
+bool boxShadowVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srch, jint srcscan,
+                           jint kscalea, jint kscaler, jint kscaleg, jint kscaleb,
+                           jint amin, jint amax, jint shadowRGB);
+
+#endif /* _Included_SSEBoxKernels */
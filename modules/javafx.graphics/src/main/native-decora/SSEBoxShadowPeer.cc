@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,6 +30,7 @@
 
 #include <jni.h>
 #include "SSEUtils.h"
+#include "SSEBoxKernels.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer.h"
 
 JNIEXPORT void JNICALL
@@ -60,6 +61,14 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterHorizontalBlack
     amax += (jint) ((255 - amax) * spread);
     jint kscale = 0x7fffffff / amax;
     jint amin = (amax / 255);
+    if (boxShadowHorizontalBlackSIMD(dstPixels, dstw, dsth, dstscan,
+                                     srcPixels, srcw, srcscan,
+                                     kscale, amin, amax))
+    {
+        env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
+    }
     jint srcoff = 0;
     jint dstoff = 0;
     for (jint y = 0; y < dsth; y++) {
@@ -114,6 +123,14 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterVerticalBlack
     amax += (jint) ((255 - amax) * spread);
     jint kscale = 0x7fffffff / amax;
     jint amin = (amax / 255);
+    if (boxShadowVerticalSIMD(dstPixels, dstw, dsth, dstscan,
+                              srcPixels, srch, srcscan,
+                              kscale, 0, 0, 0, amin, amax, 0xff000000))
+    {
+        env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
+    }
     jint voff = vsize * srcscan;
     for (jint x = 0; x < dstw; x++) {
         jint suma = 0;
@@ -182,6 +199,15 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterVertical
         (((jint) (shadowColor[1] * 255)) <<  8) |
         (((jint) (shadowColor[2] * 255))      ) |
         (((jint) (shadowColor[3] * 255)) << 24);
+    if (boxShadowVerticalSIMD(dstPixels, dstw, dsth, dstscan,
+                              srcPixels, srch, srcscan,
+                              kscalea, kscaler, kscaleg, kscaleb,
+                              amin, amax, shadowRGB))
+    {
+        env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
+    }
     for (jint x = 0; x < dstw; x++) {
         jint suma = 0;
         jint srcoff = x;
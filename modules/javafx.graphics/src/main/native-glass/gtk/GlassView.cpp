@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -175,13 +175,31 @@ JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1scheduleRepaint
     (void)ptr;
 }
 
+/*
+ * Copies the dirty rectangles passed from Java, (x, y, w, h) quadruples,
+ * to a native array. Returns NULL when the whole view should be painted.
+ */
+static jint* get_dirty_rects(JNIEnv *env, jintArray jrects, jint *count)
+{
+    *count = 0;
+    if (!jrects) return NULL;
+
+    jsize length = env->GetArrayLength(jrects);
+    if (length < 4) return NULL;
+
+    jint *rects = new jint[length];
+    env->GetIntArrayRegion(jrects, 0, length, rects);
+    *count = length / 4;
+    return rects;
+}
+
 /*
  * Class:     com_sun_glass_ui_gtk_GtkView
  * Method:    _uploadPixelsDirect
- * Signature: (JLjava/nio/Buffer;II)V
+ * Signature: (JLjava/nio/Buffer;II[I)V
  */
 JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsDirect
-(JNIEnv *env, jobject jView, jlong ptr, jobject buffer, jint width, jint height)
+(JNIEnv *env, jobject jView, jlong ptr, jobject buffer, jint width, jint height, jintArray jrects)
 {
     (void)jView;
 
@@ -192,17 +210,20 @@ JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsDirect
     if (view->current_window) {
         void *data = env->GetDirectBufferAddress(buffer);
 
-        view->current_window->paint(data, width, height);
+        jint count;
+        jint *rects = get_dirty_rects(env, jrects, &count);
+        view->current_window->paint(data, width, height, rects, count);
+        delete[] rects;
     }
 }
 
 /*
  * Class:     com_sun_glass_ui_gtk_GtkView
  * Method:    _uploadPixelsIntArray
- * Signature:  (J[IIII)V
+ * Signature:  (J[IIII[I)V
  */
 JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsIntArray
-  (JNIEnv * env, jobject obj, jlong ptr, jintArray array, jint offset, jint width, jint height)
+  (JNIEnv * env, jobject obj, jlong ptr, jintArray array, jint offset, jint width, jint height, jintArray jrects)
 {
     (void)obj;
 
@@ -223,22 +244,26 @@ JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsIntArray
 
     GlassView* view = JLONG_TO_GLASSVIEW(ptr);
     if (view->current_window) {
+        jint count;
+        jint *rects = get_dirty_rects(env, jrects, &count);
+
         int *data = NULL;
         data = (int*)env->GetPrimitiveArrayCritical(array, 0);
 
-        view->current_window->paint(data + offset, width, height);
+        view->current_window->paint(data + offset, width, height, rects, count);
 
         env->ReleasePrimitiveArrayCritical(array, data, JNI_ABORT);
+        delete[] rects;
     }
 }
 
 /*
  * Class:     com_sun_glass_ui_gtk_GtkView
  * Method:    _uploadPixelsByteArray
- * Signature:  (J[BIII)V
+ * Signature:  (J[BIII[I)V
  */
 JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsByteArray
-  (JNIEnv * env, jobject obj, jlong ptr, jbyteArray array, jint offset, jint width, jint height)
+  (JNIEnv * env, jobject obj, jlong ptr, jbyteArray array, jint offset, jint width, jint height, jintArray jrects)
 {
     (void)obj;
 
@@ -259,13 +284,17 @@ JNIEXPORT void JNICALL Java_com_sun_glass_ui_gtk_GtkView__1uploadPixelsByteArray
 
     GlassView* view = JLONG_TO_GLASSVIEW(ptr);
     if (view->current_window) {
+        jint count;
+        jint *rects = get_dirty_rects(env, jrects, &count);
+
         unsigned char *data = NULL;
 
         data = (unsigned char*)env->GetPrimitiveArrayCritical(array, 0);
 
-        view->current_window->paint(data + offset, width, height);
+        view->current_window->paint(data + offset, width, height, rects, count);
 
         env->ReleasePrimitiveArrayCritical(array, data, JNI_ABORT);
+        delete[] rects;
     }
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -515,9 +515,34 @@ void WindowContextBase::process_key(GdkEventKey* event) {
 }
 
 void WindowContextBase::paint(void* data, jint width, jint height) {
+    paint(data, width, height, NULL, 0);
+}
+
+/*
+ * Paints the parts of the width x height ARGB buffer covered by the
+ * count damaged rectangles stored as (x, y, w, h) in rects. When no
+ * rectangles are given the whole buffer is painted.
+ */
+void WindowContextBase::paint(void* data, jint width, jint height, const jint* rects, jint count) {
+    cairo_rectangle_int_t bounds = {0, 0, width, height};
+    cairo_region_t *region;
+    if (rects != NULL && count > 0) {
+        region = cairo_region_create();
+        for (jint i = 0; i < count; i++) {
+            cairo_rectangle_int_t rect = {rects[4 * i], rects[4 * i + 1], rects[4 * i + 2], rects[4 * i + 3]};
+            cairo_region_union_rectangle(region, &rect);
+        }
+        cairo_region_intersect_rectangle(region, &bounds);
+    } else {
+        region = cairo_region_create_rectangle(&bounds);
+    }
+
+    if (cairo_region_is_empty(region)) {
+        cairo_region_destroy(region);
+        return;
+    }
+
 #ifdef GLASS_GTK3
-    cairo_rectangle_int_t rect = {0, 0, width, height};
-    cairo_region_t *region = cairo_region_create_rectangle(&rect);
     gdk_window_begin_paint_region(gdk_window, region);
 #endif
     cairo_t* context = gdk_cairo_create(gdk_window);
@@ -530,14 +555,23 @@ void WindowContextBase::paint(void* data, jint width, jint height) {
 
     applyShapeMask(data, width, height);
 
+    // Limit the copy to the damaged area
+    int num_rects = cairo_region_num_rectangles(region);
+    for (int i = 0; i < num_rects; i++) {
+        cairo_rectangle_int_t rect;
+        cairo_region_get_rectangle(region, i, &rect);
+        cairo_rectangle(context, rect.x, rect.y, rect.width, rect.height);
+    }
+    cairo_clip(context);
+
     cairo_set_source_surface(context, cairo_surface, 0, 0);
     cairo_set_operator(context, CAIRO_OPERATOR_SOURCE);
     cairo_paint(context);
 
 #ifdef GLASS_GTK3
     gdk_window_end_paint(gdk_window);
-    cairo_region_destroy(region);
 #endif
+    cairo_region_destroy(region);
 
     cairo_destroy(context);
     cairo_surface_destroy(cairo_surface);
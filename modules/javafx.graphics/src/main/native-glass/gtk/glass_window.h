@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -102,6 +102,7 @@ public:
     virtual void enableOrResetIME() = 0;
     virtual void disableIME() = 0;
     virtual void paint(void* data, jint width, jint height) = 0;
+    virtual void paint(void* data, jint width, jint height, const jint* rects, jint count) = 0;
     virtual WindowFrameExtents get_frame_extents() = 0;
 
     virtual void enter_fullscreen() = 0;
@@ -214,6 +215,7 @@ public:
     void enableOrResetIME();
     void disableIME();
     void paint(void*, jint, jint);
+    void paint(void*, jint, jint, const jint*, jint);
     GdkWindow *get_gdk_window();
     jobject get_jwindow();
     jobject get_jview();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,7 @@
 
 #include <PiscesBlit.h>
 #include <PiscesSysutils.h>
+#include <PiscesTiles.h>
 
 #include <PiscesRenderer.inl>
 
@@ -123,6 +124,19 @@ Java_com_sun_pisces_PiscesRenderer_setColorImpl(JNIEnv* env, jobject objectHandl
     }
 }
 
+JNIEXPORT void JNICALL
+Java_com_sun_pisces_PiscesRenderer_setTileThreadsImpl(JNIEnv* env,
+    jobject objectHandle,
+    jint threads)
+{
+    Renderer* rdr;
+    rdr = (Renderer*)JLongToPointer(
+              (*env)->GetLongField(env, objectHandle,
+                                   fieldIds[RENDERER_NATIVE_PTR]));
+
+    rdr->_tileThreads = MIN(threads, MAX_TILE_THREADS);
+}
+
 JNIEXPORT void JNICALL
 Java_com_sun_pisces_PiscesRenderer_setCompositeRuleImpl(JNIEnv* env,
     jobject objectHandle,
@@ -507,6 +521,12 @@ fillRect(JNIEnv *env, jobject this, Renderer* rdr,
         }
 
         // emit "full" lines that are in the middle
+        if (rows_to_render_by_loop > 0 &&
+            renderer_useTiles(rdr, rdr->_alphaWidth, rows_to_render_by_loop))
+        {
+            renderer_emitLinesTiled(rdr, rows_to_render_by_loop);
+            rows_to_render_by_loop = 0;
+        }
         while (rows_to_render_by_loop > 0) {
             rows_being_rendered = MIN(rows_to_render_by_loop, NUM_ALPHA_ROWS);
 
@@ -825,6 +845,10 @@ static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint m
 
             rowsToBeRendered = height;
 
+            if (renderer_useTiles(rdr, width, height)) {
+                renderer_emitMaskRowsTiled(rdr, height, x, maskWidth);
+                rowsToBeRendered = 0;
+            }
             while (rowsToBeRendered > 0) {
                 rowsBeingRendered = 1; //MIN(rowsToBeRendered, NUM_ALPHA_ROWS);
 
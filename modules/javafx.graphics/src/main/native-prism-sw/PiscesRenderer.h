@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -380,6 +380,9 @@ typedef struct _Renderer {
 
     jint _rendererState;
 
+    // Number of threads painting tiles of large fills, <= 1 disables tiling
+    jint _tileThreads;
+
 }
 Renderer;
 
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <PiscesTiles.h>
+
+#include <PiscesUtil.h>
+#include <PiscesSysutils.h>
+
+#ifdef _WIN32
+#include <windows.h>
+
+typedef SRWLOCK tile_mutex;
+typedef CONDITION_VARIABLE tile_cond;
+#define TILE_MUTEX_INITIALIZER SRWLOCK_INIT
+#define TILE_COND_INITIALIZER CONDITION_VARIABLE_INIT
+#define tile_lock(m) AcquireSRWLockExclusive(m)
+#define tile_unlock(m) ReleaseSRWLockExclusive(m)
+#define tile_wait(c, m) SleepConditionVariableSRW((c), (m), INFINITE, 0)
+#define tile_broadcast(c) WakeAllConditionVariable(c)
+#define tile_signal(c) WakeConditionVariable(c)
+#else
+#include <pthread.h>
+
+typedef pthread_mutex_t tile_mutex;
+typedef pthread_cond_t tile_cond;
+#define TILE_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define TILE_COND_INITIALIZER PTHREAD_COND_INITIALIZER
+#define tile_lock(m) pthread_mutex_lock(m)
+#define tile_unlock(m) pthread_mutex_unlock(m)
+#define tile_wait(c, m) pthread_cond_wait((c), (m))
+#define tile_broadcast(c) pthread_cond_broadcast(c)
+#define tile_signal(c) pthread_cond_signal(c)
+#endif
+
+typedef void (*TileFunc)(void *job, jint tile);
+
+/*
+ * Process wide pool of worker threads. The pool grows to the largest
+ * number of threads any renderer has asked for and its threads live
+ * until the process exits. Only one job runs at a time; the thread that
+ * submits it paints tiles as well and returns once every tile is done.
+ */
+static tile_mutex jobLock = TILE_MUTEX_INITIALIZER;
+static tile_mutex poolLock = TILE_MUTEX_INITIALIZER;
+static tile_cond workAvailable = TILE_COND_INITIALIZER;
+static tile_cond workDone = TILE_COND_INITIALIZER;
+static jint numWorkers = 0;
+
+static TileFunc jobFunc = NULL;
+static void *jobData = NULL;
+static jint jobTiles = 0;
+static jint nextTile = 0;
+static jint pendingTiles = 0;
+
+/* Paints the next tile of the current job. Called with poolLock held. */
+static void
+runNextTile() {
+    TileFunc func = jobFunc;
+    void *job = jobData;
+    jint tile = nextTile++;
+
+    tile_unlock(&poolLock);
+    func(job, tile);
+    tile_lock(&poolLock);
+
+    if (--pendingTiles == 0) {
+        tile_signal(&workDone);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI
+tileWorker(LPVOID arg) {
+#else
+static void *
+tileWorker(void *arg) {
+#endif
+    tile_lock(&poolLock);
+    for (;;) {
+        while (nextTile >= jobTiles) {
+            tile_wait(&workAvailable, &poolLock);
+        }
+        runNextTile();
+    }
+    return 0;
+}
+
+/* Starts workers until there are count of them. Called with poolLock held. */
+static void
+ensureWorkers(jint count) {
+    while (numWorkers < count) {
+#ifdef _WIN32
+        HANDLE thread = CreateThread(NULL, 0, tileWorker, NULL, 0, NULL);
+        if (thread == NULL) {
+            break;
+        }
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, tileWorker, NULL) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+#endif
+        numWorkers++;
+    }
+}
+
+/*
+ * Calls func(job, tile) for every tile in [0, tiles) using at most threads
+ * threads, including the calling one. If no worker can be started, all
+ * tiles are painted on the calling thread.
+ */
+static void
+runTiles(TileFunc func, void *job, jint tiles, jint threads) {
+    tile_lock(&jobLock);
+    tile_lock(&poolLock);
+
+    ensureWorkers(MIN(threads, MAX_TILE_THREADS) - 1);
+
+    jobFunc = func;
+    jobData = job;
+    jobTiles = tiles;
+    nextTile = 0;
+    pendingTiles = tiles;
+    tile_broadcast(&workAvailable);
+
+    while (nextTile < jobTiles) {
+        runNextTile();
+    }
+    while (pendingTiles > 0) {
+        tile_wait(&workDone, &poolLock);
+    }
+
+    jobFunc = NULL;
+    jobData = NULL;
+    jobTiles = 0;
+    nextTile = 0;
+
+    tile_unlock(&poolLock);
+    tile_unlock(&jobLock);
+}
+
+jboolean
+renderer_useTiles(Renderer *rdr, jint width, jint height) {
+    return (rdr->_tileThreads > 1 &&
+            height > TILE_ROWS &&
+            (jlong)width * height >= MIN_TILED_PIXELS) ? XNI_TRUE : XNI_FALSE;
+}
+
+/*
+ * Makes a private copy of the renderer for painting rows starting at
+ * firstRow. The copy gets its own paint buffer; everything else it reads
+ * is either immutable while the job runs or per-row state set here.
+ */
+static void
+initTileRenderer(Renderer *tileRdr, const Renderer *rdr, jint firstRow) {
+    *tileRdr = *rdr;
+    tileRdr->_paint = NULL;
+    tileRdr->_paint_length = 0;
+    tileRdr->_currY = rdr->_currY + firstRow;
+    tileRdr->_rowNum = rdr->_rowNum + firstRow;
+    tileRdr->_currImageOffset = tileRdr->_currY * rdr->_imageScanlineStride;
+}
+
+typedef struct _TileJob {
+    Renderer *rdr;
+    jint rows;
+    jint nextX;
+    jint maskWidth;
+} TileJob;
+
+static void
+emitLinesTile(void *data, jint tile) {
+    TileJob *job = (TileJob *)data;
+    Renderer tileRdr;
+    jint firstRow = tile * TILE_ROWS;
+    jint rows = MIN(TILE_ROWS, job->rows - firstRow);
+    jint x = job->rdr->_currX;
+
+    initTileRenderer(&tileRdr, job->rdr, firstRow);
+
+    while (rows > 0) {
+        jint rowsBeingRendered = MIN(rows, NUM_ALPHA_ROWS);
+
+        if (tileRdr._genPaint) {
+            size_t l = tileRdr._alphaWidth * rowsBeingRendered;
+            ALLOC3(tileRdr._paint, jint, l);
+            if (tileRdr._paint == NULL) {
+                setMemErrorFlag();
+                break;
+            }
+            tileRdr._genPaint(&tileRdr, rowsBeingRendered);
+        }
+        tileRdr._emitLine(&tileRdr, rowsBeingRendered, 0x10000);
+
+        rows -= rowsBeingRendered;
+        tileRdr._currX = x;
+        tileRdr._currY += rowsBeingRendered;
+        tileRdr._currImageOffset = tileRdr._currY * tileRdr._imageScanlineStride;
+        tileRdr._rowNum += rowsBeingRendered;
+    }
+
+    my_free(tileRdr._paint);
+}
+
+static void
+emitMaskRowsTile(void *data, jint tile) {
+    TileJob *job = (TileJob *)data;
+    Renderer tileRdr;
+    jint firstRow = tile * TILE_ROWS;
+    jint rows = MIN(TILE_ROWS, job->rows - firstRow);
+
+    initTileRenderer(&tileRdr, job->rdr, firstRow);
+    tileRdr._maskOffset += firstRow * job->maskWidth;
+    if (firstRow > 0) {
+        tileRdr._currX = job->nextX;
+    }
+
+    while (rows > 0) {
+        tileRdr._currImageOffset = tileRdr._currY * tileRdr._imageScanlineStride;
+        if (tileRdr._genPaint) {
+            size_t l = tileRdr._alphaWidth;
+            ALLOC3(tileRdr._paint, jint, l);
+            if (tileRdr._paint == NULL) {
+                setMemErrorFlag();
+                break;
+            }
+            tileRdr._genPaint(&tileRdr, 1);
+        }
+        tileRdr._emitRows(&tileRdr, 1);
+
+        tileRdr._maskOffset += job->maskWidth;
+        tileRdr._rowNum++;
+        rows--;
+        tileRdr._currX = job->nextX;
+        tileRdr._currY++;
+    }
+
+    my_free(tileRdr._paint);
+}
+
+void
+renderer_emitLinesTiled(Renderer *rdr, jint rows) {
+    TileJob job;
+    job.rdr = rdr;
+    job.rows = rows;
+
+    runTiles(emitLinesTile, &job, (rows + TILE_ROWS - 1) / TILE_ROWS,
+             rdr->_tileThreads);
+
+    rdr->_currY += rows;
+    rdr->_currImageOffset = rdr->_currY * rdr->_imageScanlineStride;
+    rdr->_rowNum += rows;
+}
+
+void
+renderer_emitMaskRowsTiled(Renderer *rdr, jint rows, jint nextX, jint maskWidth) {
+    TileJob job;
+    job.rdr = rdr;
+    job.rows = rows;
+    job.nextX = nextX;
+    job.maskWidth = maskWidth;
+
+    runTiles(emitMaskRowsTile, &job, (rows + TILE_ROWS - 1) / TILE_ROWS,
+             rdr->_tileThreads);
+
+    rdr->_maskOffset += rows * maskWidth;
+    rdr->_rowNum += rows;
+    rdr->_currX = nextX;
+    rdr->_currY += rows;
+    rdr->_currImageOffset = (rdr->_currY - 1) * rdr->_imageScanlineStride;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef PISCES_TILES_H
+#define PISCES_TILES_H
+
+#include <PiscesDefs.h>
+#include <PiscesRenderer.h>
+
+/**
+ * Number of scanlines in one tile. Must be a multiple of NUM_ALPHA_ROWS so
+ * that tiles batch their paint rows exactly like the single-threaded loops.
+ */
+#define TILE_ROWS (4 * NUM_ALPHA_ROWS)
+
+/**
+ * Fills smaller than this many pixels are always painted on the calling
+ * thread; handing them to the worker pool costs more than it saves.
+ */
+#define MIN_TILED_PIXELS (256 * 256)
+
+/**
+ * Maximum number of threads, including the calling thread, that may paint
+ * tiles at the same time.
+ */
+#define MAX_TILE_THREADS 32
+
+/**
+ * Returns XNI_TRUE if a fill of the given size should be split into tiles.
+ */
+jboolean renderer_useTiles(Renderer *rdr, jint width, jint height);
+
+/**
+ * Tiled equivalent of emitting rows full-coverage scanlines with
+ * rdr->_emitLine, starting at rdr->_currY, in batches of NUM_ALPHA_ROWS.
+ * Each tile paints into its own copy of the renderer, so the result is
+ * identical to the single-threaded loop. On return rdr->_currX, _currY,
+ * _currImageOffset and _rowNum have been advanced past the last row.
+ */
+void renderer_emitLinesTiled(Renderer *rdr, jint rows);
+
+/**
+ * Tiled equivalent of emitting rows scanlines of the current alpha mask
+ * with rdr->_emitRows, one row at a time, starting at rdr->_currY.
+ * nextX is the value the single-threaded loop assigns to rdr->_currX after
+ * each row. On return the row state and rdr->_maskOffset have been advanced
+ * past the last row.
+ */
+void renderer_emitMaskRowsTiled(Renderer *rdr, jint rows, jint nextX, jint maskWidth);
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -49,6 +49,7 @@ public abstract class ConnectionHolder {
 
     ReadableByteChannel channel;
     ByteBuffer          buffer = ByteBuffer.allocateDirect(DEFAULT_BUFFER_SIZE);
+    ByteBuffer          nativeBuffer;
 
     static ConnectionHolder createMemoryConnectionHolder(ByteBuffer buffer) {
         return new MemoryConnectionHolder(buffer);
@@ -91,6 +92,56 @@ public abstract class ConnectionHolder {
         return buffer;
     }
 
+    /**
+     * Shares a block of native memory that {@link #readNextBlock(int, int)}
+     * reads into. Called by the native source, with {@code null} when it stops
+     * sharing.
+     */
+    void setNativeBuffer(ByteBuffer nativeBuffer) {
+        this.nativeBuffer = nativeBuffer;
+    }
+
+    /**
+     * Reads a block of data from the current position of the opened stream
+     * straight into the shared native buffer, so that it does not need to be
+     * copied out of {@link #buffer}.
+     *
+     * @param offset where the block starts in the native buffer
+     * @param size the maximum number of bytes to read
+     * @return The number of bytes read, possibly zero, or -1 if the channel
+     * has reached end-of-stream.
+     *
+     * @throws ClosedChannelException if an attempt is made to read after
+     * closeConnection has been called or when no native buffer is shared
+     */
+    int readNextBlock(int offset, int size) throws IOException {
+        if (null == nativeBuffer) {
+            throw new ClosedChannelException();
+        }
+
+        ByteBuffer block = nativeBuffer.duplicate();
+        block.limit(offset + size);
+        block.position(offset);
+        block = block.slice();
+
+        ByteBuffer blockBuffer = buffer;
+        buffer = block;
+        try {
+            int read = readNextBlock();
+            // A holder may hand out its own buffer rather than fill the block
+            if (read > 0 && buffer != block) {
+                ByteBuffer data = buffer.duplicate();
+                data.rewind();
+                data.limit(read);
+                block.clear();
+                block.put(data);
+            }
+            return read;
+        } finally {
+            buffer = blockBuffer;
+        }
+    }
+
     /**
      * Reads a block of data from the arbitrary position of the opened stream.
      *
@@ -102,6 +153,27 @@ public abstract class ConnectionHolder {
      */
     abstract int readBlock(long position, int size) throws IOException;
 
+    /**
+     * Reads a block of data from the arbitrary position of the opened stream
+     * straight into {@code dst}, up to its remaining space.
+     *
+     * @return The number of bytes read, possibly zero, or -1 if the given position
+     * is greater than or equal to the file's current size.
+     *
+     * @throws ClosedChannelException if an attempt is made to read after
+     * closeConnection has been called
+     */
+    int readBlock(long position, ByteBuffer dst) throws IOException {
+        int read = readBlock(position, dst.remaining());
+        if (read > 0) {
+            ByteBuffer data = buffer.duplicate();
+            data.rewind();
+            data.limit(read);
+            dst.put(data);
+        }
+        return read;
+    }
+
     /**
      * Detects whether this source needs buffering at the pipeline level.
      * When true the pipeline contains progressbuffer after the source.
@@ -202,6 +274,23 @@ public abstract class ConnectionHolder {
             return ((FileChannel)channel).read(buffer, position);
         }
 
+        @Override
+        int readBlock(long position, ByteBuffer dst) throws IOException {
+            if (null == channel) {
+                throw new ClosedChannelException();
+            }
+
+            int total = 0;
+            while (dst.hasRemaining()) {
+                int read = ((FileChannel)channel).read(dst, position + total);
+                if (read < 0) {
+                    return (total > 0) ? total : -1;
+                }
+                total += read;
+            }
+            return total;
+        }
+
         private ReadableByteChannel openFile(final URI uri) throws IOException {
             if (file != null) {
                 file.close();
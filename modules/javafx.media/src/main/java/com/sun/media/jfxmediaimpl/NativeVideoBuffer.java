@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -37,6 +37,8 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     private long nativePeer;
     private final AtomicInteger holdCount;
     private NativeVideoBuffer cachedBGRARep;
+    // Direct buffers over the native planes, created on first use
+    private ByteBuffer[] planeBuffers;
 
     private static native void nativeDisposeBuffer(long handle);
 
@@ -55,6 +57,8 @@ final class NativeVideoBuffer implements VideoDataBuffer {
 
     // This causes methods to throw an NPE if the native handle is invalid
     private static final boolean DEBUG_DISPOSED_BUFFERS = false;
+    // Frames never have more than four planes, see nativeGetPlaneStrides
+    private static final int MAX_PLANES = 4;
     private static final VideoBufferDisposer disposer = new VideoBufferDisposer();
 
     public static NativeVideoBuffer createVideoBuffer(long nativePeer) {
@@ -90,6 +94,7 @@ final class NativeVideoBuffer implements VideoDataBuffer {
                 }
 
                 // last reference released, dispose and clear our native handle
+                planeBuffers = null;
                 MediaDisposer.removeResourceDisposer(nativePeer);
                 nativeDisposeBuffer(nativePeer);
                 nativePeer = 0;
@@ -112,9 +117,26 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     @Override
     public ByteBuffer getBufferForPlane(int plane) {
         if (0 != nativePeer) {
-            ByteBuffer buffer = nativeGetBufferForPlane(nativePeer, plane);
-            // NewDirectByteBuffer sets BIG_ENDIAN to be consistent with ByteBuffer
-            // So we need to force native order
+            ByteBuffer buffer = null;
+            if (plane >= 0 && plane < MAX_PLANES) {
+                if (null == planeBuffers) {
+                    planeBuffers = new ByteBuffer[MAX_PLANES];
+                }
+                buffer = planeBuffers[plane];
+                if (null == buffer) {
+                    buffer = nativeGetBufferForPlane(nativePeer, plane);
+                    if (null == buffer) {
+                        return null;
+                    }
+                    planeBuffers[plane] = buffer;
+                }
+                // Callers get their own position and limit
+                buffer = buffer.duplicate();
+            } else {
+                buffer = nativeGetBufferForPlane(nativePeer, plane);
+            }
+            // NewDirectByteBuffer sets BIG_ENDIAN to be consistent with ByteBuffer,
+            // as does duplicate(), so we need to force native order
             buffer.order(java.nio.ByteOrder.nativeOrder());
             return buffer;
         } else if (DEBUG_DISPOSED_BUFFERS) {
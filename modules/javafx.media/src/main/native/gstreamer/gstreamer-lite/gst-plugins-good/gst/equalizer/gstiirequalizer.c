@@ -36,6 +36,32 @@
 
 #include "gst/glib-compat-private.h"
 
+#ifdef GSTREAMER_LITE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EQU_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define EQU_SIMD_AVX 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+/* double precision lanes need AArch64 NEON */
+#define EQU_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(EQU_SIMD_SSE2) || defined(EQU_SIMD_NEON)
+#define EQU_SIMD_LANES 1
+/* 5 coefficients and twice 4 history values per lane, see EquCascade */
+#define EQU_CASCADE_ARRAYS 13
+#endif
+#endif // GSTREAMER_LITE
+
 GST_DEBUG_CATEGORY (equalizer_debug);
 #define GST_CAT_DEFAULT equalizer_debug
 
@@ -55,6 +81,7 @@ static void set_passthrough (GstIirEqualizer * equ);
 
 #ifdef GSTREAMER_LITE
 static void update_coefficients (GstIirEqualizer * equ);
+static void select_cascade (void);
 #endif // GSTREAMER_LITE
 
 #define ALLOWED_CAPS \
@@ -400,6 +427,10 @@ gst_iir_equalizer_class_init (GstIirEqualizerClass * klass)
   caps = gst_caps_from_string (ALLOWED_CAPS);
   gst_audio_filter_class_add_pad_templates (audio_filter_class, caps);
   gst_caps_unref (caps);
+
+#ifdef GSTREAMER_LITE
+  select_cascade ();
+#endif // GSTREAMER_LITE
 }
 
 static void
@@ -425,6 +456,12 @@ gst_iir_equalizer_finalize (GObject * object)
 
   g_free (equ->bands);
   g_free (equ->history);
+#ifdef GSTREAMER_LITE
+  g_free (equ->active_bands);
+  g_free (equ->band_active);
+  g_free (equ->last_input);
+  g_free (equ->lanes);
+#endif // GSTREAMER_LITE
 
   g_mutex_clear (&equ->bands_lock);
 
@@ -627,6 +664,53 @@ set_passthrough (GstIirEqualizer * equ)
   GST_DEBUG ("Passthrough mode: %d\n", passthrough);
 }
 
+#ifdef GSTREAMER_LITE
+/* Must be called with bands_lock and transform lock!
+ *
+ * A band at 0 dB is an identity filter (a0 = 1, a1 = -b1, a2 = -b2) as long
+ * as its input and output history agree, so it is left out of the cascade.
+ * When it comes back its history is seeded with the signal that reaches it,
+ * i.e. the output of the closest lower band that was running or the input
+ * itself, which is the state it would have had if it had kept running.
+ */
+static void
+update_active_bands (GstIirEqualizer * equ)
+{
+  guint i, n = equ->freq_band_count;
+  guint channels = GST_AUDIO_FILTER_CHANNELS (equ);
+  gint prev = -1;
+
+  equ->active_band_count = 0;
+  equ->bands_settling = FALSE;
+  if (equ->band_active == NULL || equ->active_bands == NULL)
+    return;
+
+  for (i = 0; i < n; i++) {
+    gboolean active = (equ->bands[i]->gain != 0.0);
+
+    /* a band that has just been set to 0 dB keeps running until its output
+     * has caught up with its input, otherwise its decay would be cut off */
+    if (!active && equ->band_active[i] && equ->settled && equ->history &&
+        channels > 0 && !equ->settled (equ, i, channels)) {
+      active = TRUE;
+      equ->bands_settling = TRUE;
+    }
+
+    if (active) {
+      if (!equ->band_active[i] && equ->seed && equ->history && channels > 0)
+        equ->seed (equ, i, prev, channels);
+      equ->active_bands[equ->active_band_count++] = i;
+    }
+
+    /* the history of this band is current if it ran on the last buffer
+     * or has just been seeded */
+    if (active || equ->band_active[i])
+      prev = i;
+    equ->band_active[i] = active;
+  }
+}
+#endif // GSTREAMER_LITE
+
 /* Must be called with bands_lock and transform lock! */
 static void
 update_coefficients (GstIirEqualizer * equ)
@@ -642,6 +726,10 @@ update_coefficients (GstIirEqualizer * equ)
       setup_high_shelf_filter (equ, equ->bands[i]);
   }
 
+#ifdef GSTREAMER_LITE
+  update_active_bands (equ);
+#endif // GSTREAMER_LITE
+
   equ->need_new_coefficients = FALSE;
 }
 
@@ -654,6 +742,22 @@ alloc_history (GstIirEqualizer * equ, const GstAudioInfo * info)
   equ->history =
       g_malloc0 (equ->history_size * GST_AUDIO_INFO_CHANNELS (info) *
       equ->freq_band_count);
+#ifdef GSTREAMER_LITE
+  g_free (equ->active_bands);
+  g_free (equ->band_active);
+  g_free (equ->last_input);
+  g_free (equ->lanes);
+  equ->active_bands = g_new0 (guint, equ->freq_band_count);
+  equ->band_active = g_new0 (gboolean, equ->freq_band_count);
+  equ->active_band_count = 0;
+  equ->last_input = g_new0 (gdouble, 2 * GST_AUDIO_INFO_CHANNELS (info));
+#ifdef EQU_SIMD_LANES
+  equ->lanes = g_new0 (gdouble,
+      EQU_CASCADE_ARRAYS * GST_ROUND_UP_4 (equ->freq_band_count));
+#endif
+  /* the active band list has to be rebuilt against the new history */
+  equ->need_new_coefficients = TRUE;
+#endif // GSTREAMER_LITE
 }
 
 void
@@ -746,6 +850,7 @@ gst_iir_equalizer_compute_frequencies (GstIirEqualizer * equ, guint new_count)
 
 /* start of code that is type specific */
 
+#ifndef GSTREAMER_LITE
 #define CREATE_OPTIMIZED_FUNCTIONS_INT(TYPE,BIG_TYPE,MIN_VAL,MAX_VAL)   \
 typedef struct {                                                        \
   BIG_TYPE x1, x2;          /* history of input values for a filter */  \
@@ -848,6 +953,612 @@ guint size, guint channels)                                             \
 CREATE_OPTIMIZED_FUNCTIONS_INT (gint16, gfloat, -32768.0, 32767.0);
 CREATE_OPTIMIZED_FUNCTIONS (gfloat);
 CREATE_OPTIMIZED_FUNCTIONS (gdouble);
+#else // GSTREAMER_LITE
+/* Bands at 0 dB are skipped, see update_active_bands (). The input of the
+ * last two frames is kept to restart them. A band is settled when its
+ * input and output history agree to within a fraction of the signal, with
+ * FLOOR as the absolute bound near silence. */
+#define CREATE_BYPASS_FUNCTIONS(TYPE,FLOOR)                             \
+static void                                                             \
+gst_iir_equ_save_input_ ## TYPE (GstIirEqualizer *equ,                  \
+    const guint8 *data, guint frames, guint channels)                   \
+{                                                                       \
+  const TYPE *in = (const TYPE *) data;                                 \
+  guint c;                                                              \
+                                                                        \
+  for (c = 0; c < channels; c++) {                                      \
+    gdouble *last = equ->last_input + 2 * c;                            \
+    if (frames >= 2) {                                                  \
+      last[0] = in[(frames - 1) * channels + c];                        \
+      last[1] = in[(frames - 2) * channels + c];                        \
+    } else if (frames == 1) {                                           \
+      last[1] = last[0];                                                \
+      last[0] = in[c];                                                  \
+    }                                                                   \
+  }                                                                     \
+}                                                                       \
+                                                                        \
+static void                                                             \
+gst_iir_equ_seed_ ## TYPE (GstIirEqualizer *equ, guint band,            \
+    gint prev, guint channels)                                          \
+{                                                                       \
+  SecondOrderHistory ## TYPE *history = equ->history;                   \
+  guint c, nf = equ->freq_band_count;                                   \
+                                                                        \
+  for (c = 0; c < channels; c++, history += nf) {                       \
+    SecondOrderHistory ## TYPE *h = history + band;                     \
+    if (prev < 0) {                                                     \
+      h->x1 = equ->last_input[2 * c];                                   \
+      h->x2 = equ->last_input[2 * c + 1];                               \
+    } else {                                                            \
+      h->x1 = history[prev].y1;                                         \
+      h->x2 = history[prev].y2;                                         \
+    }                                                                   \
+    h->y1 = h->x1;                                                      \
+    h->y2 = h->x2;                                                      \
+  }                                                                     \
+}                                                                       \
+                                                                        \
+static gboolean                                                         \
+gst_iir_equ_settled_ ## TYPE (GstIirEqualizer *equ, guint band,         \
+    guint channels)                                                     \
+{                                                                       \
+  SecondOrderHistory ## TYPE *history = equ->history;                   \
+  guint c, nf = equ->freq_band_count;                                   \
+                                                                        \
+  for (c = 0; c < channels; c++, history += nf) {                       \
+    SecondOrderHistory ## TYPE *h = history + band;                     \
+    gdouble diff = fabs (h->x1 - h->y1) + fabs (h->x2 - h->y2);         \
+    if (diff > 1e-4 * (fabs (h->x1) + fabs (h->x2)) + FLOOR)            \
+      return FALSE;                                                     \
+  }                                                                     \
+  return TRUE;                                                          \
+}
+
+#define CREATE_OPTIMIZED_FUNCTIONS_INT(TYPE,BIG_TYPE,MIN_VAL,MAX_VAL)   \
+typedef struct {                                                        \
+  BIG_TYPE x1, x2;          /* history of input values for a filter */  \
+  BIG_TYPE y1, y2;          /* history of output values for a filter */ \
+} SecondOrderHistory ## TYPE;                                           \
+                                                                        \
+static inline BIG_TYPE                                                  \
+one_step_ ## TYPE (GstIirEqualizerBand *filter,                         \
+    SecondOrderHistory ## TYPE *history, BIG_TYPE input)                \
+{                                                                       \
+  /* calculate output */                                                \
+  BIG_TYPE output = filter->a0 * input +                                \
+      filter->a1 * history->x1 + filter->a2 * history->x2 +             \
+      filter->b1 * history->y1 + filter->b2 * history->y2;              \
+  /* update history */                                                  \
+  history->y2 = history->y1;                                            \
+  history->y1 = output;                                                 \
+  history->x2 = history->x1;                                            \
+  history->x1 = input;                                                  \
+                                                                        \
+  return output;                                                        \
+}                                                                       \
+                                                                        \
+static const guint                                                      \
+history_size_ ## TYPE = sizeof (SecondOrderHistory ## TYPE);            \
+                                                                        \
+CREATE_BYPASS_FUNCTIONS (TYPE, 0.01)                                    \
+                                                                        \
+static void                                                             \
+gst_iir_equ_process_ ## TYPE (GstIirEqualizer *equ, guint8 *data,       \
+guint size, guint channels)                                             \
+{                                                                       \
+  guint frames = size / channels / sizeof (TYPE);                       \
+  guint i, c, f, nf = equ->freq_band_count;                             \
+  guint na = equ->active_band_count;                                    \
+  const guint *active = equ->active_bands;                              \
+  BIG_TYPE cur;                                                         \
+  GstIirEqualizerBand **filters = equ->bands;                           \
+                                                                        \
+  gst_iir_equ_save_input_ ## TYPE (equ, data, frames, channels);        \
+                                                                        \
+  for (i = 0; i < frames; i++) {                                        \
+    SecondOrderHistory ## TYPE *history = equ->history;                 \
+    for (c = 0; c < channels; c++) {                                    \
+      cur = *((TYPE *) data);                                           \
+      for (f = 0; f < na; f++) {                                        \
+        cur = one_step_ ## TYPE (filters[active[f]],                    \
+            history + active[f], cur);                                  \
+      }                                                                 \
+      history += nf;                                                    \
+      cur = CLAMP (cur, MIN_VAL, MAX_VAL);                              \
+      *((TYPE *) data) = (TYPE) floor (cur);                            \
+      data += sizeof (TYPE);                                            \
+    }                                                                   \
+  }                                                                     \
+}
+
+#define CREATE_OPTIMIZED_FUNCTIONS(TYPE)                                \
+typedef struct {                                                        \
+  TYPE x1, x2;          /* history of input values for a filter */  \
+  TYPE y1, y2;          /* history of output values for a filter */ \
+} SecondOrderHistory ## TYPE;                                           \
+                                                                        \
+static inline TYPE                                                      \
+one_step_ ## TYPE (GstIirEqualizerBand *filter,                         \
+    SecondOrderHistory ## TYPE *history, TYPE input)                    \
+{                                                                       \
+  /* calculate output */                                                \
+  TYPE output = filter->a0 * input + filter->a1 * history->x1 +         \
+      filter->a2 * history->x2 + filter->b1 * history->y1 +             \
+      filter->b2 * history->y2;                                         \
+  /* update history */                                                  \
+  history->y2 = history->y1;                                            \
+  history->y1 = output;                                                 \
+  history->x2 = history->x1;                                            \
+  history->x1 = input;                                                  \
+                                                                        \
+  return output;                                                        \
+}                                                                       \
+                                                                        \
+static const guint                                                      \
+history_size_ ## TYPE = sizeof (SecondOrderHistory ## TYPE);            \
+                                                                        \
+CREATE_BYPASS_FUNCTIONS (TYPE, 1e-7)                                    \
+                                                                        \
+static void                                                             \
+gst_iir_equ_process_ ## TYPE (GstIirEqualizer *equ, guint8 *data,       \
+guint size, guint channels)                                             \
+{                                                                       \
+  guint frames = size / channels / sizeof (TYPE);                       \
+  guint i, c, f, nf = equ->freq_band_count;                             \
+  guint na = equ->active_band_count;                                    \
+  const guint *active = equ->active_bands;                              \
+  TYPE cur;                                                             \
+  GstIirEqualizerBand **filters = equ->bands;                           \
+                                                                        \
+  gst_iir_equ_save_input_ ## TYPE (equ, data, frames, channels);        \
+                                                                        \
+  for (i = 0; i < frames; i++) {                                        \
+    SecondOrderHistory ## TYPE *history = equ->history;                 \
+    for (c = 0; c < channels; c++) {                                    \
+      cur = *((TYPE *) data);                                           \
+      for (f = 0; f < na; f++) {                                        \
+        cur = one_step_ ## TYPE (filters[active[f]],                    \
+            history + active[f], cur);                                  \
+      }                                                                 \
+      history += nf;                                                    \
+      *((TYPE *) data) = (TYPE) cur;                                    \
+      data += sizeof (TYPE);                                            \
+    }                                                                   \
+  }                                                                     \
+}
+
+CREATE_OPTIMIZED_FUNCTIONS_INT (gint16, gfloat, -32768.0, 32767.0);
+CREATE_OPTIMIZED_FUNCTIONS (gfloat);
+CREATE_OPTIMIZED_FUNCTIONS (gdouble);
+
+/* The S16 and F32 formats are also filtered with one active band per SIMD
+ * lane. Band k needs the output of band k - 1 for the same sample, so the
+ * lanes are skewed: in step t lane k filters sample t - k, and the outputs
+ * move up one lane between steps. The pipeline is filled and drained one
+ * lane at a time at both ends of a block, and two channels go through it
+ * side by side so that their dependency chains overlap. The arithmetic is
+ * in double precision like that of the loops above, and in the same order
+ * in the scalar and vector code; the poles of the low bands lie so close
+ * to z = 1 at high sample rates that single precision is audibly off.
+ * Lanes past the last active band pass their input through unchanged.
+ */
+#ifdef EQU_SIMD_LANES
+
+/* frames of a channel that are filtered at a time */
+#define EQU_LANE_BLOCK 512
+
+typedef struct
+{
+  gdouble *x1, *x2, *y1, *y2;
+} EquLaneHistory;
+
+typedef struct
+{
+  guint lanes;
+  gdouble *a0, *a1, *a2, *b1, *b2;
+  EquLaneHistory h[2];          /* of the two channels */
+} EquCascade;
+
+typedef void (*EquCascadeFunc) (const EquCascade * cas,
+    gdouble block[2][EQU_LANE_BLOCK], guint n);
+
+/* kernels for groups of 2 lanes and, with AVX, of 4 lanes */
+static EquCascadeFunc cascade_2;
+static EquCascadeFunc cascade_4;
+
+static inline gdouble
+cascade_step (const EquCascade * cas, const EquLaneHistory * h, guint l,
+    gdouble in)
+{
+  gdouble x1 = h->x1[l], x2 = h->x2[l], y1 = h->y1[l], y2 = h->y2[l];
+  gdouble out = (cas->a0[l] * in + (cas->a1[l] * x1 + cas->b1[l] * y1)) +
+      (cas->a2[l] * x2 + cas->b2[l] * y2);
+
+  h->y2[l] = y1;
+  h->y1[l] = out;
+  h->x2[l] = x1;
+  h->x1[l] = in;
+
+  return out;
+}
+
+static void
+cascade_scalar (const EquCascade * cas, gdouble block[2][EQU_LANE_BLOCK],
+    guint n)
+{
+  guint c, i, l;
+
+  for (c = 0; c < 2; c++) {
+    for (i = 0; i < n; i++) {
+      gdouble cur = block[c][i];
+      for (l = 0; l < cas->lanes; l++)
+        cur = cascade_step (cas, &cas->h[c], l, cur);
+      block[c][i] = cur;
+    }
+  }
+}
+
+/* Feeds samples 0 .. lanes - 2 into the pipeline. Afterwards y1 of lane l
+ * is its output for sample lanes - 2 - l, which lane l + 1 takes next. */
+static void
+cascade_fill (const EquCascade * cas, gdouble block[2][EQU_LANE_BLOCK])
+{
+  guint c, s, l;
+
+  for (c = 0; c < 2; c++) {
+    for (s = 0; s + 1 < cas->lanes; s++) {
+      gdouble cur = block[c][s];
+      for (l = 0; l + 1 < cas->lanes - s; l++)
+        cur = cascade_step (cas, &cas->h[c], l, cur);
+    }
+  }
+}
+
+/* Runs the last lanes - 1 samples, which are still in the pipeline, through
+ * the lanes they have not passed yet */
+static void
+cascade_drain (const EquCascade * cas, gdouble block[2][EQU_LANE_BLOCK],
+    guint n)
+{
+  guint c, j, l;
+
+  for (c = 0; c < 2; c++) {
+    for (j = cas->lanes - 1; j-- > 0;) {
+      gdouble cur = cas->h[c].y1[j];
+      for (l = j + 1; l < cas->lanes; l++)
+        cur = cascade_step (cas, &cas->h[c], l, cur);
+      block[c][n - 1 - j] = cur;
+    }
+  }
+}
+
+/* Bands are filtered in groups of lanes that each run over a whole block,
+ * which keeps the state of a group in registers. Groups are 4 lanes wide
+ * when a 4 lane kernel is available and more than 2 bands are left. */
+static inline guint
+cascade_group_width (guint bands, guint first)
+{
+  return (cascade_4 && bands - first > 2) ? 4 : 2;
+}
+
+static void
+cascade_group (const EquCascade * cas, EquCascade * group, guint first,
+    guint lanes)
+{
+  guint c;
+
+  group->lanes = lanes;
+  group->a0 = cas->a0 + first;
+  group->a1 = cas->a1 + first;
+  group->a2 = cas->a2 + first;
+  group->b1 = cas->b1 + first;
+  group->b2 = cas->b2 + first;
+  for (c = 0; c < 2; c++) {
+    group->h[c].x1 = cas->h[c].x1 + first;
+    group->h[c].x2 = cas->h[c].x2 + first;
+    group->h[c].y1 = cas->h[c].y1 + first;
+    group->h[c].y2 = cas->h[c].y2 + first;
+  }
+}
+
+/* SHIFT_IN (y1, p) returns { *p, y1[0] .. y1[WIDTH - 2] } and STORE_LAST
+ * (p, v) stores v[WIDTH - 1] to p */
+#define CASCADE_STEP(C,VEC,MUL,ADD,SHIFT_IN,STORE_LAST)                 \
+  {                                                                     \
+    VEC in = SHIFT_IN (y1_ ## C, block[C] + t);                         \
+    VEC out = ADD (MUL (a0, in),                                        \
+        ADD (MUL (a1, x1_ ## C), MUL (b1, y1_ ## C)));                  \
+    out = ADD (out, ADD (MUL (a2, x2_ ## C), MUL (b2, y2_ ## C)));      \
+    STORE_LAST (block[C] + t - last, out);                              \
+    y2_ ## C = y1_ ## C;                                                \
+    y1_ ## C = out;                                                     \
+    x2_ ## C = x1_ ## C;                                                \
+    x1_ ## C = in;                                                      \
+  }
+
+#define CREATE_CASCADE_KERNEL(NAME,ATTR,VEC,WIDTH,LOAD,STORE,MUL,ADD,   \
+    SHIFT_IN,STORE_LAST)                                                \
+static ATTR void                                                        \
+cascade_ ## NAME (const EquCascade *cas,                                \
+    gdouble block[2][EQU_LANE_BLOCK], guint n)                          \
+{                                                                       \
+  VEC a0 = LOAD (cas->a0), a1 = LOAD (cas->a1), a2 = LOAD (cas->a2);    \
+  VEC b1 = LOAD (cas->b1), b2 = LOAD (cas->b2);                         \
+  VEC x1_0, x2_0, y1_0, y2_0, x1_1, x2_1, y1_1, y2_1;                   \
+  guint last = WIDTH - 1, t;                                            \
+                                                                        \
+  cascade_fill (cas, block);                                            \
+  x1_0 = LOAD (cas->h[0].x1);                                           \
+  x2_0 = LOAD (cas->h[0].x2);                                           \
+  y1_0 = LOAD (cas->h[0].y1);                                           \
+  y2_0 = LOAD (cas->h[0].y2);                                           \
+  x1_1 = LOAD (cas->h[1].x1);                                           \
+  x2_1 = LOAD (cas->h[1].x2);                                           \
+  y1_1 = LOAD (cas->h[1].y1);                                           \
+  y2_1 = LOAD (cas->h[1].y2);                                           \
+                                                                        \
+  for (t = last; t < n; t++) {                                          \
+    CASCADE_STEP (0, VEC, MUL, ADD, SHIFT_IN, STORE_LAST);              \
+    CASCADE_STEP (1, VEC, MUL, ADD, SHIFT_IN, STORE_LAST);              \
+  }                                                                     \
+                                                                        \
+  STORE (cas->h[0].x1, x1_0);                                           \
+  STORE (cas->h[0].x2, x2_0);                                           \
+  STORE (cas->h[0].y1, y1_0);                                           \
+  STORE (cas->h[0].y2, y2_0);                                           \
+  STORE (cas->h[1].x1, x1_1);                                           \
+  STORE (cas->h[1].x2, x2_1);                                           \
+  STORE (cas->h[1].y1, y1_1);                                           \
+  STORE (cas->h[1].y2, y2_1);                                           \
+  cascade_drain (cas, block, n);                                        \
+}
+
+#ifdef EQU_SIMD_SSE2
+static inline __m128d
+shift_in_sse2 (__m128d y1, const gdouble * p)
+{
+  return _mm_unpacklo_pd (_mm_load_sd (p), y1);
+}
+
+static inline void
+store_last_sse2 (gdouble * p, __m128d v)
+{
+  _mm_storeh_pd (p, v);
+}
+
+CREATE_CASCADE_KERNEL (sse2, , __m128d, 2, _mm_loadu_pd, _mm_storeu_pd,
+    _mm_mul_pd, _mm_add_pd, shift_in_sse2, store_last_sse2);
+#endif
+
+#ifdef EQU_SIMD_AVX
+/* The library is not built with -mavx, so this kernel is compiled for AVX
+ * on its own and only selected once the CPU and OS support it */
+#if defined(__GNUC__) || defined(__clang__)
+#define EQU_TARGET_AVX __attribute__((target("avx")))
+#else
+#define EQU_TARGET_AVX
+#endif
+
+static gboolean
+cpu_supports_avx (void)
+{
+  const guint osxsave_avx = (1u << 27) | (1u << 28);
+  guint ecx, xcr0;
+
+#ifdef _MSC_VER
+  int r[4];
+
+  __cpuid (r, 1);
+  ecx = (guint) r[2];
+  if ((ecx & osxsave_avx) != osxsave_avx)
+    return FALSE;
+  xcr0 = (guint) _xgetbv (0);
+#else
+  guint eax, ebx, edx;
+
+  if (!__get_cpuid (1, &eax, &ebx, &ecx, &edx))
+    return FALSE;
+  if ((ecx & osxsave_avx) != osxsave_avx)
+    return FALSE;
+  /* xgetbv, spelled out for assemblers that do not know the mnemonic */
+  __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0":"=a" (xcr0), "=d" (edx):"c" (0));
+#endif
+
+  /* the OS has to save the YMM state as well */
+  return (xcr0 & 0x6) == 0x6;
+}
+
+static inline EQU_TARGET_AVX __m256d
+shift_in_avx (__m256d y1, const gdouble * p)
+{
+  /* { 0, 0, y1[0], y1[1] } interleaved with y1 gives { 0, y1[0..2] } */
+  __m256d in = _mm256_permute2f128_pd (y1, y1, 0x08);
+
+  in = _mm256_shuffle_pd (in, y1, 0x4);
+  return _mm256_blend_pd (in, _mm256_broadcast_sd (p), 0x1);
+}
+
+static inline EQU_TARGET_AVX void
+store_last_avx (gdouble * p, __m256d v)
+{
+  _mm_storeh_pd (p, _mm256_extractf128_pd (v, 1));
+}
+
+CREATE_CASCADE_KERNEL (avx, EQU_TARGET_AVX, __m256d, 4, _mm256_loadu_pd,
+    _mm256_storeu_pd, _mm256_mul_pd, _mm256_add_pd, shift_in_avx,
+    store_last_avx);
+#endif
+
+#ifdef EQU_SIMD_NEON
+static inline float64x2_t
+shift_in_neon (float64x2_t y1, const gdouble * p)
+{
+  return vextq_f64 (vld1q_dup_f64 (p), y1, 1);
+}
+
+static inline void
+store_last_neon (gdouble * p, float64x2_t v)
+{
+  vst1q_lane_f64 (p, v, 1);
+}
+
+CREATE_CASCADE_KERNEL (neon, , float64x2_t, 2, vld1q_f64, vst1q_f64,
+    vmulq_f64, vaddq_f64, shift_in_neon, store_last_neon);
+#endif
+
+/* S16 and F32 share the layout of their history, see
+ * CREATE_OPTIMIZED_FUNCTIONS_INT (gint16, gfloat, ...). It is only rounded
+ * to single precision at the end of a buffer. */
+static void
+gst_iir_equ_process_lanes (GstIirEqualizer * equ, guint8 * data,
+    guint frames, guint channels, gboolean s16)
+{
+  guint nf = equ->freq_band_count, na = equ->active_band_count;
+  SecondOrderHistorygfloat *history[2];
+  gdouble block[2][EQU_LANE_BLOCK];
+  EquCascade cas, group;
+  guint c, k, i, j, l, n, nl, w, pair;
+
+  if (na == 0)
+    return;
+
+  for (nl = 0; nl < na; nl += cascade_group_width (na, nl));
+
+  cas.lanes = nl;
+  cas.a0 = equ->lanes;
+  cas.a1 = cas.a0 + nl;
+  cas.a2 = cas.a1 + nl;
+  cas.b1 = cas.a2 + nl;
+  cas.b2 = cas.b1 + nl;
+  for (k = 0; k < 2; k++) {
+    cas.h[k].x1 = cas.b2 + (4 * k + 1) * nl;
+    cas.h[k].x2 = cas.h[k].x1 + nl;
+    cas.h[k].y1 = cas.h[k].x2 + nl;
+    cas.h[k].y2 = cas.h[k].y1 + nl;
+  }
+
+  for (l = 0; l < nl; l++) {
+    GstIirEqualizerBand *band =
+        (l < na) ? equ->bands[equ->active_bands[l]] : NULL;
+
+    cas.a0[l] = band ? band->a0 : 1.0;
+    cas.a1[l] = band ? band->a1 : 0.0;
+    cas.a2[l] = band ? band->a2 : 0.0;
+    cas.b1[l] = band ? band->b1 : 0.0;
+    cas.b2[l] = band ? band->b2 : 0.0;
+  }
+
+  /* an odd channel is paired with silence */
+  for (c = 0; c < channels; c += pair) {
+    pair = MIN (channels - c, 2);
+
+    for (k = 0; k < 2; k++) {
+      history[k] = (k < pair) ?
+          (SecondOrderHistorygfloat *) equ->history + (c + k) * nf : NULL;
+      for (l = 0; l < nl; l++) {
+        SecondOrderHistorygfloat *h =
+            (history[k] && l < na) ? history[k] + equ->active_bands[l] : NULL;
+
+        cas.h[k].x1[l] = h ? h->x1 : 0.0;
+        cas.h[k].x2[l] = h ? h->x2 : 0.0;
+        cas.h[k].y1[l] = h ? h->y1 : 0.0;
+        cas.h[k].y2[l] = h ? h->y2 : 0.0;
+      }
+    }
+
+    for (i = 0; i < frames; i += n) {
+      n = MIN (frames - i, EQU_LANE_BLOCK);
+
+      for (k = 0; k < 2; k++) {
+        if (k >= pair) {
+          memset (block[k], 0, n * sizeof (gdouble));
+        } else if (s16) {
+          const gint16 *src = (const gint16 *) data + i * channels + c + k;
+          for (j = 0; j < n; j++)
+            block[k][j] = src[j * channels];
+        } else {
+          const gfloat *src = (const gfloat *) data + i * channels + c + k;
+          for (j = 0; j < n; j++)
+            block[k][j] = src[j * channels];
+        }
+      }
+
+      for (l = 0; l < nl; l += w) {
+        w = cascade_group_width (na, l);
+        cascade_group (&cas, &group, l, w);
+        /* short blocks would spend most of their time filling and draining */
+        if (n < 2 * w)
+          cascade_scalar (&group, block, n);
+        else if (w == 4)
+          cascade_4 (&group, block, n);
+        else
+          cascade_2 (&group, block, n);
+      }
+
+      for (k = 0; k < pair; k++) {
+        if (s16) {
+          gint16 *dst = (gint16 *) data + i * channels + c + k;
+          for (j = 0; j < n; j++) {
+            gdouble cur = CLAMP (block[k][j], -32768.0, 32767.0);
+            dst[j * channels] = (gint16) floor (cur);
+          }
+        } else {
+          gfloat *dst = (gfloat *) data + i * channels + c + k;
+          for (j = 0; j < n; j++)
+            dst[j * channels] = (gfloat) block[k][j];
+        }
+      }
+    }
+
+    for (k = 0; k < pair; k++) {
+      for (l = 0; l < na; l++) {
+        SecondOrderHistorygfloat *h = history[k] + equ->active_bands[l];
+
+        h->x1 = (gfloat) cas.h[k].x1[l];
+        h->x2 = (gfloat) cas.h[k].x2[l];
+        h->y1 = (gfloat) cas.h[k].y1[l];
+        h->y2 = (gfloat) cas.h[k].y2[l];
+      }
+    }
+  }
+}
+
+static void
+gst_iir_equ_lanes_gint16 (GstIirEqualizer * equ, guint8 * data, guint size,
+    guint channels)
+{
+  guint frames = size / channels / sizeof (gint16);
+
+  gst_iir_equ_save_input_gint16 (equ, data, frames, channels);
+  gst_iir_equ_process_lanes (equ, data, frames, channels, TRUE);
+}
+
+static void
+gst_iir_equ_lanes_gfloat (GstIirEqualizer * equ, guint8 * data, guint size,
+    guint channels)
+{
+  guint frames = size / channels / sizeof (gfloat);
+
+  gst_iir_equ_save_input_gfloat (equ, data, frames, channels);
+  gst_iir_equ_process_lanes (equ, data, frames, channels, FALSE);
+}
+#endif // EQU_SIMD_SSE2 || EQU_SIMD_NEON
+
+static void
+select_cascade (void)
+{
+#if defined(EQU_SIMD_SSE2)
+  cascade_2 = cascade_sse2;
+#ifdef EQU_SIMD_AVX
+  if (cpu_supports_avx ())
+    cascade_4 = cascade_avx;
+#endif
+#elif defined(EQU_SIMD_NEON)
+  cascade_2 = cascade_neon;
+#endif
+}
+#endif // GSTREAMER_LITE
 
 static GstFlowReturn
 gst_iir_equalizer_transform_ip (GstBaseTransform * btrans, GstBuffer * buf)
@@ -887,6 +1598,11 @@ gst_iir_equalizer_transform_ip (GstBaseTransform * btrans, GstBuffer * buf)
   if (need_new_coefficients) {
     update_coefficients (equ);
   }
+#ifdef GSTREAMER_LITE
+  else if (equ->bands_settling) {
+    update_active_bands (equ);
+  }
+#endif // GSTREAMER_LITE
   BANDS_UNLOCK (equ);
 
   gst_buffer_map (buf, &map, GST_MAP_READWRITE);
@@ -905,14 +1621,34 @@ gst_iir_equalizer_setup (GstAudioFilter * audio, const GstAudioInfo * info)
     case GST_AUDIO_FORMAT_S16:
       equ->history_size = history_size_gint16;
       equ->process = gst_iir_equ_process_gint16;
+#ifdef GSTREAMER_LITE
+      equ->seed = gst_iir_equ_seed_gint16;
+      equ->settled = gst_iir_equ_settled_gint16;
+#ifdef EQU_SIMD_LANES
+      if (cascade_2)
+        equ->process = gst_iir_equ_lanes_gint16;
+#endif
+#endif // GSTREAMER_LITE
       break;
     case GST_AUDIO_FORMAT_F32:
       equ->history_size = history_size_gfloat;
       equ->process = gst_iir_equ_process_gfloat;
+#ifdef GSTREAMER_LITE
+      equ->seed = gst_iir_equ_seed_gfloat;
+      equ->settled = gst_iir_equ_settled_gfloat;
+#ifdef EQU_SIMD_LANES
+      if (cascade_2)
+        equ->process = gst_iir_equ_lanes_gfloat;
+#endif
+#endif // GSTREAMER_LITE
       break;
     case GST_AUDIO_FORMAT_F64:
       equ->history_size = history_size_gdouble;
       equ->process = gst_iir_equ_process_gdouble;
+#ifdef GSTREAMER_LITE
+      equ->seed = gst_iir_equ_seed_gdouble;
+      equ->settled = gst_iir_equ_settled_gdouble;
+#endif // GSTREAMER_LITE
       break;
     default:
       return FALSE;
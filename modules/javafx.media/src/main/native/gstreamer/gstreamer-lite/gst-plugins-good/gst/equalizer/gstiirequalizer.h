@@ -49,6 +49,12 @@ typedef struct _GstIirEqualizerBand GstIirEqualizerBand;
 
 typedef void (*ProcessFunc) (GstIirEqualizer * eq, guint8 * data, guint size,
     guint channels);
+#ifdef GSTREAMER_LITE
+typedef void (*SeedFunc) (GstIirEqualizer * eq, guint band, gint prev,
+    guint channels);
+typedef gboolean (*SettledFunc) (GstIirEqualizer * eq, guint band,
+    guint channels);
+#endif // GSTREAMER_LITE
 
 struct _GstIirEqualizer
 {
@@ -68,6 +74,20 @@ struct _GstIirEqualizer
   gboolean need_new_coefficients;
 
   ProcessFunc process;
+
+#ifdef GSTREAMER_LITE
+  /* bands that are not at 0 dB, in order, the others are bypassed */
+  guint *active_bands;
+  guint active_band_count;
+  gboolean *band_active;
+  gboolean bands_settling;
+  /* last two input frames of each channel, to restart bypassed bands */
+  gdouble *last_input;
+  SeedFunc seed;
+  SettledFunc settled;
+  /* coefficients and history of the active bands laid out in SIMD lanes */
+  gdouble *lanes;
+#endif // GSTREAMER_LITE
 };
 
 struct _GstIirEqualizerClass
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -53,5 +53,13 @@
 // Not required since 58 and removed in 59
 #define NO_REGISTER_ALL        (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59,0,0))
 
+// Custom "get_buffer2()" callbacks with reference counted frames. Also
+// requires frame width and height, which came with the new frame API.
+#define USE_GET_BUFFER2        (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(55,28,0))
+
+// "thread_safe_callbacks" was removed in 60. Callbacks are always expected
+// to be thread safe since then.
+#define THREAD_SAFE_CALLBACKS  (LIBAVCODEC_VERSION_INT < AV_VERSION_INT(60,0,0))
+
 #endif  /* AVDEFINES_H */
 
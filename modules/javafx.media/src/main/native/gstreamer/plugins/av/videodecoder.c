@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -45,8 +45,18 @@ enum
     PROP_0,
     PROP_CODEC_ID,
     PROP_IS_SUPPORTED,
+    PROP_THREAD_COUNT,
+    PROP_THREAD_TYPE,
+    PROP_DIRECT_RENDERING,
 };
 
+#if !defined(AV_CODEC_CAP_DR1)
+#define AV_CODEC_CAP_DR1 CODEC_CAP_DR1
+#endif
+
+// Alignment of pooled frame buffers and their planes, enough for AVX-512.
+#define FRAME_BUFFER_ALIGN 64
+
 /*
  * The input capabilities.
  */
@@ -120,8 +130,11 @@ static void                 videodecoder_init_state(VideoDecoder *decoder);
 static void                 videodecoder_state_reset(VideoDecoder *decoder);
 
 static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps);
+static void     videodecoder_drain(VideoDecoder *decoder);
 
 static void videodecoder_dispose(GObject* object);
+static void videodecoder_finalize(GObject* object);
+static void videodecoder_init_context(BaseDecoder *base);
 static void videodecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 static void videodecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
@@ -144,6 +157,7 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
     element_class->change_state = videodecoder_change_state;
 
     gobject_class->dispose = videodecoder_dispose;
+    gobject_class->finalize = videodecoder_finalize;
     gobject_class->set_property = videodecoder_set_property;
     gobject_class->get_property = videodecoder_get_property;
 
@@ -154,6 +168,21 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
     g_object_class_install_property (gobject_class, PROP_IS_SUPPORTED,
         g_param_spec_boolean ("is-supported", "Is supported", "Is codec ID supported", FALSE,
         (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_COUNT,
+        g_param_spec_int ("thread-count", "Thread count", "Number of decoding threads, 0 for one per CPU", 0, 64, 0,
+        (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_TYPE,
+        g_param_spec_int ("thread-type", "Thread type", "Threading methods, 1 for frames, 2 for slices, 3 for both", 0, 3,
+        FF_THREAD_FRAME | FF_THREAD_SLICE,
+        (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property (gobject_class, PROP_DIRECT_RENDERING,
+        g_param_spec_boolean ("direct-rendering", "Direct rendering", "Decode into pooled output buffers", TRUE,
+        (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    BASEDECODER_CLASS(klass)->init_context = videodecoder_init_context;
 }
 
 static void videodecoder_init(VideoDecoder *decoder)
@@ -170,10 +199,26 @@ static void videodecoder_init(VideoDecoder *decoder)
     base->srcpad = gst_pad_new_from_static_template(&source_template, "src");
     gst_pad_use_fixed_caps(base->srcpad);
     gst_element_add_pad(GST_ELEMENT(decoder), base->srcpad);
+
+    g_mutex_init(&decoder->pool_lock);
+    decoder->pool = NULL;
+    decoder->pool_size = 0;
 }
 
 void videodecoder_close_decoder(VideoDecoder *decoder)
 {
+    // Frames still held downstream keep the pool alive and are freed,
+    // rather than returned, once the pool is inactive.
+    g_mutex_lock(&decoder->pool_lock);
+    if (decoder->pool)
+    {
+        gst_buffer_pool_set_active(decoder->pool, FALSE);
+        gst_object_unref(decoder->pool);
+        decoder->pool = NULL;
+        decoder->pool_size = 0;
+    }
+    g_mutex_unlock(&decoder->pool_lock);
+
 #if HEVC_SUPPORT
     if (decoder->dest_frame)
     {
@@ -199,11 +244,21 @@ static void videodecoder_dispose(GObject* object)
 {
     VideoDecoder *decoder = VIDEODECODER(object);
 
-    basedecoder_close_decoder(decoder);
+    basedecoder_close_decoder(BASEDECODER(decoder));
+    videodecoder_close_decoder(decoder);
 
     G_OBJECT_CLASS(parent_class)->dispose(object);
 }
 
+static void videodecoder_finalize(GObject* object)
+{
+    VideoDecoder *decoder = VIDEODECODER(object);
+
+    g_mutex_clear(&decoder->pool_lock);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
 static gboolean videodecoder_is_decoder_by_codec_id_supported(gint codec_id)
 {
     switch(codec_id)
@@ -234,6 +289,15 @@ static void videodecoder_set_property(GObject *object, guint property_id, const
     case PROP_CODEC_ID:
         decoder->codec_id = g_value_get_int(value);
         break;
+    case PROP_THREAD_COUNT:
+        decoder->thread_count = g_value_get_int(value);
+        break;
+    case PROP_THREAD_TYPE:
+        decoder->thread_type = g_value_get_int(value);
+        break;
+    case PROP_DIRECT_RENDERING:
+        decoder->direct_rendering = g_value_get_boolean(value);
+        break;
     default:
         break;
     }
@@ -249,6 +313,15 @@ static void videodecoder_get_property(GObject *object, guint property_id, GValue
         is_supported = videodecoder_is_decoder_by_codec_id_supported(decoder->codec_id);
         g_value_set_boolean(value, is_supported);
         break;
+    case PROP_THREAD_COUNT:
+        g_value_set_int(value, decoder->thread_count);
+        break;
+    case PROP_THREAD_TYPE:
+        g_value_set_int(value, decoder->thread_type);
+        break;
+    case PROP_DIRECT_RENDERING:
+        g_value_set_boolean(value, decoder->direct_rendering);
+        break;
     default:
         break;
     }
@@ -284,6 +357,7 @@ videodecoder_change_state(GstElement* element, GstStateChange transition)
     {
         case GST_STATE_CHANGE_PAUSED_TO_READY:
             basedecoder_close_decoder(BASEDECODER(decoder));
+            videodecoder_close_decoder(decoder);
             break;
         default:
             break;
@@ -316,6 +390,12 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
             BASEDECODER(decoder)->is_flushing = FALSE;
             break;
 
+        case GST_EVENT_EOS:
+            // Output the frames still queued in the decoding threads.
+            if (BASEDECODER(decoder)->is_initialized && !BASEDECODER(decoder)->is_flushing)
+                videodecoder_drain(decoder);
+            break;
+
         case GST_EVENT_CAPS:
         {
             GstCaps *caps;
@@ -362,12 +442,15 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
 static void videodecoder_init_state(VideoDecoder *decoder)
 {
     decoder->width = decoder->height = 0;
+    decoder->y_offset = 0;
     decoder->u_offset = 0;
     decoder->v_offset = 0;
     decoder->uv_blocksize = 0;
     decoder->frame_size = 0;
     decoder->discont = FALSE;
     decoder->codec_id = JFX_CODEC_ID_UNKNOWN;
+    decoder->is_direct_rendering = FALSE;
+    decoder->direct_frames = FALSE;
 #if HEVC_SUPPORT
     decoder->sws_context = NULL;
     decoder->dest_frame = NULL;
@@ -444,6 +527,179 @@ static void videodecoder_state_reset(VideoDecoder *decoder)
     basedecoder_flush(BASEDECODER(decoder));
 }
 
+/***********************************************************************************
+ * Threading and direct rendering
+ ***********************************************************************************/
+#if USE_GET_BUFFER2
+typedef struct _FrameBuffer
+{
+    GstBuffer  *buffer;
+    GstMapInfo  info;
+} FrameBuffer;
+
+// Called by libavcodec once it and all output buffers wrapping the frame
+// are done with it.
+static void videodecoder_release_frame_buffer(void *opaque, uint8_t *data)
+{
+    FrameBuffer *frame_buffer = (FrameBuffer*)opaque;
+
+    gst_buffer_unmap(frame_buffer->buffer, &frame_buffer->info);
+    // Returns the buffer to its pool.
+    gst_buffer_unref(frame_buffer->buffer);
+    g_free(frame_buffer);
+}
+
+static void videodecoder_unref_frame_buffer(gpointer data)
+{
+    AVBufferRef *ref = (AVBufferRef*)data;
+    av_buffer_unref(&ref);
+}
+
+static GstBufferPool* videodecoder_get_pool(VideoDecoder *decoder, guint size)
+{
+    GstBufferPool *pool = NULL;
+
+    g_mutex_lock(&decoder->pool_lock);
+    if (decoder->pool == NULL || decoder->pool_size != size)
+    {
+        if (decoder->pool)
+        {
+            gst_buffer_pool_set_active(decoder->pool, FALSE);
+            gst_object_unref(decoder->pool);
+            decoder->pool = NULL;
+            decoder->pool_size = 0;
+        }
+
+        GstAllocationParams params;
+        gst_allocation_params_init(&params);
+        params.align = FRAME_BUFFER_ALIGN - 1;
+
+        // Reference frames, frames in flight in the decoding threads and
+        // frames queued downstream all hold buffers, so the pool is
+        // unbounded and simply keeps what was returned to it.
+        pool = gst_buffer_pool_new();
+        GstStructure *config = gst_buffer_pool_get_config(pool);
+        gst_buffer_pool_config_set_params(config, NULL, size, 0, 0);
+        gst_buffer_pool_config_set_allocator(config, NULL, &params);
+        if (gst_buffer_pool_set_config(pool, config) && gst_buffer_pool_set_active(pool, TRUE))
+        {
+            decoder->pool = pool;
+            decoder->pool_size = size;
+        }
+        else
+            gst_object_unref(pool);
+    }
+
+    pool = decoder->pool ? gst_object_ref(decoder->pool) : NULL;
+    g_mutex_unlock(&decoder->pool_lock);
+
+    return pool;
+}
+
+// Allocates the pictures libavcodec decodes into from a pool of output
+// buffers, laid out the way they are described on the source pad, so that
+// they can be pushed without copying. Called from the decoding threads.
+static int videodecoder_get_buffer2(AVCodecContext *context, AVFrame *frame, int flags)
+{
+    VideoDecoder *decoder = (VideoDecoder*)context->opaque;
+
+    // Other formats are converted to YUV420P anyway.
+    if (frame->format != AV_PIX_FMT_YUV420P)
+        return avcodec_default_get_buffer2(context, frame, flags);
+
+    int width = frame->width;
+    int height = frame->height;
+    int linesize_align[AV_NUM_DATA_POINTERS];
+    avcodec_align_dimensions2(context, &width, &height, linesize_align);
+
+    // Chroma strides are half the luma stride.
+    int align = FRAME_BUFFER_ALIGN;
+    int i;
+    for (i = 0; i < 3; i++)
+        align = MAX(align, linesize_align[i]);
+
+    int stride_y = GST_ROUND_UP_N(width, 2 * align);
+    int stride_uv = stride_y / 2;
+    height = GST_ROUND_UP_2(height);
+
+    guint size_y = stride_y * height;
+    guint size_uv = stride_uv * (height / 2);
+    // libavcodec may read a little past the end of the last plane.
+    guint size = size_y + 2 * size_uv + 2 * FRAME_BUFFER_ALIGN;
+
+    GstBufferPool *pool = videodecoder_get_pool(decoder, size);
+    if (pool == NULL)
+        return AVERROR(ENOMEM);
+
+    GstBuffer *buffer = NULL;
+    GstFlowReturn ret = gst_buffer_pool_acquire_buffer(pool, &buffer, NULL);
+    gst_object_unref(pool);
+    if (ret != GST_FLOW_OK)
+        return AVERROR(ENOMEM);
+
+    FrameBuffer *frame_buffer = g_new(FrameBuffer, 1);
+    frame_buffer->buffer = buffer;
+    if (!gst_buffer_map(buffer, &frame_buffer->info, GST_MAP_READWRITE))
+    {
+        gst_buffer_unref(buffer);
+        g_free(frame_buffer);
+        return AVERROR(ENOMEM);
+    }
+
+    frame->buf[0] = av_buffer_create(frame_buffer->info.data, size,
+                                     videodecoder_release_frame_buffer, frame_buffer, 0);
+    if (frame->buf[0] == NULL)
+    {
+        videodecoder_release_frame_buffer(frame_buffer, NULL);
+        return AVERROR(ENOMEM);
+    }
+
+    frame->data[0] = frame_buffer->info.data;
+    frame->data[1] = frame->data[0] + size_y;
+    frame->data[2] = frame->data[1] + size_uv;
+    frame->linesize[0] = stride_y;
+    frame->linesize[1] = stride_uv;
+    frame->linesize[2] = stride_uv;
+    frame->extended_data = frame->data;
+
+    return 0;
+}
+
+// Whether the current frame was decoded into a pooled output buffer.
+static gboolean videodecoder_is_direct_frame(VideoDecoder *decoder)
+{
+    BaseDecoder *base = BASEDECODER(decoder);
+
+    return decoder->is_direct_rendering &&
+           base->frame->format == AV_PIX_FMT_YUV420P &&
+           base->frame->buf[0] != NULL;
+}
+#endif // USE_GET_BUFFER2
+
+static void videodecoder_init_context(BaseDecoder *base)
+{
+    VideoDecoder *decoder = VIDEODECODER(base);
+
+    BASEDECODER_CLASS(parent_class)->init_context(base);
+
+    base->context->thread_count = decoder->thread_count;
+    base->context->thread_type = decoder->thread_type;
+#if THREAD_SAFE_CALLBACKS
+    // Otherwise frame threads serialize get_buffer2() on the calling thread.
+    base->context->thread_safe_callbacks = 1;
+#endif
+
+#if USE_GET_BUFFER2
+    decoder->is_direct_rendering = decoder->direct_rendering &&
+                                   (base->codec->capabilities & AV_CODEC_CAP_DR1);
+    if (decoder->is_direct_rendering)
+    {
+        base->context->opaque = decoder;
+        base->context->get_buffer2 = videodecoder_get_buffer2;
+    }
+#endif // USE_GET_BUFFER2
+}
+
 #if HEVC_SUPPORT
 static gboolean videodecoder_init_converter(VideoDecoder *decoder)
 {
@@ -578,8 +834,18 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
     int height = base->context->height;
 #endif // NEW_CODEC_ID
 
+#if USE_GET_BUFFER2
+    gboolean direct = videodecoder_is_direct_frame(decoder);
+    // Non-zero when libavcodec crops the top or left of the picture.
+    unsigned int y_offset = direct ? (unsigned int)(base->frame->data[0] - base->frame->buf[0]->data) : 0;
+#else
+    gboolean direct = FALSE;
+    unsigned int y_offset = 0;
+#endif // USE_GET_BUFFER2
+
     if (caps == NULL ||
-        decoder->width != width || decoder->height != height)
+        decoder->width != width || decoder->height != height ||
+        decoder->direct_frames != direct || decoder->y_offset != y_offset)
     {
         decoder->width = width;
         decoder->height = height;
@@ -626,11 +892,28 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
             linesize2 = base->frame->linesize[2];
         }
 
-        decoder->u_offset = linesize0 * decoder->height;
-        decoder->uv_blocksize = linesize1 * decoder->height / 2;
+        decoder->direct_frames = direct;
+        decoder->y_offset = y_offset;
 
-        decoder->v_offset = decoder->u_offset + decoder->uv_blocksize;
-        decoder->frame_size = (linesize0 + linesize1) * decoder->height;
+#if USE_GET_BUFFER2
+        if (direct)
+        {
+            // Pooled buffers are pushed as they are, padding included.
+            uint8_t *start = base->frame->buf[0]->data;
+            decoder->u_offset = base->frame->data[1] - start;
+            decoder->v_offset = base->frame->data[2] - start;
+            decoder->uv_blocksize = decoder->v_offset - decoder->u_offset;
+            decoder->frame_size = base->frame->buf[0]->size;
+        }
+        else
+#endif // USE_GET_BUFFER2
+        {
+            decoder->u_offset = linesize0 * decoder->height;
+            decoder->uv_blocksize = linesize1 * decoder->height / 2;
+
+            decoder->v_offset = decoder->u_offset + decoder->uv_blocksize;
+            decoder->frame_size = (linesize0 + linesize1) * decoder->height;
+        }
 
         GstCaps *src_caps = gst_caps_new_simple("video/x-raw-yuv",
                                                 "format", G_TYPE_STRING, "YV12",
@@ -639,7 +922,7 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
                                                 "stride-y", G_TYPE_INT, linesize0,
                                                 "stride-u", G_TYPE_INT, linesize1,
                                                 "stride-v", G_TYPE_INT, linesize2,
-                                                "offset-y", G_TYPE_INT, 0,
+                                                "offset-y", G_TYPE_INT, decoder->y_offset,
                                                 "offset-u", G_TYPE_INT, decoder->u_offset,
                                                 "offset-v", G_TYPE_INT, decoder->v_offset,
                                                 "framerate", GST_TYPE_FRACTION, 2997, 100,
@@ -669,15 +952,11 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 /***********************************************************************************
  * chain
  ***********************************************************************************/
-static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffer *buf)
+static GstFlowReturn videodecoder_push_frame(VideoDecoder *decoder, GstClockTime duration, gboolean discont)
 {
-    VideoDecoder  *decoder = VIDEODECODER(parent);
     BaseDecoder   *base = BASEDECODER(decoder);
     GstFlowReturn  result = GST_FLOW_OK;
-    int            num_dec = NO_DATA_USED;
-    GstMapInfo     info;
     GstMapInfo     info2;
-    gboolean       unmap_buf = FALSE;
     gboolean       set_frame_values = TRUE;
     int64_t        reordered_opaque = AV_NOPTS_VALUE;
     unsigned int   out_buf_size = 0;
@@ -685,86 +964,204 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     uint8_t*       data0 = NULL;
     uint8_t*       data1 = NULL;
     uint8_t*       data2 = NULL;
+    GstBuffer     *outbuf = NULL;
 
-    if (base->is_flushing)  // Reject buffers in flushing state.
-    {
-        result = GST_FLOW_FLUSHING;
-        goto _exit;
-    }
+    if (!videodecoder_configure_sourcepad(decoder))
+        return GST_FLOW_ERROR;
 
-    if (!base->is_initialized)
+#if USE_GET_BUFFER2
+    if (videodecoder_is_direct_frame(decoder))
     {
-        result = GST_FLOW_ERROR;
-        goto _exit;
-    }
+        // The picture already sits in a pooled buffer laid out as the caps
+        // say. Downstream gets its own reference, libavcodec may still use
+        // the picture as a reference frame.
+        AVBufferRef *ref = av_buffer_ref(base->frame->buf[0]);
+        if (ref != NULL)
+            outbuf = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, ref->data, ref->size,
+                                                 0, ref->size, ref, videodecoder_unref_frame_buffer);
+        if (outbuf == NULL)
+        {
+            if (ref != NULL)
+                av_buffer_unref(&ref);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                     GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                     g_strdup("Decoded video buffer allocation failed"), NULL,
+                                     ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
 
-    if (!gst_buffer_map(buf, &info, GST_MAP_READ))
-    {
-        result = GST_FLOW_ERROR;
-        goto _exit;
+        reordered_opaque = base->frame->reordered_opaque;
     }
+    else
+#endif // USE_GET_BUFFER2
+    {
+#if HEVC_SUPPORT
+        // Check to see if we need to convert frame to YUV420p
+        if (base->frame->format != AV_PIX_FMT_YUV420P)
+        {
+            if (!videodecoder_convert_frame(decoder))
+            {
+                gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                         GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                         g_strdup("Video frame conversion failed"), NULL,
+                                         ("videodecoder.c"), ("videodecoder_push_frame"), 0);
 
-    unmap_buf = TRUE;
+                return GST_FLOW_ERROR;
+            }
 
-    if (!base->is_hls)
-    {
-        if (av_new_packet(&decoder->packet, info.size) == 0)
+            reordered_opaque = decoder->dest_frame->reordered_opaque;
+            data0 = decoder->dest_frame->data[0];
+            data1 = decoder->dest_frame->data[1];
+            data2 = decoder->dest_frame->data[2];
+            set_frame_values = FALSE;
+        }
+#endif // HEVC_SUPPORT
+
+        if (set_frame_values)
         {
-            memcpy(decoder->packet.data, info.data, info.size);
-            if (GST_BUFFER_TIMESTAMP_IS_VALID(buf))
-                base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
-            else
-                base->context->reordered_opaque = AV_NOPTS_VALUE;
-#if USE_SEND_RECEIVE
-            num_dec = avcodec_send_packet(base->context, &decoder->packet);
-            if (num_dec == 0)
+            reordered_opaque = base->frame->reordered_opaque;
+            data0 = base->frame->data[0];
+            data1 = base->frame->data[1];
+            data2 = base->frame->data[2];
+        }
+
+        outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
+        if (outbuf == NULL)
+        {
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                     GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                     g_strdup("Decoded video buffer allocation failed"), NULL,
+                                     ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
+
+        if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
+        {
+            // INLINE - gst_buffer_unref()
+            gst_buffer_unref(outbuf);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                             g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
+
+        // Copy image by parts from different arrays.
+        if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
+        {
+            gst_buffer_unmap(outbuf, &info2);
+            // INLINE - gst_buffer_unref()
+            gst_buffer_unref(outbuf);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                             g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
+
+        out_buf_size = decoder->frame_size;
+        if (out_buf_size >= decoder->u_offset)
+        {
+            memcpy(info2.data, data0, decoder->u_offset);
+            out_buf_size -= decoder->u_offset;
+            if (out_buf_size >= decoder->uv_blocksize &&
+                decoder->uv_blocksize <= decoder->frame_size &&
+                decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
             {
-                num_dec = avcodec_receive_frame(base->context, base->frame);
-                if (num_dec == 0)
-                    decoder->frame_finished = 1;
+                memcpy(info2.data + decoder->u_offset, data1, decoder->uv_blocksize);
+                out_buf_size -= decoder->uv_blocksize;
+                if (out_buf_size >= decoder->uv_blocksize &&
+                    decoder->uv_blocksize <= decoder->frame_size &&
+                    decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
+                {
+                    memcpy(info2.data + decoder->v_offset, data2, decoder->uv_blocksize);
+                }
                 else
-                    decoder->frame_finished = 0;
+                {
+                    copy_error = TRUE;
+                }
+            }
+            else
+            {
+                copy_error = TRUE;
             }
-#else
-            num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
-#endif
-
-#if PACKET_UNREF
-            av_packet_unref(&decoder->packet);
-#else
-            av_free_packet(&decoder->packet);
-#endif
         }
         else
         {
-            result = GST_FLOW_ERROR;
-            goto _exit;
+            copy_error = TRUE;
+        }
+
+        gst_buffer_unmap(outbuf, &info2);
+
+        if (copy_error)
+        {
+            // INLINE - gst_buffer_unref()
+            gst_buffer_unref(outbuf);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                             g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
         }
     }
-    else
+
+    GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
+    if (reordered_opaque != AV_NOPTS_VALUE)
     {
-        av_init_packet(&decoder->packet);
-        decoder->packet.data = info.data;
-        decoder->packet.size = info.size;
-        if (GST_BUFFER_TIMESTAMP_IS_VALID(buf))
-            base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
-        else
-            base->context->reordered_opaque = AV_NOPTS_VALUE;
+        GST_BUFFER_TIMESTAMP(outbuf) = reordered_opaque;
+        GST_BUFFER_DURATION(outbuf) = duration; // Duration for video usually same
+    }
+    GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
+
+    if (decoder->discont || discont)
+    {
+#ifdef DEBUG_OUTPUT
+        g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
+#endif
+        GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
+        decoder->discont = FALSE;
+    }
+
+#ifdef VERBOSE_DEBUG
+    g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
+#endif
+    result = gst_pad_push(base->srcpad, outbuf);
+#ifdef VERBOSE_DEBUG
+    g_print(" done, res=%s\n", gst_flow_get_name(result));
+#endif
+
+    return result;
+}
+
+// Decodes a packet and pushes the frames it completes. With frame threading
+// a packet completes none or, while the threads catch up, several frames.
+static GstFlowReturn videodecoder_decode_packet(VideoDecoder *decoder, AVPacket *packet,
+                                                GstClockTime duration, gboolean discont)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+    int            num_dec = NO_DATA_USED;
 
 #if USE_SEND_RECEIVE
-        num_dec = avcodec_send_packet(base->context, &decoder->packet);
-        if (num_dec == 0)
+    num_dec = avcodec_send_packet(base->context, packet);
+    while (num_dec == 0 && result == GST_FLOW_OK)
+    {
+        num_dec = avcodec_receive_frame(base->context, base->frame);
+        decoder->frame_finished = (num_dec == 0);
+        if (num_dec == AVERROR(EAGAIN) || num_dec == AVERROR_EOF)
+            return result;
+        if (decoder->frame_finished)
         {
-            num_dec = avcodec_receive_frame(base->context, base->frame);
-            if (num_dec == 0)
-                decoder->frame_finished = 1;
-            else
-                decoder->frame_finished = 0;
+            result = videodecoder_push_frame(decoder, duration, discont);
+            discont = FALSE;
         }
+    }
 #else
-        num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
+    // An empty packet drains one frame at a time.
+    do
+    {
+        num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, packet);
+        if (num_dec >= 0 && decoder->frame_finished > 0)
+        {
+            result = videodecoder_push_frame(decoder, duration, discont);
+            discont = FALSE;
+        }
+    } while (num_dec >= 0 && decoder->frame_finished > 0 && packet->size == 0 && result == GST_FLOW_OK);
 #endif
-    }
 
     if (num_dec < 0)
     {
@@ -772,150 +1169,85 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
 #ifdef DEBUG_OUTPUT
         g_print ("videodecoder_chain error: %s\n", avelement_error_to_string(AVELEMENT(decoder), num_dec));
 #endif
-        goto _exit;
     }
 
-    if (decoder->frame_finished > 0)
-    {
-        if (!videodecoder_configure_sourcepad(decoder))
-            result = GST_FLOW_ERROR;
-        else
-        {
-#if HEVC_SUPPORT
-            // Check to see if we need to convert frame to YUV420p
-            if (base->frame->format != AV_PIX_FMT_YUV420P)
-            {
-                if (!videodecoder_convert_frame(decoder))
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             g_strdup("Video frame conversion failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-
-                    result = GST_FLOW_ERROR;
-                    goto _exit;
-                }
-
-                reordered_opaque = decoder->dest_frame->reordered_opaque;
-                data0 = decoder->dest_frame->data[0];
-                data1 = decoder->dest_frame->data[1];
-                data2 = decoder->dest_frame->data[2];
-                set_frame_values = FALSE;
-            }
-#endif // HEVC_SUPPORTf
-
-            if (set_frame_values)
-            {
-                reordered_opaque = base->frame->reordered_opaque;
-                data0 = base->frame->data[0];
-                data1 = base->frame->data[1];
-                data2 = base->frame->data[2];
-            }
+    return result;
+}
 
-            GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
-            if (outbuf == NULL)
-            {
-                if (result != GST_FLOW_FLUSHING)
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             g_strdup("Decoded video buffer allocation failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-                }
-            }
-            else
-            {
-                GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
-                if (reordered_opaque != AV_NOPTS_VALUE)
-                {
-                    GST_BUFFER_TIMESTAMP(outbuf) = reordered_opaque;
-                    GST_BUFFER_DURATION(outbuf) = GST_BUFFER_DURATION(buf); // Duration for video usually same
-                }
+static void videodecoder_drain(VideoDecoder *decoder)
+{
+#if USE_SEND_RECEIVE
+    videodecoder_decode_packet(decoder, NULL, GST_CLOCK_TIME_NONE, FALSE);
+#else
+    AVPacket packet;
+    av_init_packet(&packet);
+    packet.data = NULL;
+    packet.size = 0;
+    videodecoder_decode_packet(decoder, &packet, GST_CLOCK_TIME_NONE, FALSE);
+#endif
+    // Leave draining mode so that decoding can resume after a seek.
+    basedecoder_flush(BASEDECODER(decoder));
+}
 
-                if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
+static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffer *buf)
+{
+    VideoDecoder  *decoder = VIDEODECODER(parent);
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+    GstMapInfo     info;
+    gboolean       unmap_buf = FALSE;
 
-                // Copy image by parts from different arrays.
-                if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
-                {
-                    gst_buffer_unmap(outbuf, &info2);
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
+    if (base->is_flushing)  // Reject buffers in flushing state.
+    {
+        result = GST_FLOW_FLUSHING;
+        goto _exit;
+    }
 
-                out_buf_size = decoder->frame_size;
-                if (out_buf_size >= decoder->u_offset)
-                {
-                    memcpy(info2.data, data0, decoder->u_offset);
-                    out_buf_size -= decoder->u_offset;
-                    if (out_buf_size >= decoder->uv_blocksize &&
-                        decoder->uv_blocksize <= decoder->frame_size &&
-                        decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                    {
-                        memcpy(info2.data + decoder->u_offset, data1, decoder->uv_blocksize);
-                        out_buf_size -= decoder->uv_blocksize;
-                        if (out_buf_size >= decoder->uv_blocksize &&
-                            decoder->uv_blocksize <= decoder->frame_size &&
-                            decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                        {
-                            memcpy(info2.data + decoder->v_offset, data2, decoder->uv_blocksize);
-                        }
-                        else
-                        {
-                            copy_error = TRUE;
-                        }
-                    }
-                    else
-                    {
-                        copy_error = TRUE;
-                    }
-                }
-                else
-                {
-                    copy_error = TRUE;
-                }
+    if (!base->is_initialized)
+    {
+        result = GST_FLOW_ERROR;
+        goto _exit;
+    }
 
-                gst_buffer_unmap(outbuf, &info2);
+    if (!gst_buffer_map(buf, &info, GST_MAP_READ))
+    {
+        result = GST_FLOW_ERROR;
+        goto _exit;
+    }
 
-                if (copy_error)
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
+    unmap_buf = TRUE;
 
-                GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
+    if (!base->is_hls)
+    {
+        if (av_new_packet(&decoder->packet, info.size) != 0)
+        {
+            result = GST_FLOW_ERROR;
+            goto _exit;
+        }
+        memcpy(decoder->packet.data, info.data, info.size);
+    }
+    else
+    {
+        av_init_packet(&decoder->packet);
+        decoder->packet.data = info.data;
+        decoder->packet.size = info.size;
+    }
 
-                if (decoder->discont || GST_BUFFER_IS_DISCONT(buf))
-                {
-#ifdef DEBUG_OUTPUT
-                    g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
-#endif
-                    GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
-                    decoder->discont = FALSE;
-                }
+    if (GST_BUFFER_TIMESTAMP_IS_VALID(buf))
+        base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
+    else
+        base->context->reordered_opaque = AV_NOPTS_VALUE;
 
+    result = videodecoder_decode_packet(decoder, &decoder->packet,
+                                        GST_BUFFER_DURATION(buf), GST_BUFFER_IS_DISCONT(buf));
 
-#ifdef VERBOSE_DEBUG
-                g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
-#endif
-                result = gst_pad_push(base->srcpad, outbuf);
-#ifdef VERBOSE_DEBUG
-                g_print(" done, res=%s\n", gst_flow_get_name(result));
+    if (!base->is_hls)
+    {
+#if PACKET_UNREF
+        av_packet_unref(&decoder->packet);
+#else
+        av_free_packet(&decoder->packet);
 #endif
-            }
-        }
     }
 
 _exit:
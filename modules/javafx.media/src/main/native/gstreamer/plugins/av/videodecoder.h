@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -73,6 +73,7 @@ struct _VideoDecoder {
     gboolean     discont;
 
     unsigned int frame_size;     // in bytes
+    unsigned int y_offset;
     unsigned int u_offset;
     unsigned int v_offset;
     unsigned int uv_blocksize;
@@ -81,6 +82,16 @@ struct _VideoDecoder {
 
     gint         codec_id;
 
+    gint         thread_count;        // 0 lets libavcodec pick one per CPU
+    gint         thread_type;         // FF_THREAD_FRAME and/or FF_THREAD_SLICE
+    gboolean     direct_rendering;    // decode into pooled output buffers if possible
+    gboolean     is_direct_rendering; // direct rendering is active for the open codec
+    gboolean     direct_frames;       // current caps describe a pooled buffer layout
+
+    GMutex         pool_lock;         // get_buffer2() runs on the decoding threads
+    GstBufferPool *pool;
+    guint          pool_size;
+
 #if HEVC_SUPPORT
     struct SwsContext *sws_context;
     AVFrame           *dest_frame;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -34,6 +34,13 @@ GST_DEBUG_CATEGORY (java_source_debug);
 
 #define MAX_READ_SIZE 65536
 
+// In push mode Java reads straight into a ring of native memory that is shared as a
+// direct ByteBuffer, and the blocks are pushed without copying. Block sizes start at
+// MAX_READ_SIZE and follow how much the source delivers per read.
+#define BLOCK_RING_SIZE (4 * 1024 * 1024)
+#define MIN_BLOCK_SIZE  (16 * 1024)
+#define MAX_BLOCK_SIZE  (1024 * 1024)
+
 /***********************************************************************************
 * HLS Properties and Values
 ***********************************************************************************/
@@ -52,6 +59,9 @@ enum
     SIGNAL_READ_NEXT_BLOCK,
     SIGNAL_READ_BLOCK,
     SIGNAL_COPY_BLOCK,
+    SIGNAL_SET_BLOCK_BUFFER,
+    SIGNAL_READ_NEXT_BLOCK_AT,
+    SIGNAL_READ_BLOCK_INTO,
     SIGNAL_CLOSE_CONNECTION,
     SIGNAL_PROPERTY,
     LAST_SIGNAL
@@ -79,6 +89,31 @@ enum
     MODE_HLS_LIVE = 0x04
 };
 
+/***********************************************************************************
+* Block ring
+***********************************************************************************/
+typedef struct _BlockRing BlockRing;
+typedef struct _RingBlock RingBlock;
+
+struct _BlockRing
+{
+    volatile gint refcount;
+    GMutex        lock;
+    guint8        *data;
+    gsize         size;
+    gsize         head;   // End of the newest block
+    gsize         tail;   // Start of the oldest block still in use
+    GQueue        blocks; // Blocks in use, oldest first
+};
+
+struct _RingBlock
+{
+    BlockRing     *ring;
+    gsize         offset;
+    gsize         size;
+    gboolean      released;
+};
+
 /***********************************************************************************
 * Element structures are hidden from outside
 ***********************************************************************************/
@@ -106,6 +141,11 @@ struct _JavaSource
     gchar*        location; // property controlled
     gchar*        mimetype; // property controlled
     gdouble       rate;
+
+    BlockRing     *ring;
+    gboolean      try_ring;
+    gboolean      read_into; // read-block-into is connected
+    gint          block_size;
 };
 
 struct _JavaSourceClass
@@ -264,6 +304,39 @@ static void java_source_class_init (JavaSourceClass *klass)
         2,     /* n_params */
         G_TYPE_POINTER, G_TYPE_INT);
 
+    klass->signals[SIGNAL_SET_BLOCK_BUFFER] = g_signal_new ("set-block-buffer",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_BOOLEAN__POINTER_INT,
+        G_TYPE_BOOLEAN, /* return_type */
+        2,     /* n_params */
+        G_TYPE_POINTER, G_TYPE_INT);
+
+    klass->signals[SIGNAL_READ_NEXT_BLOCK_AT] = g_signal_new ("read-next-block-at",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_INT__INT_INT,
+        G_TYPE_INT, /* return_type */
+        2,     /* n_params */
+        G_TYPE_INT, G_TYPE_INT);
+
+    klass->signals[SIGNAL_READ_BLOCK_INTO] = g_signal_new ("read-block-into",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_INT__UINT64_POINTER_UINT,
+        G_TYPE_INT, /* return_type */
+        3,     /* n_params */
+        G_TYPE_UINT64, G_TYPE_POINTER, G_TYPE_UINT);
+
     klass->signals[SIGNAL_CLOSE_CONNECTION] = g_signal_new ("close-connection",
         G_TYPE_FROM_CLASS (klass),
         G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
@@ -306,6 +379,145 @@ static void java_source_init(JavaSource *element)
     element->rate = 1.0; // Default to 1.0
 
     element->mimetype = NULL;
+
+    element->ring = NULL;
+    element->try_ring = FALSE;
+    element->read_into = FALSE;
+    element->block_size = MAX_READ_SIZE;
+}
+
+/***********************************************************************************
+* Block ring. Buffers pushed downstream keep their block, and the ring, alive until
+* they are freed. Space is reclaimed from the oldest block, so a block freed out of
+* order waits for the ones before it.
+***********************************************************************************/
+static BlockRing* block_ring_new(gsize size)
+{
+    BlockRing *ring = g_new0(BlockRing, 1);
+
+    ring->data = (guint8*)g_try_malloc(size);
+    if (ring->data == NULL)
+    {
+        g_free(ring);
+        return NULL;
+    }
+
+    ring->refcount = 1;
+    g_mutex_init(&ring->lock);
+    ring->size = size;
+    g_queue_init(&ring->blocks);
+
+    return ring;
+}
+
+static void block_ring_unref(BlockRing *ring)
+{
+    if (g_atomic_int_dec_and_test(&ring->refcount))
+    {
+        g_mutex_clear(&ring->lock);
+        g_free(ring->data);
+        g_free(ring);
+    }
+}
+
+/**
+ * block_ring_reserve()
+ *
+ * Reserves size contiguous bytes, or returns NULL if the ring has no room left.
+ */
+static RingBlock* block_ring_reserve(BlockRing *ring, gsize size)
+{
+    RingBlock *block = NULL;
+    gsize offset = 0;
+    gboolean fits = FALSE;
+
+    g_mutex_lock(&ring->lock);
+
+    if (g_queue_is_empty(&ring->blocks))
+    {
+        fits = (size <= ring->size);
+    }
+    else if (ring->head > ring->tail)
+    {
+        if (ring->size - ring->head >= size)
+        {
+            offset = ring->head;
+            fits = TRUE;
+        }
+        else
+        {
+            // Wrap around, the rest of the ring is skipped until the tail passes it.
+            fits = (ring->tail >= size);
+        }
+    }
+    else if (ring->head < ring->tail)
+    {
+        offset = ring->head;
+        fits = (ring->tail - ring->head >= size);
+    }
+
+    if (fits)
+    {
+        block = g_new(RingBlock, 1);
+        block->ring = ring;
+        block->offset = offset;
+        block->size = size;
+        block->released = FALSE;
+
+        if (g_queue_is_empty(&ring->blocks))
+            ring->tail = offset;
+        ring->head = offset + size;
+        g_queue_push_tail(&ring->blocks, block);
+        g_atomic_int_inc(&ring->refcount);
+    }
+
+    g_mutex_unlock(&ring->lock);
+
+    return block;
+}
+
+/**
+ * block_ring_commit()
+ *
+ * Shrinks the newest block to the amount of data actually read into it.
+ */
+static void block_ring_commit(RingBlock *block, gsize size)
+{
+    BlockRing *ring = block->ring;
+
+    g_mutex_lock(&ring->lock);
+    block->size = size;
+    ring->head = block->offset + size;
+    g_mutex_unlock(&ring->lock);
+}
+
+/**
+ * block_ring_release()
+ *
+ * Destroy notify of the buffers wrapping a block. May be called from any thread.
+ */
+static void block_ring_release(gpointer data)
+{
+    RingBlock *block = (RingBlock*)data;
+    BlockRing *ring = block->ring;
+
+    g_mutex_lock(&ring->lock);
+
+    block->released = TRUE;
+    while ((block = (RingBlock*)g_queue_peek_head(&ring->blocks)) != NULL && block->released)
+    {
+        g_queue_pop_head(&ring->blocks);
+        g_free(block);
+    }
+
+    if (block != NULL)
+        ring->tail = block->offset;
+    else
+        ring->head = ring->tail = 0;
+
+    g_mutex_unlock(&ring->lock);
+
+    block_ring_unref(ring);
 }
 
 /***********************************************************************************
@@ -366,6 +578,8 @@ static void java_source_finalize (GObject *object)
     g_free(element->location);
     if (element->mimetype)
         g_free(element->mimetype);
+    if (element->ring)
+        block_ring_unref(element->ring);
     G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -526,6 +740,123 @@ static gboolean java_source_event(GstPad *pad, GstObject *parent, GstEvent *even
     return gst_pad_event_default(pad, parent, event);
 }
 
+/***********************************************************************************
+* Block reading
+***********************************************************************************/
+/**
+ * java_source_attach_ring()
+ *
+ * Shares the block ring with Java on first use. Returns FALSE if the callbacks can't
+ * read into native memory, in which case blocks are copied out of Java as before.
+ */
+static gboolean java_source_attach_ring(JavaSource *element)
+{
+    gboolean attached = FALSE;
+
+    if (element->ring)
+        return TRUE;
+
+    if (!element->try_ring)
+        return FALSE;
+
+    element->try_ring = FALSE;
+
+    element->ring = block_ring_new(BLOCK_RING_SIZE);
+    if (element->ring == NULL)
+        return FALSE;
+
+    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_SET_BLOCK_BUFFER], 0,
+        element->ring->data, (gint)element->ring->size, &attached);
+    if (!attached)
+    {
+        block_ring_unref(element->ring);
+        element->ring = NULL;
+    }
+
+    return attached;
+}
+
+static void java_source_detach_ring(JavaSource *element)
+{
+    gboolean attached = FALSE;
+
+    if (element->ring)
+    {
+        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_SET_BLOCK_BUFFER], 0,
+            NULL, 0, &attached);
+        block_ring_unref(element->ring);
+        element->ring = NULL;
+    }
+}
+
+/**
+ * java_source_read_next_block()
+ *
+ * Reads the next block in push mode. *size is set as returned by Java, and *buffer is
+ * set if there is data.
+ */
+static GstFlowReturn java_source_read_next_block(JavaSource *element, GstBuffer **buffer, gint *size)
+{
+    GstMapInfo info;
+
+    *buffer = NULL;
+    *size = 0;
+
+    if (java_source_attach_ring(element))
+    {
+        RingBlock *block = block_ring_reserve(element->ring, element->block_size);
+        if (block)
+        {
+            gint requested = element->block_size;
+
+            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK_AT], 0,
+                (gint)block->offset, requested, size);
+            if (*size > 0 && *size <= requested)
+            {
+                block_ring_commit(block, *size);
+                *buffer = gst_buffer_new_wrapped_full(0, element->ring->data + block->offset, *size,
+                    0, *size, block, block_ring_release);
+
+                // Grow while the source fills whole blocks, shrink when it delivers much less,
+                // so that short reads do not hold up large parts of the ring.
+                if (*size == requested)
+                    element->block_size = MIN(requested * 2, MAX_BLOCK_SIZE);
+                else if (*size < requested / 4)
+                    element->block_size = MAX(requested / 2, MIN_BLOCK_SIZE);
+            }
+            else
+            {
+                block_ring_release(block);
+            }
+
+            return GST_FLOW_OK;
+        }
+
+        // The ring is taken by buffers still held downstream, copy this block instead.
+    }
+
+    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, size);
+    if (*size > 0)
+    {
+        *buffer = gst_buffer_new_allocate(NULL, *size, NULL);
+        if (*buffer)
+        {
+            if (!gst_buffer_map(*buffer, &info, GST_MAP_WRITE))
+            {
+                gst_buffer_unref(*buffer);
+                *buffer = NULL;
+                return GST_FLOW_ERROR;
+            }
+
+            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, *size);
+
+            gst_buffer_unmap(*buffer, &info);
+        }
+    }
+
+    return GST_FLOW_OK;
+}
+
 /***********************************************************************************
 * source pad loop
 ***********************************************************************************/
@@ -626,25 +957,17 @@ next_event:
         case GST_EVENT_UNKNOWN: // Pushing buffers
             {
                 gint     size;
-                GstMapInfo info;
-                g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
+                GstBuffer *buffer = NULL;
+                result = java_source_read_next_block(element, &buffer, &size);
+                if (result != GST_FLOW_OK)
+                    break;
+
                 if (size > 0)
                 {
-                    GstBuffer *buffer = gst_buffer_new_allocate(NULL, size, NULL);
                     if (buffer)
                     {
                         GST_BUFFER_OFFSET(buffer) = element->position;
 
-                        if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
-                        {
-                            result = GST_FLOW_ERROR;
-                            break;
-                        }
-
-                        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
-
-                        gst_buffer_unmap(buffer, &info);
-
                         if (element->discont)
                         {
                             buffer = gst_buffer_make_writable (buffer);
@@ -814,9 +1137,40 @@ static GstFlowReturn java_source_getrange(GstPad *pad, GstObject *parent, guint6
     guint    read = 0;
     guint    toRead = 0;
     GstMapInfo info;
+    GstBuffer *buf = NULL;
+
+    if (element->read_into)
+    {
+        // Java reads the whole range straight into the buffer.
+        buf = gst_buffer_new_allocate(NULL, length, NULL);
+        if (buf == NULL)
+            return GST_FLOW_ERROR;
+
+        if (!gst_buffer_map(buf, &info, GST_MAP_WRITE))
+        {
+            gst_buffer_unref(buf);
+            return GST_FLOW_ERROR;
+        }
+
+        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_BLOCK_INTO], 0, offset, info.data, length, &size);
+        gst_buffer_unmap(buf, &info);
+
+        if (size > 0 && (guint)size <= length)
+        {
+            if ((guint)size < length)
+                gst_buffer_set_size(buf, size);
+            GST_BUFFER_OFFSET(buf) = offset;
+            *buffer = buf;
+            return GST_FLOW_OK;
+        }
+
+        gst_buffer_unref(buf);
+        // EOS on 0 as well, see below.
+        return (size == EOS_CODE || size == 0) ? GST_FLOW_EOS : GST_FLOW_ERROR;
+    }
 
     // Do not read from Java more then MAX_READ_SIZE, so we do not allocate very large objects in Java
-    GstBuffer *buf = gst_buffer_new_allocate(NULL, length, NULL);
+    buf = gst_buffer_new_allocate(NULL, length, NULL);
     if (buf == NULL)
         return GST_FLOW_ERROR;
 
@@ -890,6 +1244,10 @@ static GstStateChangeReturn java_source_change_state (GstElement *e,
                 element->update = FALSE;
             else
                 element->update = TRUE;
+            element->try_ring = TRUE;
+            element->block_size = MAX_READ_SIZE;
+            element->read_into = g_signal_has_handler_pending(element,
+                JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_BLOCK_INTO], 0, FALSE);
             GST_PAD_STREAM_UNLOCK(element->srcpad);
 
             g_mutex_lock(&element->lock);
@@ -928,6 +1286,7 @@ static GstStateChangeReturn java_source_change_state (GstElement *e,
         if (!element->stop_on_pause)
             element->srcresult = GST_FLOW_FLUSHING;
         element->size = -1;
+        java_source_detach_ring(element);
         g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_CLOSE_CONNECTION], 0);
         g_mutex_unlock(&element->lock);
         break;
@@ -46,6 +46,22 @@ extern void source_marshal_INT__INT_INT (GClosure     *closure,
                                          gpointer      invocation_hint,
                                          gpointer      marshal_data);
 
+/* BOOLEAN:POINTER,INT (marshal.in:17) */
+extern void source_marshal_BOOLEAN__POINTER_INT (GClosure     *closure,
+                                                 GValue       *return_value,
+                                                 guint         n_param_values,
+                                                 const GValue *param_values,
+                                                 gpointer      invocation_hint,
+                                                 gpointer      marshal_data);
+
+/* INT:UINT64,POINTER,UINT (marshal.in:20) */
+extern void source_marshal_INT__UINT64_POINTER_UINT (GClosure     *closure,
+                                                     GValue       *return_value,
+                                                     guint         n_param_values,
+                                                     const GValue *param_values,
+                                                     gpointer      invocation_hint,
+                                                     gpointer      marshal_data);
+
 G_END_DECLS
 
 #endif /* __source_marshal_MARSHAL_H__ */
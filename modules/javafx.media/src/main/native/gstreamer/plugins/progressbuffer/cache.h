@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,6 +28,9 @@
 
 #include <gst/gst.h>
 
+/* Positions are offsets in the stream. Implementations may keep data from
+ * more than one region of the stream, see cache_get_cached_end().
+ */
 typedef struct _Cache Cache;
 
 void      cache_static_init(void); // Must be called only once from the ProgressBuffer class initializer
@@ -35,10 +38,13 @@ void      cache_static_init(void); // Must be called only once from the Progress
 Cache*    create_cache();
 void      destroy_cache(Cache* instance);
 
+// Discards all cached data and rewinds the read and write positions.
+void      cache_reset(Cache* cache);
+
 // Writes a buffer.
 void           cache_write_buffer(Cache* cache, GstBuffer* buffer);
 
-/* Reads a buffer of the fixed size from the current read position.
+/* Reads a buffer of at most a fixed size from the current read position.
  * Returns the read position after the operation has been made.
  * buffer parameter contains the target buffer with offset and size values set
  * This method is used in push mode.
@@ -60,4 +66,9 @@ gboolean       cache_set_read_position(Cache* cache, gint64 position);
 // Returns true if the cache has enough data for fluent reading, but we can't expect more than total.
 gboolean       cache_has_enough_data(Cache* cache);
 
+/* Returns the end of the data cached contiguously from the specified
+ * position, or the position itself if there is no data there.
+ */
+gint64         cache_get_cached_end(Cache* cache, gint64 position);
+
 #endif // __CACHE_H__
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,7 @@
 
 #include "hlsprogressbuffer.h"
 #include "cache.h"
+#include <math.h>
 
 /***********************************************************************************
  * Debug category init
@@ -37,7 +38,38 @@ GST_DEBUG_CATEGORY (hls_progress_buffer_debug);
 /***********************************************************************************
  * Element structures are hidden from outside
  ***********************************************************************************/
-#define NUM_OF_CACHED_SEGMENTS 3
+#define MAX_CACHED_SEGMENTS      16
+#define DEFAULT_MIN_SEGMENTS     3
+#define DEFAULT_MAX_SEGMENTS     8
+#define DEFAULT_PREFETCH_TIME    10.0
+#define DEFAULT_MEMORY_BUDGET    (32 * 1024 * 1024)
+
+// Weight of the newest sample in the download speed averages.
+#define RATIO_SMOOTHING          0.25
+// Segments arriving faster than this fraction of real time need no extra depth.
+#define MAX_DOWNLOAD_RATIO       0.95
+
+enum
+{
+    PROP_0,
+    PROP_MIN_SEGMENTS,
+    PROP_MAX_SEGMENTS,
+    PROP_PREFETCH_TIME,
+    PROP_MEMORY_CACHE,
+    PROP_MEMORY_BUDGET,
+    PROP_BANDWIDTH
+};
+
+typedef struct _HLSSegment
+{
+    Cache*        cache;         // Backing file, created on first use in file mode.
+    GQueue        buffers;       // Received buffers, in memory mode.
+    guint         size;          // Segment size in bytes, as announced by javasource.
+    guint64       written;
+    guint64       read_position;
+    gboolean      write_ready;
+    gboolean      discont;
+} HLSSegment;
 
 struct _HLSProgressBuffer
 {
@@ -50,12 +82,29 @@ struct _HLSProgressBuffer
     GCond         add_cond;
     GCond         del_cond;
 
-    Cache*        cache[NUM_OF_CACHED_SEGMENTS];
-    guint         cache_size[NUM_OF_CACHED_SEGMENTS];
-    gboolean      cache_write_ready[NUM_OF_CACHED_SEGMENTS];
-    gboolean      cache_discont[NUM_OF_CACHED_SEGMENTS];
+    HLSSegment    segments[MAX_CACHED_SEGMENTS];
     gint          cache_write_index;
     gint          cache_read_index;
+    guint         segments_in_use;
+
+    // Prefetch depth, adapted to the download speed within [min_segments, max_segments].
+    guint         depth;
+    guint         min_segments;
+    guint         max_segments;
+    gdouble       prefetch_time;
+
+    gboolean      memory_cache;
+    gboolean      use_memory;
+    guint         memory_budget;
+    guint64       memory_used;
+
+    // Start of the segment being written and smoothed download statistics.
+    gint64        segment_start_us;
+    GstClockTime  segment_start_time;
+    gdouble       bandwidth;
+    gdouble       download_ratio;
+    gdouble       download_ratio_dev;
+    gdouble       segment_duration;
 
     gboolean      send_new_segment;
     gboolean      set_src_caps;
@@ -118,6 +167,8 @@ static GstStaticPadTemplate source_template = GST_STATIC_PAD_TEMPLATE ("src",
 /***********************************************************************************
  * Instance init and forward declarations
  ***********************************************************************************/
+static void                 hls_progress_buffer_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+static void                 hls_progress_buffer_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static void                 hls_progress_buffer_finalize (GObject *object);
 static GstStateChangeReturn hls_progress_buffer_change_state (GstElement *element, GstStateChange transition);
 static GstFlowReturn        hls_progress_buffer_chain(GstPad *pad, GstObject *parent, GstBuffer *data);
@@ -148,9 +199,63 @@ static void hls_progress_buffer_class_init (HLSProgressBufferClass *klass)
     gst_element_class_add_pad_template (element_class,
         gst_static_pad_template_get (&source_template));
 
+    gobject_class->set_property = hls_progress_buffer_set_property;
+    gobject_class->get_property = hls_progress_buffer_get_property;
     gobject_class->finalize = hls_progress_buffer_finalize;
     GST_ELEMENT_CLASS (klass)->change_state = hls_progress_buffer_change_state;
 
+    g_object_class_install_property (gobject_class, PROP_MIN_SEGMENTS,
+                                     g_param_spec_uint ("min-segments",
+                                                        "Minimum segments",
+                                                        "Minimum number of segments buffered ahead of playback.",
+                                                        1  /* minimum value */,
+                                                        MAX_CACHED_SEGMENTS /* maximum value */,
+                                                        DEFAULT_MIN_SEGMENTS  /* default value */,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+    g_object_class_install_property (gobject_class, PROP_MAX_SEGMENTS,
+                                     g_param_spec_uint ("max-segments",
+                                                        "Maximum segments",
+                                                        "Maximum number of segments buffered ahead of playback on slow or bursty networks.",
+                                                        1  /* minimum value */,
+                                                        MAX_CACHED_SEGMENTS /* maximum value */,
+                                                        DEFAULT_MAX_SEGMENTS  /* default value */,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+    g_object_class_install_property (gobject_class, PROP_PREFETCH_TIME,
+                                     g_param_spec_double ("prefetch-time",
+                                                          "Prefetch time",
+                                                          "Media time in seconds to buffer ahead of playback, within max-segments.",
+                                                          0.0  /* minimum value */,
+                                                          300.0 /* maximum value */,
+                                                          DEFAULT_PREFETCH_TIME  /* default value */,
+                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+    g_object_class_install_property (gobject_class, PROP_MEMORY_CACHE,
+                                     g_param_spec_boolean ("memory-cache",
+                                                           "Memory cache",
+                                                           "Keep segments in memory instead of temporary files. Takes effect on the next READY to PAUSED transition.",
+                                                           FALSE  /* default value */,
+                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+    g_object_class_install_property (gobject_class, PROP_MEMORY_BUDGET,
+                                     g_param_spec_uint ("memory-budget",
+                                                        "Memory budget",
+                                                        "Maximum number of bytes held in memory cache mode.",
+                                                        64 * 1024  /* minimum value */,
+                                                        G_MAXUINT /* maximum value */,
+                                                        DEFAULT_MEMORY_BUDGET  /* default value */,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+    g_object_class_install_property (gobject_class, PROP_BANDWIDTH,
+                                     g_param_spec_double ("bandwidth",
+                                                          "Network bandwidth",
+                                                          "Network bandwidth in bytes/second",
+                                                          0.0  /* minimum value */,
+                                                          G_MAXDOUBLE /* maximum value */,
+                                                          0.0  /* default value */,
+                                                          G_PARAM_READABLE));
+
     cache_static_init();
 }
 
@@ -175,16 +280,31 @@ static void hls_progress_buffer_init(HLSProgressBuffer *element)
     g_cond_init(&element->add_cond);
     g_cond_init(&element->del_cond);
 
-    for (int i = 0; i < NUM_OF_CACHED_SEGMENTS; i++)
+    for (int i = 0; i < MAX_CACHED_SEGMENTS; i++)
     {
-        element->cache[i] = create_cache();
-        element->cache_size[i] = 0;
-        element->cache_write_ready[i] = TRUE;
-        element->cache_discont[i] = FALSE;
+        element->segments[i].cache = NULL;
+        g_queue_init(&element->segments[i].buffers);
+        element->segments[i].size = 0;
+        element->segments[i].written = 0;
+        element->segments[i].read_position = 0;
+        element->segments[i].write_ready = TRUE;
+        element->segments[i].discont = FALSE;
     }
 
     element->cache_write_index = -1;
     element->cache_read_index = 0;
+    element->segments_in_use = 0;
+
+    element->depth = DEFAULT_MIN_SEGMENTS;
+    element->use_memory = FALSE;
+    element->memory_used = 0;
+
+    element->segment_start_us = -1;
+    element->segment_start_time = GST_CLOCK_TIME_NONE;
+    element->bandwidth = 0.0;
+    element->download_ratio = 0.0;
+    element->download_ratio_dev = 0.0;
+    element->segment_duration = 0.0;
 
     element->send_new_segment = TRUE;
     element->set_src_caps = TRUE;
@@ -197,6 +317,80 @@ static void hls_progress_buffer_init(HLSProgressBuffer *element)
     element->buffer_pts = GST_CLOCK_TIME_NONE;
 }
 
+/**
+ * hls_progress_buffer_set_property()
+ *
+ * Function to set properties on the element.
+ */
+static void hls_progress_buffer_set_property (GObject *object, guint property_id,
+                                              const GValue *value, GParamSpec *pspec)
+{
+    HLSProgressBuffer *element = HLS_PROGRESS_BUFFER(object);
+
+    g_mutex_lock(&element->lock);
+    switch (property_id)
+    {
+        case PROP_MIN_SEGMENTS:
+            element->min_segments = g_value_get_uint(value);
+            break;
+        case PROP_MAX_SEGMENTS:
+            element->max_segments = g_value_get_uint(value);
+            break;
+        case PROP_PREFETCH_TIME:
+            element->prefetch_time = g_value_get_double(value);
+            break;
+        case PROP_MEMORY_CACHE:
+            element->memory_cache = g_value_get_boolean(value);
+            break;
+        case PROP_MEMORY_BUDGET:
+            element->memory_budget = g_value_get_uint(value);
+            g_cond_signal(&element->del_cond);
+            break;
+
+        default:
+            break;
+    }
+    g_mutex_unlock(&element->lock);
+}
+
+/**
+ * hls_progress_buffer_get_property()
+ *
+ * Function to get properties from the element.
+ */
+static void hls_progress_buffer_get_property (GObject *object, guint property_id,
+                                              GValue *value, GParamSpec *pspec)
+{
+    HLSProgressBuffer *element = HLS_PROGRESS_BUFFER(object);
+
+    g_mutex_lock(&element->lock);
+    switch (property_id)
+    {
+        case PROP_MIN_SEGMENTS:
+            g_value_set_uint(value, element->min_segments);
+            break;
+        case PROP_MAX_SEGMENTS:
+            g_value_set_uint(value, element->max_segments);
+            break;
+        case PROP_PREFETCH_TIME:
+            g_value_set_double(value, element->prefetch_time);
+            break;
+        case PROP_MEMORY_CACHE:
+            g_value_set_boolean(value, element->memory_cache);
+            break;
+        case PROP_MEMORY_BUDGET:
+            g_value_set_uint(value, element->memory_budget);
+            break;
+        case PROP_BANDWIDTH:
+            g_value_set_double(value, element->bandwidth);
+            break;
+
+        default:
+            break;
+    }
+    g_mutex_unlock(&element->lock);
+}
+
 /**
  * hls_progress_buffer_finalize()
  *
@@ -207,10 +401,12 @@ static void hls_progress_buffer_finalize (GObject *object)
     HLSProgressBuffer *element = HLS_PROGRESS_BUFFER(object);
     int i = 0;
 
-    for (i = 0; i < NUM_OF_CACHED_SEGMENTS; i++)
+    for (i = 0; i < MAX_CACHED_SEGMENTS; i++)
     {
-        if (element->cache[i])
-            destroy_cache(element->cache[i]);
+        g_queue_foreach(&element->segments[i].buffers, (GFunc)gst_buffer_unref, NULL);
+        g_queue_clear(&element->segments[i].buffers);
+        if (element->segments[i].cache)
+            destroy_cache(element->segments[i].cache);
     }
 
     g_mutex_clear(&element->lock);
@@ -272,6 +468,149 @@ static gboolean hls_progress_buffer_activatepush_src(GstPad *pad, GstObject *par
 /***********************************************************************************
  * Internal functions
  ***********************************************************************************/
+/**
+ * hls_segment_clear()
+ *
+ * Drops the data of a segment. Must be called with the lock held.
+ */
+static void hls_segment_clear(HLSProgressBuffer *element, HLSSegment *segment)
+{
+    GstBuffer *buffer = NULL;
+
+    while ((buffer = (GstBuffer*)g_queue_pop_head(&segment->buffers)) != NULL)
+    {
+        element->memory_used -= gst_buffer_get_size(buffer);
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(buffer);
+    }
+
+    if (segment->cache)
+        cache_reset(segment->cache);
+
+    segment->written = 0;
+    segment->read_position = 0;
+    segment->discont = FALSE;
+}
+
+/**
+ * hls_segment_has_data()
+ *
+ * Returns TRUE if a segment has data to be read. Must be called with the lock held.
+ */
+static gboolean hls_segment_has_data(HLSProgressBuffer *element, HLSSegment *segment)
+{
+    if (element->use_memory)
+        return !g_queue_is_empty(&segment->buffers);
+
+    return segment->cache != NULL && cache_has_enough_data(segment->cache);
+}
+
+/**
+ * hls_segment_read()
+ *
+ * Takes the next buffer of a segment and advances its read position. Must be called
+ * with the lock held.
+ */
+static GstBuffer* hls_segment_read(HLSProgressBuffer *element, HLSSegment *segment)
+{
+    GstBuffer *buffer = NULL;
+
+    if (element->use_memory)
+    {
+        // Memory segments queue the upstream buffers themselves, so nothing is copied.
+        buffer = (GstBuffer*)g_queue_pop_head(&segment->buffers);
+        element->memory_used -= gst_buffer_get_size(buffer);
+        segment->read_position += gst_buffer_get_size(buffer);
+    }
+    else
+    {
+        segment->read_position = cache_read_buffer(segment->cache, &buffer);
+    }
+
+    return buffer;
+}
+
+/**
+ * hls_progress_buffer_update_depth()
+ *
+ * Called when the next segment starts. Measures how long the previous segment took to
+ * download relative to its duration and picks how many segments to prefetch. Must be
+ * called with the lock held.
+ */
+static void hls_progress_buffer_update_depth(HLSProgressBuffer *element, const GstSegment *segment)
+{
+    HLSSegment *previous = NULL;
+    gdouble elapsed = 0.0;
+    gdouble duration = 0.0;
+    gdouble ratio = 0.0;
+    guint depth = 0;
+
+    if (element->segment_start_us < 0 || element->cache_write_index < 0)
+        return;
+
+    previous = &element->segments[element->cache_write_index];
+    elapsed = (gdouble)(g_get_monotonic_time() - element->segment_start_us) / G_USEC_PER_SEC;
+    if (elapsed <= 0.0 || previous->written == 0)
+        return;
+
+    element->bandwidth = previous->written / elapsed;
+
+    // Segment start times tell the duration only for consecutive segments.
+    if (!GST_CLOCK_TIME_IS_VALID(element->segment_start_time) || segment->start <= element->segment_start_time)
+        return;
+
+    duration = (gdouble)(segment->start - element->segment_start_time) / GST_SECOND;
+    ratio = elapsed / duration;
+
+    if (element->segment_duration == 0.0)
+    {
+        element->download_ratio = ratio;
+        element->download_ratio_dev = 0.0;
+        element->segment_duration = duration;
+    }
+    else
+    {
+        element->download_ratio_dev += RATIO_SMOOTHING * (fabs(ratio - element->download_ratio) - element->download_ratio_dev);
+        element->download_ratio += RATIO_SMOOTHING * (ratio - element->download_ratio);
+        element->segment_duration += RATIO_SMOOTHING * (duration - element->segment_duration);
+    }
+
+    // The closer downloads get to real time, or the more they vary, the less slack there
+    // is to ride out a slow segment, so more of them are kept ahead of playback. Short
+    // segments need more of them to cover the same prefetch time.
+    ratio = MIN(element->download_ratio + 2.0 * element->download_ratio_dev, MAX_DOWNLOAD_RATIO);
+    depth = (guint)ceil(element->min_segments / (1.0 - ratio));
+    depth = MAX(depth, (guint)ceil(element->prefetch_time / element->segment_duration));
+    element->depth = CLAMP(depth, element->min_segments, MAX(element->min_segments, element->max_segments));
+}
+
+/**
+ * hls_progress_buffer_message()
+ *
+ * Creates an HLS message carrying buffer health statistics. Must be called with the lock held.
+ */
+static GstMessage* hls_progress_buffer_message(HLSProgressBuffer *element, const gchar *name)
+{
+    guint64 buffered = 0;
+    GstStructure *s = NULL;
+    int i = 0;
+
+    for (i = 0; i < MAX_CACHED_SEGMENTS; i++)
+    {
+        if (!element->segments[i].write_ready)
+            buffered += element->segments[i].written - element->segments[i].read_position;
+    }
+
+    s = gst_structure_new(name,
+                          HLS_PB_FIELD_SEGMENTS, G_TYPE_UINT, element->segments_in_use,
+                          HLS_PB_FIELD_DEPTH, G_TYPE_UINT, element->depth,
+                          HLS_PB_FIELD_BUFFERED_BYTES, G_TYPE_UINT64, buffered,
+                          HLS_PB_FIELD_BANDWIDTH, G_TYPE_DOUBLE, element->bandwidth,
+                          HLS_PB_FIELD_DOWNLOAD_RATIO, G_TYPE_DOUBLE, element->download_ratio,
+                          NULL);
+    return gst_message_new_application(GST_OBJECT(element), s);
+}
+
 static void hls_progress_buffer_flush_data(HLSProgressBuffer *element)
 {
     guint i = 0;
@@ -285,17 +624,18 @@ static void hls_progress_buffer_flush_data(HLSProgressBuffer *element)
 
     element->cache_write_index = -1;
     element->cache_read_index = 0;
-    for (i = 0; i < NUM_OF_CACHED_SEGMENTS; i++)
+    element->segments_in_use = 0;
+    for (i = 0; i < MAX_CACHED_SEGMENTS; i++)
     {
-        if (element->cache[i])
-        {
-            cache_set_write_position(element->cache[i], 0);
-            cache_set_read_position(element->cache[i], 0);
-            element->cache_size[i] = 0;
-            element->cache_write_ready[i] = TRUE;
-        }
+        hls_segment_clear(element, &element->segments[i]);
+        element->segments[i].size = 0;
+        element->segments[i].write_ready = TRUE;
     }
 
+    // The next segment does not follow the last one, so it can't be timed against it.
+    element->segment_start_us = -1;
+    element->segment_start_time = GST_CLOCK_TIME_NONE;
+
     g_mutex_unlock(&element->lock);
 }
 
@@ -311,6 +651,8 @@ static GstFlowReturn hls_progress_buffer_chain(GstPad *pad, GstObject *parent, G
 {
     HLSProgressBuffer *element = HLS_PROGRESS_BUFFER(parent);
     GstFlowReturn  result = GST_FLOW_OK;
+    HLSSegment    *segment = NULL;
+    gsize          size = gst_buffer_get_size(data);
 
     if (element->is_flushing || element->is_eos)
     {
@@ -320,36 +662,72 @@ static GstFlowReturn hls_progress_buffer_chain(GstPad *pad, GstObject *parent, G
     }
 
     g_mutex_lock(&element->lock);
+
+    if (element->use_memory && element->srcresult == GST_FLOW_OK &&
+        element->memory_used > 0 && element->memory_used + size > element->memory_budget)
+    {
+        // Hold the download until playback frees enough of the budget. A buffer always
+        // fits when nothing else is queued.
+        GstMessage *msg = hls_progress_buffer_message(element, HLS_PB_MESSAGE_FULL);
+        gint64 wait_start_us = 0;
+        g_mutex_unlock(&element->lock);
+        gst_element_post_message(GST_ELEMENT(element), msg);
+        g_mutex_lock(&element->lock);
+
+        wait_start_us = g_get_monotonic_time();
+        while (element->srcresult == GST_FLOW_OK &&
+               element->memory_used > 0 && element->memory_used + size > element->memory_budget)
+        {
+            g_cond_wait(&element->del_cond, &element->lock);
+        }
+
+        // Time spent waiting for playback is not download time.
+        if (element->segment_start_us >= 0)
+            element->segment_start_us += g_get_monotonic_time() - wait_start_us;
+
+        if (element->srcresult == GST_FLOW_OK)
+        {
+            msg = hls_progress_buffer_message(element, HLS_PB_MESSAGE_NOT_FULL);
+            g_mutex_unlock(&element->lock);
+            gst_element_post_message(GST_ELEMENT(element), msg);
+            g_mutex_lock(&element->lock);
+        }
+    }
+
     if (element->srcresult != GST_FLOW_FLUSHING)
     {
+        segment = &element->segments[element->cache_write_index];
+
         if (GST_BUFFER_FLAG_IS_SET(data, GST_BUFFER_FLAG_DISCONT))
         {
-            element->cache_discont[element->cache_write_index] = TRUE;
+            segment->discont = TRUE;
         }
 
-        cache_write_buffer(element->cache[element->cache_write_index], data);
+        if (element->use_memory)
+        {
+            g_queue_push_tail(&segment->buffers, data);
+            element->memory_used += size;
+            data = NULL;
+        }
+        else if (segment->cache)
+        {
+            cache_write_buffer(segment->cache, data);
+        }
+        segment->written += size;
+
         g_cond_signal(&element->add_cond);
     }
     g_mutex_unlock(&element->lock);
 
-    // INLINE - gst_buffer_unref()
-    gst_buffer_unref(data);
+    if (data)
+    {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(data);
+    }
 
     return result;
 }
 
-/**
- * send_hls_resume_message
- *
- * Sends HLS RESUME message to the bus.
- */
-static void send_hls_resume_message(HLSProgressBuffer* element)
-{
-    GstStructure *s = gst_structure_new_empty(HLS_PB_MESSAGE_RESUME);
-    GstMessage *msg = gst_message_new_application(GST_OBJECT(element), s);
-    gst_element_post_message(GST_ELEMENT(element), msg);
-}
-
 /**
  * send_hls_eos_message
  *
@@ -362,30 +740,6 @@ static void send_hls_eos_message(HLSProgressBuffer* element)
     gst_element_post_message(GST_ELEMENT(element), msg);
 }
 
-/**
- * send_hls_full_message
- *
- * Sends HLS FULL message to the bus.
- */
-static void send_hls_full_message(HLSProgressBuffer* element)
-{
-    GstStructure *s = gst_structure_new_empty(HLS_PB_MESSAGE_FULL);
-    GstMessage *msg = gst_message_new_application(GST_OBJECT(element), s);
-    gst_element_post_message(GST_ELEMENT(element), msg);
-}
-
-/**
- * send_hls_not_full_message
- *
- * Sends HLS NOT FULL message to the bus.
- */
-static void send_hls_not_full_message(HLSProgressBuffer* element)
-{
-    GstStructure *s = gst_structure_new_empty(HLS_PB_MESSAGE_NOT_FULL);
-    GstMessage *msg = gst_message_new_application(GST_OBJECT(element), s);
-    gst_element_post_message(GST_ELEMENT(element), msg);
-}
-
 /**
  * hls_progress_buffer_loop()
  *
@@ -398,7 +752,7 @@ static void hls_progress_buffer_loop(void *data)
 
     g_mutex_lock(&element->lock);
 
-    while (element->srcresult == GST_FLOW_OK && !cache_has_enough_data(element->cache[element->cache_read_index]))
+    while (element->srcresult == GST_FLOW_OK && !hls_segment_has_data(element, &element->segments[element->cache_read_index]))
     {
         if (element->is_eos)
         {
@@ -417,21 +771,28 @@ static void hls_progress_buffer_loop(void *data)
 
     if (result == GST_FLOW_OK)
     {
-        GstBuffer *buffer = NULL;
-        guint64 read_position = cache_read_buffer(element->cache[element->cache_read_index], &buffer);
+        HLSSegment *segment = &element->segments[element->cache_read_index];
+        GstMessage *msg = NULL;
+        GstBuffer *buffer = hls_segment_read(element, segment);
 
-        if (element->cache_discont[element->cache_read_index])
+        if (segment->discont)
         {
             buffer = gst_buffer_make_writable(buffer);
             GST_BUFFER_FLAG_SET(buffer, GST_BUFFER_FLAG_DISCONT);
-            element->cache_discont[element->cache_read_index] = FALSE;
+            segment->discont = FALSE;
         }
 
-        if (read_position == element->cache_size[element->cache_read_index])
+        if (segment->read_position == segment->size)
         {
-            element->cache_write_ready[element->cache_read_index] = TRUE;
-            element->cache_read_index = (element->cache_read_index + 1) % NUM_OF_CACHED_SEGMENTS;
-            send_hls_not_full_message(element);
+            segment->write_ready = TRUE;
+            element->segments_in_use--;
+            element->cache_read_index = (element->cache_read_index + 1) % MAX_CACHED_SEGMENTS;
+            msg = hls_progress_buffer_message(element, HLS_PB_MESSAGE_NOT_FULL);
+            g_cond_signal(&element->del_cond);
+        }
+        else if (element->use_memory)
+        {
+            // Wake up a download waiting for the memory budget.
             g_cond_signal(&element->del_cond);
         }
 
@@ -444,6 +805,9 @@ static void hls_progress_buffer_loop(void *data)
 
         g_mutex_unlock(&element->lock);
 
+        if (msg)
+            gst_element_post_message(GST_ELEMENT(element), msg);
+
         // Send the data to the hls progressbuffer source pad
         result = gst_pad_push(element->srcpad, buffer);
 
@@ -479,6 +843,8 @@ static gboolean hls_progress_buffer_sink_event(GstPad *pad, GstObject *parent, G
     case GST_EVENT_SEGMENT:
         {
             GstSegment segment;
+            HLSSegment *next = NULL;
+            GstMessage *msg = NULL;
 
             g_mutex_lock(&element->lock);
             if (element->srcresult != GST_FLOW_OK)
@@ -525,28 +891,52 @@ static gboolean hls_progress_buffer_sink_event(GstPad *pad, GstObject *parent, G
 
             // Get and prepare next write segment
             g_mutex_lock(&element->lock);
-            element->cache_write_index = (element->cache_write_index + 1) % NUM_OF_CACHED_SEGMENTS;
+            hls_progress_buffer_update_depth(element, &segment);
+            element->cache_write_index = (element->cache_write_index + 1) % MAX_CACHED_SEGMENTS;
+            next = &element->segments[element->cache_write_index];
 
-            while (element->srcresult == GST_FLOW_OK && !element->cache_write_ready[element->cache_write_index])
+            if (element->srcresult == GST_FLOW_OK && (element->segments_in_use >= element->depth || !next->write_ready))
             {
+                msg = hls_progress_buffer_message(element, HLS_PB_MESSAGE_FULL);
                 g_mutex_unlock(&element->lock);
-                send_hls_full_message(element);
+                gst_element_post_message(GST_ELEMENT(element), msg);
                 g_mutex_lock(&element->lock);
-                g_cond_wait(&element->del_cond, &element->lock);
+
+                while (element->srcresult == GST_FLOW_OK && (element->segments_in_use >= element->depth || !next->write_ready))
+                    g_cond_wait(&element->del_cond, &element->lock);
+
                 if (element->srcresult != GST_FLOW_OK)
                 {
                     g_mutex_unlock(&element->lock);
                     return TRUE;
                 }
             }
-            element->cache_size[element->cache_write_index] = segment.stop;
-            element->cache_write_ready[element->cache_write_index] = FALSE;
-            cache_set_write_position(element->cache[element->cache_write_index], 0);
-            cache_set_read_position(element->cache[element->cache_write_index], 0);
 
+            if (!element->use_memory && !next->cache)
+            {
+                next->cache = create_cache();
+                if (!next->cache)
+                {
+                    g_mutex_unlock(&element->lock);
+                    gst_element_message_full(GST_ELEMENT(element), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_OPEN_READ_WRITE,
+                                             g_strdup("Couldn't create backing cache"), NULL,
+                                             ("hlsprogressbuffer.c"), ("hls_progress_buffer_sink_event"), 0);
+                    return FALSE;
+                }
+            }
+
+            hls_segment_clear(element, next);
+            next->size = segment.stop;
+            next->write_ready = FALSE;
+            element->segments_in_use++;
+
+            element->segment_start_us = g_get_monotonic_time();
+            element->segment_start_time = segment.start;
+
+            msg = hls_progress_buffer_message(element, HLS_PB_MESSAGE_RESUME);
             g_mutex_unlock(&element->lock);
 
-            send_hls_resume_message(element); // Send resume message for each segment
+            gst_element_post_message(GST_ELEMENT(element), msg); // Send resume message for each segment
         }
         break;
     case GST_EVENT_FLUSH_START:
@@ -606,6 +996,13 @@ static GstStateChangeReturn hls_progress_buffer_change_state (GstElement *e, Gst
 
     switch (transition)
     {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+        g_mutex_lock(&element->lock);
+        element->use_memory = element->memory_cache;
+        element->depth = element->min_segments;
+        g_mutex_unlock(&element->lock);
+        break;
+
     case GST_STATE_CHANGE_PAUSED_TO_READY:
         hls_progress_buffer_flush_data(element);
         break;
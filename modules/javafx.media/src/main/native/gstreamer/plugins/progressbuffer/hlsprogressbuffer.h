@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -36,6 +36,13 @@ G_BEGIN_DECLS
 #define HLS_PB_MESSAGE_FULL             "hls_pb_full"
 #define HLS_PB_MESSAGE_NOT_FULL         "hls_pb_not_full"
 
+// Buffer health fields of the RESUME, FULL and NOT_FULL messages
+#define HLS_PB_FIELD_SEGMENTS           "buffered-segments"
+#define HLS_PB_FIELD_DEPTH              "depth"
+#define HLS_PB_FIELD_BUFFERED_BYTES     "buffered-bytes"
+#define HLS_PB_FIELD_BANDWIDTH          "bandwidth"
+#define HLS_PB_FIELD_DOWNLOAD_RATIO     "download-ratio"
+
 #define HLS_PROGRESS_BUFFER_TYPE            (hls_progress_buffer_get_type())
 #define HLS_PROGRESS_BUFFER(obj)            (G_TYPE_CHECK_INSTANCE_CAST((obj), HLS_PROGRESS_BUFFER_TYPE, HLSProgressBuffer))
 #define HLS_PROGRESS_BUFFER_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass), HLS_PROGRESS_BUFFER_TYPE, HLSProgressBufferClass))
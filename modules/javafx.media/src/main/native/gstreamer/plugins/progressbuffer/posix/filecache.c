@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,107 +26,269 @@
 #include <cache.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 
-#define DEFAULT_BUFFER_SIZE 4096
+// Largest buffer handed out in push mode.
+#define MAX_READ_SIZE (64 * 1024)
+
+// Size of the file regions mapped at once.
+#define WINDOW_SIZE (8 * 1024 * 1024)
+
 static const char *tempDir = NULL;
+static gint64 pageSize = 4096;
+
+/*
+ * The backing file is indexed by stream offset, so data downloaded before
+ * a source seek stays where it is and can be served again. Buffers are
+ * handed out as read-only views of mapped windows of the file; each window
+ * is unmapped once the cache and every buffer using it are done with it.
+ */
+typedef struct _CacheRange
+{
+    gint64  start;
+    gint64  stop;
+} CacheRange;
+
+typedef struct _CacheWindow
+{
+    gint    ref_count;
+    guint8* data;
+    gint64  offset;
+    gsize   size;
+} CacheWindow;
 
 struct _Cache
 {
-    char*   filename;
-    int     readHandle;
-    int     writeHandle;
+    int          handle;
+
+    gint64       read_position;
+    gint64       write_position;
 
-    gint64  read_position;
-    gint64  write_position;
+    GArray*      ranges;   // Downloaded regions, sorted and disjoint.
+    CacheWindow* window;   // Most recently mapped window.
+    gboolean     use_mmap; // Cleared if mapping fails, reads are copied then.
 };
 
 void cache_static_init(void)
 {
+    long size = sysconf(_SC_PAGESIZE);
+
     tempDir = g_get_tmp_dir();
+    if (size > 0)
+        pageSize = size;
 }
 
-Cache* create_cache()
+static int cache_open_file(void)
 {
-    Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
-    if (result)
+    char* filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
+    int   handle = -1;
+
+    if (filename)
     {
-        result->filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
-        if (result->filename == NULL)
-            goto _error_exit;
-        else
+        handle = g_mkstemp_full(filename, O_RDWR, S_IRUSR|S_IWUSR);
+        if (handle >= 0 && unlink(filename) < 0)
         {
-        result->writeHandle = g_mkstemp_full(result->filename, O_RDWR, S_IRUSR|S_IWUSR);
-            result->readHandle = open(result->filename, O_RDONLY, 0);
+            close(handle);
+            handle = -1;
+        }
+        g_free(filename);
+    }
+    return handle;
+}
+
+static void cache_window_unref(gpointer data)
+{
+    CacheWindow* window = (CacheWindow*)data;
 
-            if(result->writeHandle < 0 || result->readHandle < 0)
-                goto _error_exit;
+    if (g_atomic_int_dec_and_test(&window->ref_count))
+    {
+        munmap(window->data, window->size);
+        g_free(window);
+    }
+}
+
+static void cache_drop_window(Cache* cache)
+{
+    if (cache->window)
+    {
+        cache_window_unref(cache->window);
+        cache->window = NULL;
+    }
+}
 
-        if (unlink(result->filename) < 0)
+Cache* create_cache()
+{
+    Cache* result = (Cache*)g_try_malloc(sizeof(Cache));
+    if (result)
+    {
+        result->handle = cache_open_file();
+        if (result->handle < 0)
         {
-            close (result->writeHandle);
-            close (result->readHandle);
-        goto _error_exit;
+            g_free(result);
+            return NULL;
         }
 
-            result->read_position = result->write_position = 0;
-        }
+        result->read_position = result->write_position = 0;
+        result->ranges = g_array_new(FALSE, FALSE, sizeof(CacheRange));
+        result->window = NULL;
+        result->use_mmap = TRUE;
     }
     return result;
-
-_error_exit:
-    g_free(result);
-    return NULL;
 }
 
 void destroy_cache(Cache* instance)
 {
-    close(instance->writeHandle);
-    close(instance->readHandle);
-    g_free(instance->filename);
+    // Buffers still in use keep their windows mapped.
+    cache_drop_window(instance);
+    close(instance->handle);
+    g_array_free(instance->ranges, TRUE);
 
     g_free(instance);
 }
 
+void cache_reset(Cache* cache)
+{
+    if (cache->ranges->len > 0)
+    {
+        // Buffers still in use may map the old content, so it is not
+        // overwritten. The old file goes away with the last of them.
+        int handle = cache_open_file();
+        if (handle >= 0)
+        {
+            cache_drop_window(cache);
+            close(cache->handle);
+            cache->handle = handle;
+        }
+        g_array_set_size(cache->ranges, 0);
+    }
+    cache->read_position = cache->write_position = 0;
+}
+
+static void cache_add_range(Cache* cache, gint64 start, gint64 stop)
+{
+    GArray*    ranges = cache->ranges;
+    CacheRange range;
+    guint      i = 0;
+
+    while (i < ranges->len && g_array_index(ranges, CacheRange, i).stop < start)
+        i++;
+
+    // Merge with the ranges the new one touches or overlaps.
+    while (i < ranges->len && g_array_index(ranges, CacheRange, i).start <= stop)
+    {
+        start = MIN(start, g_array_index(ranges, CacheRange, i).start);
+        stop = MAX(stop, g_array_index(ranges, CacheRange, i).stop);
+        g_array_remove_index(ranges, i);
+    }
+
+    range.start = start;
+    range.stop = stop;
+    g_array_insert_val(ranges, i, range);
+}
+
+gint64 cache_get_cached_end(Cache* cache, gint64 position)
+{
+    guint i;
+    for (i = 0; i < cache->ranges->len; i++)
+    {
+        CacheRange* range = &g_array_index(cache->ranges, CacheRange, i);
+        if (position < range->start)
+            break;
+        if (position < range->stop)
+            return range->stop;
+    }
+    return position;
+}
+
+// Returns a window covering the given region, mapping a new one if the
+// current window does not.
+static CacheWindow* cache_get_window(Cache* cache, gint64 position, gsize size)
+{
+    CacheWindow* window = cache->window;
+    if (window && position >= window->offset &&
+        position + (gint64)size <= window->offset + (gint64)window->size)
+        return window;
+
+    // The window may extend past the end of the file. Only downloaded
+    // regions are ever read from it, and writes show through the mapping.
+    gint64 offset = position - position % pageSize;
+    gint64 length = MAX(WINDOW_SIZE, position + (gint64)size - offset);
+    length = (length + pageSize - 1) / pageSize * pageSize;
+
+    void* data = mmap(NULL, (size_t)length, PROT_READ, MAP_SHARED, cache->handle, (off_t)offset);
+    if (data == MAP_FAILED)
+        return NULL;
+
+    window = g_new(CacheWindow, 1);
+    window->ref_count = 1;
+    window->data = (guint8*)data;
+    window->offset = offset;
+    window->size = (gsize)length;
+
+    cache_drop_window(cache);
+    cache->window = window;
+    return window;
+}
+
+static GstBuffer* cache_create_buffer(Cache* cache, gint64 position, gsize size)
+{
+    if (cache->use_mmap)
+    {
+        CacheWindow* window = cache_get_window(cache, position, size);
+        if (window)
+        {
+            gsize offset = (gsize)(position - window->offset);
+
+            g_atomic_int_inc(&window->ref_count);
+            return gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, window->data, offset + size,
+                                               offset, size, window, cache_window_unref);
+        }
+        cache->use_mmap = FALSE;
+    }
+
+    guint8* data = (guint8*)g_try_malloc(size);
+    if (data)
+    {
+        ssize_t read_bytes = pread(cache->handle, data, size, (off_t)position);
+        if (read_bytes == (ssize_t)size)
+            return gst_buffer_new_wrapped_full(0, data, size, 0, size, data, g_free);
+        g_free(data); // Wrong size, deleting buffer to avoid leaking.
+    }
+    return NULL;
+}
+
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
     GstMapInfo info;
     if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        ssize_t written = write(cache->writeHandle, info.data, info.size);
+        ssize_t written = pwrite(cache->handle, info.data, info.size, (off_t)cache->write_position);
         if (written > 0)
+        {
+            cache_add_range(cache, cache->write_position, cache->write_position + written);
             cache->write_position += written;
+        }
         gst_buffer_unmap(buffer, &info);
     }
 }
 
 gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 {
-    guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
+    gint64 available = cache_get_cached_end(cache, cache->read_position) - cache->read_position;
     *buffer = NULL;
 
-    if (data)
+    if (available > 0)
     {
-        ssize_t size = 0;
-        if ((cache->write_position - cache->read_position) > 0 &&
-            (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
-            size = cache->write_position - cache->read_position;
-        else
-            size = DEFAULT_BUFFER_SIZE;
-
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-        if (read_bytes > 0)
+        gsize size = (gsize)MIN(available, MAX_READ_SIZE);
+        *buffer = cache_create_buffer(cache, cache->read_position, size);
+        if (*buffer != NULL)
         {
-            *buffer = gst_buffer_new_wrapped_full(0, data, DEFAULT_BUFFER_SIZE, 0, read_bytes, data, g_free);
-            if (*buffer != NULL)
-                GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-
-            cache->read_position += read_bytes;
+            GST_BUFFER_OFFSET(*buffer) = cache->read_position;
+            cache->read_position += size;
             return cache->read_position;
         }
-        else // read error, deleting buffer to avoid leaking.
-            g_free(data);
     }
 
     return 0;
@@ -134,63 +296,37 @@ gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 
 GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_position, guint size, GstBuffer** buffer)
 {
-    GstFlowReturn result = GST_FLOW_ERROR;
     *buffer = NULL;
 
-    if (cache_set_read_position(cache, start_position))
-    {
-        guint8 *data = (guint8*)g_try_malloc(size);
-        if (data)
-    {
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-            if (read_bytes == size)
-            {
-                *buffer = gst_buffer_new_wrapped_full(0, data, size, 0, read_bytes, data, g_free);
-                if (*buffer != NULL)
-                {
-                    GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-                    result = GST_FLOW_OK;
-                }
-            }
-            else
-            g_free(data); // Wrong size, deleting buffer to avoid leaking.
-
-            cache->read_position += read_bytes;
-    }
-    }
-    return result;
-}
+    if (start_position < 0 || cache_get_cached_end(cache, start_position) < start_position + size)
+        return GST_FLOW_ERROR;
 
-static inline gboolean cache_set_handler_position(int handle, guint64 position)
-{
-    return lseek(handle, position, SEEK_SET) >= 0;
+    *buffer = cache_create_buffer(cache, start_position, size);
+    if (*buffer == NULL)
+        return GST_FLOW_ERROR;
+
+    GST_BUFFER_OFFSET(*buffer) = start_position;
+    cache->read_position = start_position + size;
+    return GST_FLOW_OK;
 }
 
 gboolean cache_set_write_position(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->write_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->writeHandle, position);
-        if (result)
-            cache->write_position = position;
-    }
-    return result;
+    if (position < 0)
+        return FALSE;
+    cache->write_position = position;
+    return TRUE;
 }
 
 gboolean cache_set_read_position(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->read_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->readHandle, position);
-        if (result)
-            cache->read_position = position;
-    }
-    return result;
+    if (position < 0)
+        return FALSE;
+    cache->read_position = position;
+    return TRUE;
 }
 
 gboolean cache_has_enough_data(Cache* cache)
 {
-    return cache->read_position < cache->write_position;
+    return cache_get_cached_end(cache, cache->read_position) > cache->read_position;
 }
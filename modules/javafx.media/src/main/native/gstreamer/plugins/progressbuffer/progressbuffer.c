@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -75,7 +75,6 @@ struct _ProgressBuffer
     // Cache infrastructure
     Cache         *cache;
     GstEvent      *pending_src_event;
-    gint64         cache_read_offset;
 
     GstSegment    sink_segment;
     gdouble       last_update;
@@ -256,7 +255,6 @@ static void progress_buffer_init(ProgressBuffer *element)
 
     element->srcpad = NULL;
     element->cache = NULL;
-    element->cache_read_offset = 0;
     g_mutex_init(&element->lock);
     g_cond_init(&element->add_cond);
     element->bandwidth_timer = g_timer_new();
@@ -635,11 +633,8 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                     return GST_FLOW_ERROR;
                 }
 
-                if ((segment.flags & GST_SEGMENT_FLAG_UPDATE) == GST_SEGMENT_FLAG_UPDATE) // Updating segments create new cache.
+                if (!element->cache)
                 {
-                    if (element->cache)
-                        destroy_cache(element->cache);
-
                     element->cache = create_cache();
                     if (!element->cache)
                     {
@@ -650,12 +645,11 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                         return GST_FLOW_ERROR;
                     }
                 }
-                else
-                {
-                    cache_set_write_position(element->cache, 0);
-                    cache_set_read_position(element->cache, 0);
-                    element->cache_read_offset = segment.start;
-                }
+
+                // The cache is addressed by stream offset, so whatever it
+                // already holds from before a source seek stays usable.
+                cache_set_write_position(element->cache, segment.start);
+                cache_set_read_position(element->cache, segment.start);
 
                 gst_segment_copy_into (&segment, &element->sink_segment);
                 progress_buffer_set_pending_event(element, event);
@@ -725,12 +719,15 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
     element->srcresult = GST_FLOW_OK;
 
 #ifdef ENABLE_SOURCE_SEEKING
-    element->instant_seek = (position >= element->sink_segment.start &&
+    // Seeks are instant if the data between the new position and the download
+    // position is cached, or if the download will soon get there.
+    element->instant_seek = ((position >= element->sink_segment.start ||
+                              cache_get_cached_end(element->cache, position) >= element->sink_segment.start) &&
                              (position - (gint64)element->sink_segment.position) <= element->bandwidth * element->wait_tolerance);
 
     if (element->instant_seek)
     {
-        cache_set_read_position(element->cache, position - element->cache_read_offset);
+        cache_set_read_position(element->cache, position);
         gst_segment_init(&segment, GST_FORMAT_BYTES);
         segment.rate = rate;
         segment.start = position;
@@ -744,7 +741,7 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
         reset_eos(element, TRUE);
     }
 #else
-    cache_set_read_position(element->cache, position - element->cache_read_offset);
+    cache_set_read_position(element->cache, position);
     gst_segment_init(&segment, GST_FORMAT_BYTES);
     segment.rate = rate;
     segment.start = position;
@@ -764,7 +761,7 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
         if (!gst_pad_push_event(element->sinkpad, e))
         {
             element->instant_seek = TRUE;
-            cache_set_read_position(element->cache, position - element->cache_read_offset);
+            cache_set_read_position(element->cache, position);
             gst_segment_init(&segment, GST_FORMAT_BYTES);
             segment.rate = rate;
             segment.start = position;
@@ -892,7 +889,6 @@ next_item:
         {
             GstBuffer *buffer = NULL;
             guint64 read_position = cache_read_buffer(element->cache, &buffer);
-            read_position += element->cache_read_offset;
             GST_BUFFER_OFFSET(buffer) = read_position - gst_buffer_get_size(buffer);
 
             if (read_position == element->sink_segment.stop)
@@ -1063,9 +1059,8 @@ static GstFlowReturn progress_buffer_getrange(GstPad *pad, GstObject *parent, gu
 
     if (element->sink_segment.stop < (gint64)end_position)
         result = GST_FLOW_EOS;
-    else if (element->sink_segment.start <= (gint64)start_position &&
-             element->sink_segment.position >= (gint64)end_position)
-        result = cache_read_buffer_from_position(element->cache, start_position, size, buffer);
+    else if (cache_get_cached_end(element->cache, start_position) >= (gint64)end_position)
+        result = cache_read_buffer_from_position(element->cache, start_position, size, buffer); // Also serves data downloaded before a source seek
     else
     {
 #if ENABLE_SOURCE_SEEKING
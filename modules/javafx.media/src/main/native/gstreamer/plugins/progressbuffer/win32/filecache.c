@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -37,6 +37,9 @@ struct _Cache
 
     gint64  read_position;
     gint64  write_position;
+
+    // The file holds a single region of the stream, starting at this offset.
+    gint64  base_position;
 };
 
 void cache_static_init(void)
@@ -66,7 +69,7 @@ Cache* create_cache()
             if(result->writeHandle == INVALID_HANDLE_VALUE || result->readHandle == INVALID_HANDLE_VALUE)
                 goto _error_exit;
 
-            result->read_position = result->write_position = 0;
+            result->read_position = result->write_position = result->base_position = 0;
         }
     }
     return result;
@@ -84,6 +87,13 @@ void destroy_cache(Cache* instance)
     g_free(instance);
 }
 
+void cache_reset(Cache* cache)
+{
+    SetFilePointer(cache->writeHandle, 0, NULL, FILE_BEGIN);
+    SetFilePointer(cache->readHandle, 0, NULL, FILE_BEGIN);
+    cache->read_position = cache->write_position = cache->base_position = 0;
+}
+
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
     DWORD written = 0;
@@ -163,14 +173,15 @@ static gboolean cache_set_handler_position(HANDLE handle, guint64 position)
     return (li.LowPart != INVALID_SET_FILE_POINTER || GetLastError() == NO_ERROR);
 }
 
+// Writing anywhere but at the end of the cached region starts it over.
 gboolean cache_set_write_position(Cache* cache, gint64 position)
 {
     gboolean result = (position == cache->write_position);
-    if (!result)
+    if (!result && position >= 0)
     {
-        result = cache_set_handler_position(cache->writeHandle, position);
+        result = cache_set_handler_position(cache->writeHandle, 0);
         if (result)
-            cache->write_position = position;
+            cache->write_position = cache->base_position = position;
     }
     return result;
 }
@@ -178,9 +189,9 @@ gboolean cache_set_write_position(Cache* cache, gint64 position)
 gboolean cache_set_read_position(Cache* cache, gint64 position)
 {
     gboolean result = (position == cache->read_position);
-    if (!result)
+    if (!result && position >= cache->base_position)
     {
-        result = cache_set_handler_position(cache->readHandle, position);
+        result = cache_set_handler_position(cache->readHandle, position - cache->base_position);
         if (result)
             cache->read_position = position;
     }
@@ -191,3 +202,10 @@ gboolean cache_has_enough_data(Cache* cache)
 {
     return cache->read_position < cache->write_position;
 }
+
+gint64 cache_get_cached_end(Cache* cache, gint64 position)
+{
+    if (position >= cache->base_position && position < cache->write_position)
+        return cache->write_position;
+    return position;
+}
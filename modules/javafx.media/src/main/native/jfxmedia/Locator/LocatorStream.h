@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -56,6 +56,22 @@ public:
     /* CopyBlock copies the data from whatever internal buffer to the destination.*/
     virtual void CopyBlock(void* destination, int size) = 0;
 
+    /* SetBlockBuffer shares native memory with the source, so that ReadNextBlockAt
+     * can read straight into it. Passing NULL stops sharing.
+     * Returns false if the memory can't be shared.
+     */
+    virtual bool SetBlockBuffer(void* data, int size) = 0;
+
+    /* ReadNextBlockAt reads next available block of data into the shared block
+     * buffer at offset, at most size bytes, and returns like ReadNextBlock.
+     */
+    virtual int  ReadNextBlockAt(int offset, int size) = 0;
+
+    /* ReadBlockInto reads arbitrary block of data straight into the destination,
+     * at most size bytes, and returns like ReadBlock.
+     */
+    virtual int  ReadBlockInto(int64_t position, void* destination, int size) = 0;
+
     /* Detects whether the source is seekable.*/
     virtual bool IsSeekable() = 0;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -37,6 +37,15 @@
 #define ENABLE_SIMD_SSE2 0
 #endif
 
+// AVX2 kernels are compiled alongside SSE2 and selected at run time
+#define ENABLE_SIMD_AVX2 ENABLE_SIMD_SSE2
+
+#if !ENABLE_SIMD_SSE2 && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define ENABLE_SIMD_NEON 1
+#else
+#define ENABLE_SIMD_NEON 0
+#endif
+
 // --- Begin macros
 #define TCLAMP_U8(val, dst) dst = pClip[val]
 
@@ -444,7 +453,7 @@ __m128i inline_loadu_si128(const __m128i *p)
     cc = _mm_packus_epi16(tt, x_temp1); \
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32(
+static int ColorConvert_YCbCr420p_to_ARGB32_SSE2(
                                uint8_t *argb,
                                int32_t argb_stride,
                                int32_t width,
@@ -931,7 +940,7 @@ int ColorConvert_YCbCr420p_to_ARGB32(
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
+static int ColorConvert_YCbCr420p_to_ARGB32_no_alpha_SSE2(
                                      uint8_t *argb,
                                      int32_t argb_stride,
                                      int32_t width,
@@ -1384,7 +1393,7 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32(
+static int ColorConvert_YCbCr420p_to_BGRA32_SSE2(
                                      uint8_t *bgra,
                                      int32_t bgra_stride,
                                      int32_t width,
@@ -1898,7 +1907,7 @@ int ColorConvert_YCbCr420p_to_BGRA32(
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
+static int ColorConvert_YCbCr420p_to_BGRA32_no_alpha_SSE2(
                                               uint8_t *bgra,
                                               int32_t bgra_stride,
                                               int32_t width,
@@ -2352,10 +2361,228 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
 }
 // --- End SSE2 YCbCr420p conversion functions
 
+#if ENABLE_SIMD_AVX2
+// --- Begin AVX2 YCbCr420p conversion functions
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+/*
+ * The library is not compiled with -mavx2, so the AVX2 kernel is compiled
+ * for that instruction set on its own and only called once the CPU has been
+ * checked. MSVC accepts the intrinsics without flags.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+static int CPUSupportsAVX2(void)
+{
+    unsigned int regs[4];
+    unsigned int maxLeaf, xcr0;
+    const unsigned int osxsaveAVX = (1u << 27) | (1u << 28);
+
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex(r, 0, 0);
+    maxLeaf = (unsigned int)r[0];
+    if (maxLeaf < 7)
+        return 0;
+    __cpuidex(r, 1, 0);
+    regs[2] = (unsigned int)r[2];
+    if ((regs[2] & osxsaveAVX) != osxsaveAVX)
+        return 0;
+    xcr0 = (unsigned int)_xgetbv(0);
+    __cpuidex(r, 7, 0);
+    regs[1] = (unsigned int)r[1];
+#else
+    __cpuid_count(0, 0, regs[0], regs[1], regs[2], regs[3]);
+    maxLeaf = regs[0];
+    if (maxLeaf < 7)
+        return 0;
+    __cpuid_count(1, 0, regs[0], regs[1], regs[2], regs[3]);
+    if ((regs[2] & osxsaveAVX) != osxsaveAVX)
+        return 0;
+    {
+        unsigned int edx;
+        // xgetbv, spelled out for assemblers that do not know the mnemonic
+        __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a"(xcr0), "=d"(edx) : "c"(0));
+    }
+    __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+
+    // The OS has to save the YMM state as well
+    if ((xcr0 & 0x6) != 0x6)
+        return 0;
+
+    return (regs[1] & (1u << 5)) != 0;
+}
+
+/*
+ * Converts the leading (width & ~31) columns of a YCbCr420p frame using the
+ * same 16 bit fixed point arithmetic as the SSE2 functions above, so that
+ * both produce identical pixels. Rows are handled one at a time here rather
+ * than interleaved: 16 chroma samples are expanded once per row pair and
+ * each row then converts 32 pixels per iteration.
+ *
+ * a is NULL for opaque frames. For BGRA output with alpha the color
+ * components are premultiplied, as in ColorConvert_YCbCr420p_to_BGRA32.
+ *
+ * Returns the number of columns converted.
+ */
+TARGET_AVX2
+static int32_t ColorConvert_YCbCr420p_AVX2(uint8_t *dst,
+                                           int32_t dst_stride,
+                                           int32_t width,
+                                           int32_t height,
+                                           const uint8_t *y,
+                                           const uint8_t *v,
+                                           const uint8_t *u,
+                                           const uint8_t *a,
+                                           int32_t y_stride,
+                                           int32_t v_stride,
+                                           int32_t u_stride,
+                                           int32_t a_stride,
+                                           int argb)
+{
+    const __m256i x_c0 = _mm256_set1_epi16(0x2543);
+    const __m256i x_c1 = _mm256_set1_epi16(0x4097);
+    const __m256i x_c4 = _mm256_set1_epi16(0xc8b);
+    const __m256i x_c5 = _mm256_set1_epi16(0x1a06);
+    const __m256i x_c8 = _mm256_set1_epi16(0x3317);
+    const __m256i x_coff0 = _mm256_set1_epi16((short)0xdd60);
+    const __m256i x_coff1 = _mm256_set1_epi16(0x10f4);
+    const __m256i x_coff2 = _mm256_set1_epi16((short)0xe420);
+    const __m256i x_zero = _mm256_setzero_si256();
+    const __m256i x_one = _mm256_set1_epi16(0x0001);
+    const __m256i x_aa = _mm256_set1_epi8((char)0xff);
+    const int premultiply = (a != NULL && !argb);
+    const int32_t blocks = width >> 5;
+
+    int32_t jH, iW, row;
+    __m256i x_u, x_v, x_b, x_g, x_r;
+    __m256i x_bl, x_bh, x_gl, x_gh, x_rl, x_rh;
+    __m256i x_yl, x_yh, x_temp, x_temp1, x_al, x_ah;
+    __m256i x_cb, x_cg, x_cr, x_ca;
+    __m256i x_lo, x_hi, x_out0, x_out1;
+
+    if (blocks == 0)
+        return 0;
+
+    for (jH = 0; jH < (height >> 1); jH++) {
+        const uint8_t *pU = u + jH * u_stride;
+        const uint8_t *pV = v + jH * v_stride;
+
+        for (iW = 0; iW < blocks; iW++) {
+            /* 16 chroma samples cover 32 pixels in each of the two rows */
+            x_u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pU + iW * 16)));
+            x_u = _mm256_slli_epi16(x_u, 8);
+            x_v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pV + iW * 16)));
+            x_v = _mm256_slli_epi16(x_v, 8);
+
+            x_b = _mm256_add_epi16(_mm256_mulhi_epu16(x_u, x_c1), x_coff0);
+            x_temp = _mm256_add_epi16(_mm256_mulhi_epu16(x_u, x_c4),
+                                      _mm256_mulhi_epu16(x_v, x_c5));
+            x_g = _mm256_sub_epi16(x_coff1, x_temp);
+            x_r = _mm256_add_epi16(_mm256_mulhi_epu16(x_v, x_c8), x_coff2);
+
+            /*
+             * Duplicate each sample for two horizontal pixels. The 64 bit
+             * permute makes the in-lane unpacks produce pixels 0-15 in
+             * *l and pixels 16-31 in *h.
+             */
+            x_temp = _mm256_permute4x64_epi64(x_b, 0xD8);
+            x_bl = _mm256_unpacklo_epi16(x_temp, x_temp);
+            x_bh = _mm256_unpackhi_epi16(x_temp, x_temp);
+            x_temp = _mm256_permute4x64_epi64(x_g, 0xD8);
+            x_gl = _mm256_unpacklo_epi16(x_temp, x_temp);
+            x_gh = _mm256_unpackhi_epi16(x_temp, x_temp);
+            x_temp = _mm256_permute4x64_epi64(x_r, 0xD8);
+            x_rl = _mm256_unpacklo_epi16(x_temp, x_temp);
+            x_rh = _mm256_unpackhi_epi16(x_temp, x_temp);
+
+            for (row = 0; row < 2; row++) {
+                const int32_t line = 2 * jH + row;
+                const uint8_t *pY = y + line * y_stride + iW * 32;
+                uint8_t *pD = dst + line * dst_stride + iW * 128;
+
+                x_temp = _mm256_loadu_si256((const __m256i*)pY);
+                x_yl = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(x_temp));
+                x_yl = _mm256_mulhi_epu16(_mm256_slli_epi16(x_yl, 8), x_c0);
+                x_yh = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(x_temp, 1));
+                x_yh = _mm256_mulhi_epu16(_mm256_slli_epi16(x_yh, 8), x_c0);
+
+                /* lane 0 holds pixels 0-7 and 16-23, lane 1 pixels 8-15 and 24-31 */
+                x_cb = _mm256_packus_epi16(_mm256_srai_epi16(_mm256_add_epi16(x_yl, x_bl), 5),
+                                           _mm256_srai_epi16(_mm256_add_epi16(x_yh, x_bh), 5));
+                x_cg = _mm256_packus_epi16(_mm256_srai_epi16(_mm256_add_epi16(x_yl, x_gl), 5),
+                                           _mm256_srai_epi16(_mm256_add_epi16(x_yh, x_gh), 5));
+                x_cr = _mm256_packus_epi16(_mm256_srai_epi16(_mm256_add_epi16(x_yl, x_rl), 5),
+                                           _mm256_srai_epi16(_mm256_add_epi16(x_yh, x_rh), 5));
+
+                if (a != NULL) {
+                    x_ca = _mm256_loadu_si256((const __m256i*)(a + line * a_stride + iW * 32));
+                    x_ca = _mm256_permute4x64_epi64(x_ca, 0xD8);
+                } else {
+                    x_ca = x_aa;
+                }
+
+                if (premultiply) {
+                    x_al = _mm256_add_epi16(_mm256_unpacklo_epi8(x_ca, x_zero), x_one);
+                    x_ah = _mm256_add_epi16(_mm256_unpackhi_epi8(x_ca, x_zero), x_one);
+#define PREMULTIPLY_ALPHA_AVX2(cc) \
+    x_temp = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(cc, x_zero), x_al), 8); \
+    x_temp1 = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(cc, x_zero), x_ah), 8); \
+    cc = _mm256_packus_epi16(x_temp, x_temp1);
+                    PREMULTIPLY_ALPHA_AVX2(x_cb);
+                    PREMULTIPLY_ALPHA_AVX2(x_cg);
+                    PREMULTIPLY_ALPHA_AVX2(x_cr);
+#undef PREMULTIPLY_ALPHA_AVX2
+                }
+
+                /* byte pairs: *l covers pixels 0-15, *h pixels 16-31 */
+                if (argb) {
+                    x_lo = _mm256_unpacklo_epi8(x_ca, x_cr);
+                    x_hi = _mm256_unpacklo_epi8(x_cg, x_cb);
+                } else {
+                    x_lo = _mm256_unpacklo_epi8(x_cb, x_cg);
+                    x_hi = _mm256_unpacklo_epi8(x_cr, x_ca);
+                }
+                x_out0 = _mm256_unpacklo_epi16(x_lo, x_hi);
+                x_out1 = _mm256_unpackhi_epi16(x_lo, x_hi);
+                _mm256_storeu_si256((__m256i*)pD, _mm256_permute2x128_si256(x_out0, x_out1, 0x20));
+                _mm256_storeu_si256((__m256i*)(pD + 32), _mm256_permute2x128_si256(x_out0, x_out1, 0x31));
+
+                if (argb) {
+                    x_lo = _mm256_unpackhi_epi8(x_ca, x_cr);
+                    x_hi = _mm256_unpackhi_epi8(x_cg, x_cb);
+                } else {
+                    x_lo = _mm256_unpackhi_epi8(x_cb, x_cg);
+                    x_hi = _mm256_unpackhi_epi8(x_cr, x_ca);
+                }
+                x_out0 = _mm256_unpacklo_epi16(x_lo, x_hi);
+                x_out1 = _mm256_unpackhi_epi16(x_lo, x_hi);
+                _mm256_storeu_si256((__m256i*)(pD + 64), _mm256_permute2x128_si256(x_out0, x_out1, 0x20));
+                _mm256_storeu_si256((__m256i*)(pD + 96), _mm256_permute2x128_si256(x_out0, x_out1, 0x31));
+            }
+        }
+    }
+
+    return blocks << 5;
+}
+// --- End AVX2 YCbCr420p conversion functions
+#endif // ENABLE_SIMD_AVX2
+
+
 #else // Generic C implementation
 
 // --- Begin C YCbCr420p conversion functions
-int ColorConvert_YCbCr420p_to_ARGB32(
+static int ColorConvert_YCbCr420p_to_ARGB32_C(
                                uint8_t *argb,
                                int32_t argb_stride,
                                int32_t width,
@@ -2372,7 +2599,7 @@ int ColorConvert_YCbCr420p_to_ARGB32(
     return 1; // NOTE: Not implemented
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
+static int ColorConvert_YCbCr420p_to_ARGB32_no_alpha_C(
                                      uint8_t *argb,
                                      int32_t argb_stride,
                                      int32_t width,
@@ -2387,7 +2614,7 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
     return 1; // NOTE: Not implemented
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
+static int ColorConvert_YCbCr420p_to_BGRA32_C(uint8_t *bgra,
                                      int32_t bgra_stride,
                                      int32_t width,
                                      int32_t height,
@@ -2497,7 +2724,7 @@ int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
+static int ColorConvert_YCbCr420p_to_BGRA32_no_alpha_C(
                                               uint8_t *bgra,
                                               int32_t bgra_stride,
                                               int32_t width,
@@ -2593,6 +2820,380 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
 }
 // --- End C YCbCr420p conversion functions
 #endif // ENABLE_SIMD_SSE2
+
+#if ENABLE_SIMD_NEON
+// --- Begin NEON YCbCr420p conversion functions
+#include <arm_neon.h>
+
+/* High 16 bits of the unsigned product, as _mm_mulhi_epu16 */
+static inline uint16x8_t neon_mulhi_u16(uint16x8_t x, uint16_t c)
+{
+    uint32x4_t lo = vmull_n_u16(vget_low_u16(x), c);
+    uint32x4_t hi = vmull_n_u16(vget_high_u16(x), c);
+    return vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16));
+}
+
+static inline uint8x8_t neon_pack_u8(uint16x8_t y, uint16x8_t c)
+{
+    return vqmovun_s16(vshrq_n_s16(vreinterpretq_s16_u16(vaddq_u16(y, c)), 5));
+}
+
+/* (c * (a + 1)) >> 8, as PREMULTIPLY_ALPHA */
+static inline uint8x16_t neon_premultiply(uint8x16_t c, uint8x16_t a)
+{
+    uint16x8_t lo = vmlal_u8(vmovl_u8(vget_low_u8(c)), vget_low_u8(c), vget_low_u8(a));
+    uint16x8_t hi = vmlal_u8(vmovl_u8(vget_high_u8(c)), vget_high_u8(c), vget_high_u8(a));
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+static inline uint8_t scalar_pack_u8(uint16_t y, uint16_t c)
+{
+    int32_t s = (int16_t)(uint16_t)(y + c) >> 5;
+    return (uint8_t)(s < 0 ? 0 : (s > 255 ? 255 : s));
+}
+
+/*
+ * YCbCr420p to ARGB32 or BGRA32 using the fixed point arithmetic of the SSE2
+ * functions, so that ARM and x86 produce the same pixels. Each row converts
+ * 16 pixels per iteration, remaining columns are converted one at a time.
+ * a is NULL for opaque frames; BGRA output with alpha is premultiplied.
+ */
+static int ColorConvert_YCbCr420p_NEON(uint8_t *dst,
+                                       int32_t dst_stride,
+                                       int32_t width,
+                                       int32_t height,
+                                       const uint8_t *y,
+                                       const uint8_t *v,
+                                       const uint8_t *u,
+                                       const uint8_t *a,
+                                       int32_t y_stride,
+                                       int32_t v_stride,
+                                       int32_t u_stride,
+                                       int32_t a_stride,
+                                       int argb)
+{
+    const uint16_t c0 = 0x2543, c1 = 0x4097, c4 = 0xc8b, c5 = 0x1a06, c8 = 0x3317;
+    const uint16_t coff0 = 0xdd60, coff1 = 0x10f4, coff2 = 0xe420;
+    const int premultiply = (a != NULL && !argb);
+    const int32_t vwidth = width & ~15;
+
+    int32_t jH, iW, row;
+
+    if (dst == NULL || y == NULL || u == NULL || v == NULL)
+        return 1;
+
+    for (jH = 0; jH < (height >> 1); jH++) {
+        const uint8_t *pU = u + jH * u_stride;
+        const uint8_t *pV = v + jH * v_stride;
+
+        for (iW = 0; iW < vwidth; iW += 16) {
+            uint16x8_t x_u = vshll_n_u8(vld1_u8(pU + (iW >> 1)), 8);
+            uint16x8_t x_v = vshll_n_u8(vld1_u8(pV + (iW >> 1)), 8);
+            uint16x8_t x_b = vaddq_u16(neon_mulhi_u16(x_u, c1), vdupq_n_u16(coff0));
+            uint16x8_t x_g = vsubq_u16(vdupq_n_u16(coff1),
+                                       vaddq_u16(neon_mulhi_u16(x_u, c4), neon_mulhi_u16(x_v, c5)));
+            uint16x8_t x_r = vaddq_u16(neon_mulhi_u16(x_v, c8), vdupq_n_u16(coff2));
+            uint16x8x2_t x_bb = vzipq_u16(x_b, x_b);
+            uint16x8x2_t x_gg = vzipq_u16(x_g, x_g);
+            uint16x8x2_t x_rr = vzipq_u16(x_r, x_r);
+
+            for (row = 0; row < 2; row++) {
+                const int32_t line = 2 * jH + row;
+                uint8x16_t x_y8 = vld1q_u8(y + line * y_stride + iW);
+                uint16x8_t x_yl = neon_mulhi_u16(vshll_n_u8(vget_low_u8(x_y8), 8), c0);
+                uint16x8_t x_yh = neon_mulhi_u16(vshll_n_u8(vget_high_u8(x_y8), 8), c0);
+                uint8x16_t x_cb = vcombine_u8(neon_pack_u8(x_yl, x_bb.val[0]), neon_pack_u8(x_yh, x_bb.val[1]));
+                uint8x16_t x_cg = vcombine_u8(neon_pack_u8(x_yl, x_gg.val[0]), neon_pack_u8(x_yh, x_gg.val[1]));
+                uint8x16_t x_cr = vcombine_u8(neon_pack_u8(x_yl, x_rr.val[0]), neon_pack_u8(x_yh, x_rr.val[1]));
+                uint8x16_t x_ca = (a != NULL) ? vld1q_u8(a + line * a_stride + iW) : vdupq_n_u8(0xff);
+                uint8x16x4_t x_out;
+
+                if (premultiply) {
+                    x_cb = neon_premultiply(x_cb, x_ca);
+                    x_cg = neon_premultiply(x_cg, x_ca);
+                    x_cr = neon_premultiply(x_cr, x_ca);
+                }
+
+                if (argb) {
+                    x_out.val[0] = x_ca;
+                    x_out.val[1] = x_cr;
+                    x_out.val[2] = x_cg;
+                    x_out.val[3] = x_cb;
+                } else {
+                    x_out.val[0] = x_cb;
+                    x_out.val[1] = x_cg;
+                    x_out.val[2] = x_cr;
+                    x_out.val[3] = x_ca;
+                }
+                vst4q_u8(dst + line * dst_stride + iW * 4, x_out);
+            }
+        }
+
+        for (; iW < width; iW++) {
+            const uint16_t iu = (uint16_t)(pU[iW >> 1] << 8);
+            const uint16_t iv = (uint16_t)(pV[iW >> 1] << 8);
+            const uint16_t ib = (uint16_t)(((iu * c1) >> 16) + coff0);
+            const uint16_t ig = (uint16_t)(coff1 - (((iu * c4) >> 16) + ((iv * c5) >> 16)));
+            const uint16_t ir = (uint16_t)(((iv * c8) >> 16) + coff2);
+
+            for (row = 0; row < 2; row++) {
+                const int32_t line = 2 * jH + row;
+                const uint16_t iy = (uint16_t)((((uint32_t)y[line * y_stride + iW] << 8) * c0) >> 16);
+                const uint8_t ia = (a != NULL) ? a[line * a_stride + iW] : 0xff;
+                uint8_t cb = scalar_pack_u8(iy, ib);
+                uint8_t cg = scalar_pack_u8(iy, ig);
+                uint8_t cr = scalar_pack_u8(iy, ir);
+                uint8_t *pD = dst + line * dst_stride + iW * 4;
+
+                if (premultiply) {
+                    cb = (uint8_t)((cb * (ia + 1)) >> 8);
+                    cg = (uint8_t)((cg * (ia + 1)) >> 8);
+                    cr = (uint8_t)((cr * (ia + 1)) >> 8);
+                }
+
+                if (argb) {
+                    pD[0] = ia;
+                    pD[1] = cr;
+                    pD[2] = cg;
+                    pD[3] = cb;
+                } else {
+                    pD[0] = cb;
+                    pD[1] = cg;
+                    pD[2] = cr;
+                    pD[3] = ia;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+// --- End NEON YCbCr420p conversion functions
+#endif // ENABLE_SIMD_NEON
+
+// --- Begin YCbCr420p dispatch
+static volatile int simdLevel = -1;
+
+static int DetectSIMDLevel(void)
+{
+#if ENABLE_SIMD_AVX2
+    if (CPUSupportsAVX2())
+        return COLOR_CONVERT_AVX2;
+#endif
+#if ENABLE_SIMD_SSE2
+    return COLOR_CONVERT_SSE2;
+#elif ENABLE_SIMD_NEON
+    return COLOR_CONVERT_NEON;
+#else
+    return COLOR_CONVERT_GENERIC;
+#endif
+}
+
+int ColorConvert_GetSIMDLevel(void)
+{
+    // Racing threads compute the same value, so no locking is needed
+    if (simdLevel < 0)
+        simdLevel = DetectSIMDLevel();
+    return simdLevel;
+}
+
+int ColorConvert_SetSIMDLevel(int level)
+{
+    int available = 0;
+
+    switch (level) {
+#if ENABLE_SIMD_SSE2
+        case COLOR_CONVERT_SSE2:
+            available = 1;
+            break;
+#else
+        case COLOR_CONVERT_GENERIC:
+            available = 1;
+            break;
+#endif
+#if ENABLE_SIMD_AVX2
+        case COLOR_CONVERT_AVX2:
+            available = CPUSupportsAVX2();
+            break;
+#endif
+#if ENABLE_SIMD_NEON
+        case COLOR_CONVERT_NEON:
+            available = 1;
+            break;
+#endif
+        default:
+            break;
+    }
+
+    if (!available)
+        return 1;
+
+    simdLevel = level;
+    return 0;
+}
+
+int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
+                                     int32_t argb_stride,
+                                     int32_t width,
+                                     int32_t height,
+                                     const uint8_t *y,
+                                     const uint8_t *v,
+                                     const uint8_t *u,
+                                     const uint8_t *a,
+                                     int32_t y_stride,
+                                     int32_t v_stride,
+                                     int32_t u_stride,
+                                     int32_t a_stride)
+{
+#if ENABLE_SIMD_AVX2
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_AVX2) {
+        int32_t done = ColorConvert_YCbCr420p_AVX2(argb, argb_stride, width, height, y, v, u, a,
+                                                   y_stride, v_stride, u_stride, a_stride, 1);
+        if (done > 0) {
+            if (done >= width)
+                return 0;
+            // The SSE2 code converts the remaining columns
+            argb += done * 4;
+            y += done;
+            v += done >> 1;
+            u += done >> 1;
+            a += done;
+            width -= done;
+        }
+    }
+#endif
+#if ENABLE_SIMD_SSE2
+    return ColorConvert_YCbCr420p_to_ARGB32_SSE2(argb, argb_stride, width, height, y, v, u, a, y_stride, v_stride, u_stride, a_stride);
+#else
+#if ENABLE_SIMD_NEON
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_NEON)
+        return ColorConvert_YCbCr420p_NEON(argb, argb_stride, width, height, y, v, u, a,
+                                           y_stride, v_stride, u_stride, a_stride, 1);
+#endif
+    return ColorConvert_YCbCr420p_to_ARGB32_C(argb, argb_stride, width, height, y, v, u, a, y_stride, v_stride, u_stride, a_stride);
+#endif
+}
+
+int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(uint8_t *argb,
+                                              int32_t argb_stride,
+                                              int32_t width,
+                                              int32_t height,
+                                              const uint8_t *y,
+                                              const uint8_t *v,
+                                              const uint8_t *u,
+                                              int32_t y_stride,
+                                              int32_t v_stride,
+                                              int32_t u_stride)
+{
+#if ENABLE_SIMD_AVX2
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_AVX2) {
+        int32_t done = ColorConvert_YCbCr420p_AVX2(argb, argb_stride, width, height, y, v, u, NULL,
+                                                   y_stride, v_stride, u_stride, 0, 1);
+        if (done > 0) {
+            if (done >= width)
+                return 0;
+            // The SSE2 code converts the remaining columns
+            argb += done * 4;
+            y += done;
+            v += done >> 1;
+            u += done >> 1;
+            width -= done;
+        }
+    }
+#endif
+#if ENABLE_SIMD_SSE2
+    return ColorConvert_YCbCr420p_to_ARGB32_no_alpha_SSE2(argb, argb_stride, width, height, y, v, u, y_stride, v_stride, u_stride);
+#else
+#if ENABLE_SIMD_NEON
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_NEON)
+        return ColorConvert_YCbCr420p_NEON(argb, argb_stride, width, height, y, v, u, NULL,
+                                           y_stride, v_stride, u_stride, 0, 1);
+#endif
+    return ColorConvert_YCbCr420p_to_ARGB32_no_alpha_C(argb, argb_stride, width, height, y, v, u, y_stride, v_stride, u_stride);
+#endif
+}
+
+int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
+                                     int32_t bgra_stride,
+                                     int32_t width,
+                                     int32_t height,
+                                     const uint8_t *y,
+                                     const uint8_t *v,
+                                     const uint8_t *u,
+                                     const uint8_t *a,
+                                     int32_t y_stride,
+                                     int32_t v_stride,
+                                     int32_t u_stride,
+                                     int32_t a_stride)
+{
+#if ENABLE_SIMD_AVX2
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_AVX2) {
+        int32_t done = ColorConvert_YCbCr420p_AVX2(bgra, bgra_stride, width, height, y, v, u, a,
+                                                   y_stride, v_stride, u_stride, a_stride, 0);
+        if (done > 0) {
+            if (done >= width)
+                return 0;
+            // The SSE2 code converts the remaining columns
+            bgra += done * 4;
+            y += done;
+            v += done >> 1;
+            u += done >> 1;
+            a += done;
+            width -= done;
+        }
+    }
+#endif
+#if ENABLE_SIMD_SSE2
+    return ColorConvert_YCbCr420p_to_BGRA32_SSE2(bgra, bgra_stride, width, height, y, v, u, a, y_stride, v_stride, u_stride, a_stride);
+#else
+#if ENABLE_SIMD_NEON
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_NEON)
+        return ColorConvert_YCbCr420p_NEON(bgra, bgra_stride, width, height, y, v, u, a,
+                                           y_stride, v_stride, u_stride, a_stride, 0);
+#endif
+    return ColorConvert_YCbCr420p_to_BGRA32_C(bgra, bgra_stride, width, height, y, v, u, a, y_stride, v_stride, u_stride, a_stride);
+#endif
+}
+
+int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(uint8_t *bgra,
+                                              int32_t bgra_stride,
+                                              int32_t width,
+                                              int32_t height,
+                                              const uint8_t *y,
+                                              const uint8_t *v,
+                                              const uint8_t *u,
+                                              int32_t y_stride,
+                                              int32_t v_stride,
+                                              int32_t u_stride)
+{
+#if ENABLE_SIMD_AVX2
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_AVX2) {
+        int32_t done = ColorConvert_YCbCr420p_AVX2(bgra, bgra_stride, width, height, y, v, u, NULL,
+                                                   y_stride, v_stride, u_stride, 0, 0);
+        if (done > 0) {
+            if (done >= width)
+                return 0;
+            // The SSE2 code converts the remaining columns
+            bgra += done * 4;
+            y += done;
+            v += done >> 1;
+            u += done >> 1;
+            width -= done;
+        }
+    }
+#endif
+#if ENABLE_SIMD_SSE2
+    return ColorConvert_YCbCr420p_to_BGRA32_no_alpha_SSE2(bgra, bgra_stride, width, height, y, v, u, y_stride, v_stride, u_stride);
+#else
+#if ENABLE_SIMD_NEON
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_NEON)
+        return ColorConvert_YCbCr420p_NEON(bgra, bgra_stride, width, height, y, v, u, NULL,
+                                           y_stride, v_stride, u_stride, 0, 0);
+#endif
+    return ColorConvert_YCbCr420p_to_BGRA32_no_alpha_C(bgra, bgra_stride, width, height, y, v, u, y_stride, v_stride, u_stride);
+#endif
+}
+// --- End YCbCr420p dispatch
 // --- End YCbCr420p conversion functions
 
 // --- Begin YCbCr422p conversion functions
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,6 +32,23 @@
 extern "C" {
 #endif
 
+    /*
+     * Implementations of the YCbCr420p converters. The best one supported by
+     * the build and the CPU is picked on first use.
+     */
+#define COLOR_CONVERT_GENERIC   0
+#define COLOR_CONVERT_SSE2      1
+#define COLOR_CONVERT_AVX2      2
+#define COLOR_CONVERT_NEON      3
+
+    int ColorConvert_GetSIMDLevel(void);
+
+    /*
+     * Forces one of the implementations above, mostly for benchmarking.
+     * Returns 1 if it is not available on this build or CPU.
+     */
+    int ColorConvert_SetSIMDLevel(int level);
+
     int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
                                          int32_t argb_stride,
                                          int32_t width,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -35,6 +35,9 @@ jfieldID  CJavaInputStreamCallbacks::m_BufferFID = 0;
 jmethodID CJavaInputStreamCallbacks::m_NeedBufferMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_ReadNextBlockMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_ReadBlockMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_SetNativeBufferMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_ReadNextBlockAtMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_ReadBlockIntoMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_IsSeekableMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_IsRandomAccessMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_SeekMID = 0;
@@ -114,6 +117,24 @@ bool CJavaInputStreamCallbacks::Init(JNIEnv *env, jobject jLocator)
             hasException = (javaEnv.reportException() || (NULL == m_ReadBlockMID));
         }
 
+        if (!hasException)
+        {
+            m_SetNativeBufferMID = env->GetMethodID(klass, "setNativeBuffer", "(Ljava/nio/ByteBuffer;)V");
+            hasException = (javaEnv.reportException() || (NULL == m_SetNativeBufferMID));
+        }
+
+        if (!hasException)
+        {
+            m_ReadNextBlockAtMID = env->GetMethodID(klass, "readNextBlock", "(II)I");
+            hasException = (javaEnv.reportException() || (NULL == m_ReadNextBlockAtMID));
+        }
+
+        if (!hasException)
+        {
+            m_ReadBlockIntoMID = env->GetMethodID(klass, "readBlock", "(JLjava/nio/ByteBuffer;)I");
+            hasException = (javaEnv.reportException() || (NULL == m_ReadBlockIntoMID));
+        }
+
         if (!hasException)
         {
             m_IsSeekableMID = env->GetMethodID(klass, "isSeekable", "()Z");
@@ -229,6 +250,83 @@ void CJavaInputStreamCallbacks::CopyBlock(void* destination, int size)
     }
  }
 
+bool CJavaInputStreamCallbacks::SetBlockBuffer(void* data, int size)
+{
+    bool result = false;
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        if (connection) {
+            // The buffer is created once and kept by the connection holder,
+            // so reading a block does not allocate anything in Java.
+            jobject buffer = NULL;
+            if (NULL != data && size > 0) {
+                buffer = pEnv->NewDirectByteBuffer(data, (jlong)size);
+            }
+
+            if (NULL != buffer || NULL == data) {
+                pEnv->CallVoidMethod(connection, m_SetNativeBufferMID, buffer);
+                result = !javaEnv.clearException() && (NULL != buffer);
+            } else {
+                javaEnv.clearException();
+            }
+
+            if (NULL != buffer) {
+                pEnv->DeleteLocalRef(buffer);
+            }
+            pEnv->DeleteLocalRef(connection);
+        }
+    }
+
+    return result;
+}
+
+int CJavaInputStreamCallbacks::ReadNextBlockAt(int offset, int size)
+{
+    int result = -1;
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        if (connection) {
+            result = pEnv->CallIntMethod(connection, m_ReadNextBlockAtMID, (jint)offset, (jint)size);
+            if (javaEnv.clearException()) {
+                result = -2;
+            }
+            pEnv->DeleteLocalRef(connection);
+        }
+    }
+
+    return result;
+}
+
+int CJavaInputStreamCallbacks::ReadBlockInto(int64_t position, void* destination, int size)
+{
+    int result = -1;
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        if (connection) {
+            jobject buffer = pEnv->NewDirectByteBuffer(destination, (jlong)size);
+            if (NULL != buffer) {
+                result = pEnv->CallIntMethod(connection, m_ReadBlockIntoMID, (jlong)position, buffer);
+                pEnv->DeleteLocalRef(buffer);
+            }
+            if (javaEnv.clearException() || NULL == buffer) {
+                result = -2;
+            }
+            pEnv->DeleteLocalRef(connection);
+        }
+    }
+
+    return result;
+}
+
 bool CJavaInputStreamCallbacks::IsSeekable()
 {
     CJavaEnvironment javaEnv(m_jvm);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -41,6 +41,9 @@ virtual ~CJavaInputStreamCallbacks();
     int  ReadNextBlock();
     int  ReadBlock(int64_t position, int size);
     void CopyBlock(void* destination, int size);
+    bool SetBlockBuffer(void* data, int size);
+    int  ReadNextBlockAt(int offset, int size);
+    int  ReadBlockInto(int64_t position, void* destination, int size);
     bool IsSeekable();
     bool IsRandomAccess();
     int64_t Seek(int64_t position);
@@ -55,6 +58,9 @@ private:
     static jmethodID m_NeedBufferMID;
     static jmethodID m_ReadNextBlockMID;
     static jmethodID m_ReadBlockMID;
+    static jmethodID m_SetNativeBufferMID;
+    static jmethodID m_ReadNextBlockAtMID;
+    static jmethodID m_ReadBlockIntoMID;
     static jmethodID m_IsSeekableMID;
     static jmethodID m_IsRandomAccessMID;
     static jmethodID m_SeekMID;
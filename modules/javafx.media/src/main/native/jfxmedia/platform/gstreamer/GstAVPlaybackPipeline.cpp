@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -54,6 +54,7 @@ CGstAVPlaybackPipeline::CGstAVPlaybackPipeline(const GstElementContainer& elemen
 :   CGstAudioPlaybackPipeline(elements, audioFlags, pOptions)
 {
     LOGGER_LOGMSG(LOGGER_DEBUG, "CGstAVPlaybackPipeline::CGstAVPlaybackPipeline()");
+    CGstVideoFrame::RetainFramePool();
     m_videoDecoderSrcProbeHID = 0L;
     m_EncodedVideoFrameRate = 24.0F;
     m_SendFrameSizeEvent = TRUE;
@@ -75,6 +76,7 @@ CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()
     g_print ("CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()\n");
 #endif
     LOGGER_LOGMSG(LOGGER_DEBUG, "CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()");
+    CGstVideoFrame::ReleaseFramePool();
 }
 
 /**
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -207,12 +207,17 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
 
             g_signal_connect (javaSource, "read-next-block", G_CALLBACK (SourceReadNextBlock), callbacks);
             g_signal_connect (javaSource, "copy-block", G_CALLBACK (SourceCopyBlock), callbacks);
+            g_signal_connect (javaSource, "set-block-buffer", G_CALLBACK (SourceSetBlockBuffer), callbacks);
+            g_signal_connect (javaSource, "read-next-block-at", G_CALLBACK (SourceReadNextBlockAt), callbacks);
             g_signal_connect (javaSource, "seek-data", G_CALLBACK (SourceSeekData), callbacks);
             g_signal_connect (javaSource, "close-connection", G_CALLBACK (SourceCloseConnection), callbacks);
             g_signal_connect (javaSource, "property", G_CALLBACK (SourceProperty), callbacks);
 
             if (isRandomAccess)
+            {
                 g_signal_connect (javaSource, "read-block", G_CALLBACK (SourceReadBlock), callbacks);
+                g_signal_connect (javaSource, "read-block-into", G_CALLBACK (SourceReadBlockInto), callbacks);
+            }
 
             if (hlsMode == 1)
                 g_object_set (javaSource, "hls-mode", TRUE, NULL);
@@ -302,6 +307,21 @@ void CGstPipelineFactory::SourceCopyBlock(GstElement *src, gpointer buffer, int
     ((CStreamCallbacks*)data)->CopyBlock(buffer, size);
 }
 
+gboolean CGstPipelineFactory::SourceSetBlockBuffer(GstElement *src, gpointer buffer, int size, gpointer data)
+{
+    return ((CStreamCallbacks*)data)->SetBlockBuffer(buffer, size) ? TRUE : FALSE;
+}
+
+gint CGstPipelineFactory::SourceReadNextBlockAt(GstElement *src, int offset, int size, gpointer data)
+{
+    return ((CStreamCallbacks*)data)->ReadNextBlockAt(offset, size);
+}
+
+gint CGstPipelineFactory::SourceReadBlockInto(GstElement *src, guint64 position, gpointer buffer, guint size, gpointer data)
+{
+    return ((CStreamCallbacks*)data)->ReadBlockInto((int64_t)position, buffer, (int)size);
+}
+
 gint64 CGstPipelineFactory::SourceSeekData(GstElement *src, guint64 offset, gpointer data)
 {
     return (gint64)((CStreamCallbacks*)data)->Seek((int64_t)offset);
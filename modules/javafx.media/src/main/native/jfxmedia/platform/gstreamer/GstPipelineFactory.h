@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -88,6 +88,9 @@ private:
     static gint     SourceReadNextBlock(GstElement *src, gpointer data);
     static gint     SourceReadBlock(GstElement *src, guint64 position, guint size, gpointer data);
     static void     SourceCopyBlock(GstElement *src, gpointer buffer, int size, gpointer data);
+    static gboolean SourceSetBlockBuffer(GstElement *src, gpointer buffer, int size, gpointer data);
+    static gint     SourceReadNextBlockAt(GstElement *src, int offset, int size, gpointer data);
+    static gint     SourceReadBlockInto(GstElement *src, guint64 position, gpointer buffer, guint size, gpointer data);
     static gint64   SourceSeekData(GstElement *src, guint64 offset, gpointer data);
     static void     SourceCloseConnection(GstElement *src, gpointer data);
     static int      SourceProperty(GstElement *src, int prop, int value, gpointer data);
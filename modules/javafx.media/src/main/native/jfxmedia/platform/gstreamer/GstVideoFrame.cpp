@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -40,36 +40,141 @@ static inline guint32 swap_uint32(guint32 x)
         ((x & 0xff000000U) >> 24);
 }
 
-static void free_aligned_buffer(gpointer ptr)
+/*
+ * Converted frames are allocated from a small pool so that steady playback
+ * reuses the same few buffers instead of allocating a full frame each time.
+ * Every converted format is 32 bits per pixel, so the allocation size
+ * identifies the format and dimensions. Only blocks of the most recently
+ * requested size are kept; a size change frees the others. The pool holds
+ * at most FRAME_POOL_MAX_BYTES and is emptied when the last video pipeline
+ * is destroyed.
+ */
+#define FRAME_POOL_MAX_BUFFERS  4
+#define FRAME_POOL_MAX_BYTES    (64 * 1024 * 1024)
+
+struct FrameMemory
+{
+    guint8 *base;   // as returned by g_try_malloc, 16 bytes larger than size
+    guint   size;
+};
+
+static GMutex   frame_pool_lock;
+static GSList  *frame_pool = NULL;
+static guint    frame_pool_count = 0;
+static guint    frame_pool_size = 0;
+static guint    frame_pool_users = 0;
+
+static void free_frame_memory(FrameMemory *mem)
+{
+    g_free(mem->base);
+    g_free(mem);
+}
+
+static void release_frame_memory(gpointer ptr)
 {
-    if (ptr != NULL) {
-        g_free(ptr);
+    FrameMemory *mem = (FrameMemory*)ptr;
+    if (mem == NULL) {
+        return;
+    }
+
+    g_mutex_lock(&frame_pool_lock);
+    if (frame_pool_users > 0 && mem->size == frame_pool_size &&
+        frame_pool_count < FRAME_POOL_MAX_BUFFERS &&
+        (guint64)(frame_pool_count + 1) * mem->size <= FRAME_POOL_MAX_BYTES) {
+        frame_pool = g_slist_prepend(frame_pool, mem);
+        frame_pool_count++;
+        mem = NULL;
+    }
+    g_mutex_unlock(&frame_pool_lock);
+
+    if (mem != NULL) {
+        free_frame_memory(mem);
     }
 }
 
-static GstBuffer *alloc_aligned_buffer(guint size)
+static FrameMemory *acquire_frame_memory(guint size)
 {
-    // allocate a new GstBuffer of the given size plus some for padding and alignment
-    guint8 *newData;
-    guint8 *alignedData;
-    guint alignedSize;
+    FrameMemory *mem = NULL;
+    GSList *stale = NULL;
 
-    // allocate a buffer large enough to accommodate 16 byte alignment
-    alignedSize = size;
-    if (size <= (G_MAXUINT - 16)) {
-        size += 16;
-    } else {
-        return NULL;
+    g_mutex_lock(&frame_pool_lock);
+    if (size != frame_pool_size) {
+        stale = frame_pool;
+        frame_pool = NULL;
+        frame_pool_count = 0;
+        frame_pool_size = size;
+    } else if (frame_pool != NULL) {
+        mem = (FrameMemory*)frame_pool->data;
+        frame_pool = g_slist_delete_link(frame_pool, frame_pool);
+        frame_pool_count--;
+    }
+    g_mutex_unlock(&frame_pool_lock);
+
+    if (stale != NULL) {
+        g_slist_free_full(stale, (GDestroyNotify)free_frame_memory);
+    }
+
+    if (mem == NULL) {
+        // allocate a block large enough to accommodate 16 byte alignment
+        if (size > (G_MAXUINT - 16)) {
+            return NULL;
+        }
+
+        mem = g_try_new(FrameMemory, 1);
+        if (mem == NULL) {
+            return NULL;
+        }
+
+        mem->base = (guint8*)g_try_malloc(size + 16);
+        if (mem->base == NULL) {
+            g_free(mem);
+            return NULL;
+        }
+        mem->size = size;
+    }
+
+    return mem;
+}
+
+void CGstVideoFrame::RetainFramePool()
+{
+    g_mutex_lock(&frame_pool_lock);
+    frame_pool_users++;
+    g_mutex_unlock(&frame_pool_lock);
+}
+
+void CGstVideoFrame::ReleaseFramePool()
+{
+    GSList *stale = NULL;
+
+    g_mutex_lock(&frame_pool_lock);
+    if (frame_pool_users > 0 && --frame_pool_users == 0) {
+        // Frames still held by Java are freed when they are released
+        stale = frame_pool;
+        frame_pool = NULL;
+        frame_pool_count = 0;
+        frame_pool_size = 0;
     }
+    g_mutex_unlock(&frame_pool_lock);
+
+    if (stale != NULL) {
+        g_slist_free_full(stale, (GDestroyNotify)free_frame_memory);
+    }
+}
+
+static GstBuffer *alloc_aligned_buffer(guint size)
+{
+    // get a GstBuffer of the given size, 16 byte aligned and backed by pooled memory
+    FrameMemory *mem = acquire_frame_memory(size);
+    guint8 *alignedData;
 
-    newData = (guint8*)g_try_malloc(size);
-    if (NULL == newData) {
+    if (NULL == mem) {
         return NULL;
     }
 
-    alignedData = (guint8*)(((intptr_t)newData + 15) & ~15);
+    alignedData = (guint8*)(((intptr_t)mem->base + 15) & ~15);
 
-    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, alignedSize, 0, alignedSize, newData, free_aligned_buffer);
+    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, size, 0, size, mem, release_frame_memory);
 }
 
 GstCaps *create_RGB_caps(CVideoFrame::FrameType type, guint width, guint height, guint encodedWidth, guint encodedHeight, guint stride)
@@ -107,6 +212,202 @@ GstCaps *create_RGB_caps(CVideoFrame::FrameType type, guint width, guint height,
     return newCaps;
 }
 
+// Frames of at least this many pixels are converted in row bands on several threads
+#define CONVERT_BANDS_MIN_PIXELS    (1280 * 720)
+#define CONVERT_BANDS_MIN_ROWS      64
+#define CONVERT_BANDS_MAX           8
+
+// One YCbCr420p to RGB conversion, planes are ordered Y, Cb, Cr, A
+struct ConvertJob
+{
+    CVideoFrame::FrameType destType;
+    bool            hasAlpha;
+    guint8         *dest;
+    gint            destStride;
+    gint            width;
+    const guint8   *planes[4];
+    gint            strides[4];
+};
+
+struct ConvertBand
+{
+    gint        firstRow;
+    gint        rows;
+    int         status;
+};
+
+// A conversion split into bands. It is shared by the calling thread and the
+// pool tasks, each of which holds a reference, as a queued task may only run
+// after the calling thread has returned. Bands are claimed in order by
+// whoever is free, so none of them waits for a thread that may never start.
+struct ConvertTask
+{
+    ConvertJob      job;
+    gint            refCount;
+    gint            bandCount;
+    gint            nextBand;
+
+    GMutex          lock;
+    GCond           done;
+    gint            pending;
+    ConvertBand     bands[CONVERT_BANDS_MAX];
+};
+
+static int convert_YCbCr420p_rows(const ConvertJob *job, gint firstRow, gint rows)
+{
+    // firstRow is always even, so chroma rows are not shared between bands
+    guint8 *dest = job->dest + (gsize)firstRow * job->destStride;
+    const guint8 *y = job->planes[0] + (gsize)firstRow * job->strides[0];
+    const guint8 *v = job->planes[1] + (gsize)(firstRow / 2) * job->strides[1];
+    const guint8 *u = job->planes[2] + (gsize)(firstRow / 2) * job->strides[2];
+    const guint8 *a = job->hasAlpha ? job->planes[3] + (gsize)firstRow * job->strides[3] : NULL;
+
+    if (job->destType == CVideoFrame::ARGB) {
+        if (job->hasAlpha) {
+            return ColorConvert_YCbCr420p_to_ARGB32(dest, job->destStride, job->width, rows,
+                        y, v, u, a, job->strides[0], job->strides[1], job->strides[2], job->strides[3]);
+        }
+        return ColorConvert_YCbCr420p_to_ARGB32_no_alpha(dest, job->destStride, job->width, rows,
+                    y, v, u, job->strides[0], job->strides[1], job->strides[2]);
+    }
+
+    if (job->hasAlpha) {
+        return ColorConvert_YCbCr420p_to_BGRA32(dest, job->destStride, job->width, rows,
+                    y, v, u, a, job->strides[0], job->strides[1], job->strides[2], job->strides[3]);
+    }
+    return ColorConvert_YCbCr420p_to_BGRA32_no_alpha(dest, job->destStride, job->width, rows,
+                y, v, u, job->strides[0], job->strides[1], job->strides[2]);
+}
+
+static void convert_task_unref(ConvertTask *task)
+{
+    if (g_atomic_int_dec_and_test(&task->refCount)) {
+        g_cond_clear(&task->done);
+        g_mutex_clear(&task->lock);
+        g_free(task);
+    }
+}
+
+// Converts bands until none is left to claim
+static void convert_task_run(ConvertTask *task)
+{
+    gint i;
+
+    while ((i = g_atomic_int_add(&task->nextBand, 1)) < task->bandCount) {
+        ConvertBand *band = &task->bands[i];
+        band->status = convert_YCbCr420p_rows(&task->job, band->firstRow, band->rows);
+
+        g_mutex_lock(&task->lock);
+        if (--task->pending == 0) {
+            g_cond_signal(&task->done);
+        }
+        g_mutex_unlock(&task->lock);
+    }
+}
+
+static void convert_band_func(gpointer data, gpointer user_data)
+{
+    ConvertTask *task = (ConvertTask*)data;
+
+    convert_task_run(task);
+    convert_task_unref(task);
+}
+
+static GThreadPool *get_convert_pool()
+{
+    static gsize pool = 0;
+
+    if (g_once_init_enter(&pool)) {
+        // Shared threads, they are returned to GLib when idle
+        GError *error = NULL;
+        GThreadPool *newPool = g_thread_pool_new(convert_band_func, NULL,
+                                                 CONVERT_BANDS_MAX - 1, FALSE, &error);
+        if (error != NULL) {
+            // Frames are converted on the calling thread only
+            g_error_free(error);
+            newPool = NULL;
+        }
+        g_once_init_leave(&pool, newPool != NULL ? (gsize)newPool : (gsize)-1);
+    }
+
+    return pool != (gsize)-1 ? (GThreadPool*)pool : NULL;
+}
+
+static gint convert_band_count(gint width, gint height)
+{
+    static gint processors = 0;
+    gint bands;
+
+    if ((gint64)width * height < CONVERT_BANDS_MIN_PIXELS) {
+        return 1;
+    }
+
+    if (processors == 0) {
+        processors = (gint)g_get_num_processors();
+    }
+
+    bands = MIN(processors, CONVERT_BANDS_MAX);
+    return MAX(1, MIN(bands, height / CONVERT_BANDS_MIN_ROWS));
+}
+
+/*
+ * Converts a YCbCr420p frame, splitting large frames into bands of rows
+ * that are converted concurrently. The calling thread converts bands as
+ * well, including any that no pool thread has claimed, and then waits for
+ * the bands still being converted.
+ */
+static int convert_YCbCr420p(const ConvertJob *job, gint height)
+{
+    gint bands = convert_band_count(job->width, height);
+    GThreadPool *pool = bands > 1 ? get_convert_pool() : NULL;
+    ConvertTask *task;
+    gint bandRows, i;
+    int status = 0;
+
+    if (pool == NULL) {
+        return convert_YCbCr420p_rows(job, 0, height);
+    }
+
+    bandRows = (height / bands) & ~1;
+
+    task = g_new(ConvertTask, 1);
+    task->job = *job;
+    task->refCount = bands;
+    task->bandCount = bands;
+    task->nextBand = 0;
+    g_mutex_init(&task->lock);
+    g_cond_init(&task->done);
+    task->pending = bands;
+
+    for (i = 0; i < bands; i++) {
+        ConvertBand *band = &task->bands[i];
+        band->firstRow = i * bandRows;
+        band->rows = (i == bands - 1) ? height - band->firstRow : bandRows;
+        band->status = 0;
+    }
+
+    for (i = 1; i < bands; i++) {
+        // If no thread could be started the task stays queued; by then the
+        // bands are converted here and the task only drops its reference
+        g_thread_pool_push(pool, task, NULL);
+    }
+
+    convert_task_run(task);
+
+    g_mutex_lock(&task->lock);
+    while (task->pending > 0) {
+        g_cond_wait(&task->done, &task->lock);
+    }
+    g_mutex_unlock(&task->lock);
+
+    for (i = 0; i < bands && status == 0; i++) {
+        status = task->bands[i].status;
+    }
+
+    convert_task_unref(task);
+    return status;
+}
+
 CGstVideoFrame::CGstVideoFrame()
 {
     m_bIsValid = false;
@@ -430,49 +731,22 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
     }
 
     // now do the conversion
-    if (destType == ARGB) {
-        if (m_bHasAlpha) {
-            status = ColorConvert_YCbCr420p_to_ARGB32(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        (const uint8_t*)m_pvPlaneData[3],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index], m_puiPlaneStrides[3]);
-        } else {
-            status = ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index]);
-        }
-    } else {
-        if (m_bHasAlpha) {
-            status = ColorConvert_YCbCr420p_to_BGRA32(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        (const uint8_t*)m_pvPlaneData[3],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index], m_puiPlaneStrides[3]);
-        } else {
-            status = ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
-                        info.data, stride,
-                        m_uiEncodedWidth, m_uiEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        m_puiPlaneStrides[0], m_puiPlaneStrides[v_index],
-                        m_puiPlaneStrides[u_index]);
-        }
-    }
+    ConvertJob job;
+    job.destType = destType;
+    job.hasAlpha = m_bHasAlpha;
+    job.dest = info.data;
+    job.destStride = stride;
+    job.width = m_uiEncodedWidth;
+    job.planes[0] = (const guint8*)m_pvPlaneData[0];
+    job.planes[1] = (const guint8*)m_pvPlaneData[v_index];
+    job.planes[2] = (const guint8*)m_pvPlaneData[u_index];
+    job.planes[3] = (const guint8*)m_pvPlaneData[3];
+    job.strides[0] = m_puiPlaneStrides[0];
+    job.strides[1] = m_puiPlaneStrides[v_index];
+    job.strides[2] = m_puiPlaneStrides[u_index];
+    job.strides[3] = m_puiPlaneStrides[3];
+
+    status = convert_YCbCr420p(&job, m_uiEncodedHeight);
 
     gst_buffer_unmap(destBuffer, &info);
 
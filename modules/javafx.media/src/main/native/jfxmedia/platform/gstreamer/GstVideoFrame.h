@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -58,6 +58,13 @@ public:
 
     virtual CVideoFrame *ConvertToFormat(FrameType type);
 
+    /*
+     * Converted frames are pooled while at least one video pipeline holds
+     * a reference to the pool. Releasing the last one frees the pool.
+     */
+    static void RetainFramePool();
+    static void ReleaseFramePool();
+
 private:
     void SetFrameCaps(GstCaps *newCaps);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -241,10 +241,10 @@ final class RTImage extends PrismImage implements ResourceFactoryListener {
         return pixelBuffer;
     }
 
-    // This method is called from native [ImageBufferData::update]
-    // while lazy painting procedure
+    // This method is called from native [ImageBufferJavaBackend::update]
+    // with the rectangle of the pixel buffer that has been modified
     @Override
-    protected void drawPixelBuffer() {
+    protected void drawPixelBuffer(int x, int y, int w, int h) {
         PrismInvoker.invokeOnRenderThread(new Runnable() {
             @Override
             public void run() {
@@ -257,9 +257,12 @@ final class RTImage extends PrismImage implements ResourceFactoryListener {
                             pixelBuffer,
                             width,
                             height);
+                    if (x != 0 || y != 0 || w != width || h != height) {
+                        img = img.createSubImage(x, y, w, h);
+                    }
                     Texture txt = g.getResourceFactory().createTexture(img, Texture.Usage.DEFAULT, Texture.WrapMode.CLAMP_NOT_NEEDED);
-                    g.clear();
-                    g.drawTexture(txt, 0, 0, width, height);
+                    g.setCompositeMode(CompositeMode.SRC);
+                    g.drawTexture(txt, x, y, x + w, y + h, 0, 0, w, h);
                     txt.dispose();
                 }
             }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -37,8 +37,13 @@ import com.sun.javafx.scene.text.TextLayout;
 import com.sun.prism.GraphicsPipeline;
 import com.sun.webkit.graphics.WCFont;
 import com.sun.webkit.graphics.WCTextRun;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Arrays;
 import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.WeakHashMap;
 
 final class WCFontImpl extends WCFont {
     private final static PlatformLogger log =
@@ -81,6 +86,15 @@ final class WCFontImpl extends WCFont {
                 : null;
     }
 
+    /**
+     * Glyph codes of the pages WebCore has looked up, per font resource.
+     * The mapping does not depend on the size, so all the sizes of a face
+     * share it, and pages needing a text layout are laid out only once.
+     */
+    private static final Map<FontResource, Map<String, int[]>> GLYPH_CODES =
+            new WeakHashMap<>();
+    private static final int MAX_CACHED_GLYPH_PAGES = 64;
+
     private final PGFont font;
 
     WCFontImpl(PGFont font) {
@@ -115,6 +129,27 @@ final class WCFontImpl extends WCFont {
         return new float[]{bb[0], -bb[3], bb[2], bb[3] - bb[1]};
     }
 
+    @Override public void getGlyphWidths(int firstGlyph, float[] widths) {
+        FontResource resource = getFontStrike().getFontResource();
+        float size = font.getSize();
+        for (int i = 0; i < widths.length; i++) {
+            widths[i] = resource.getAdvance(firstGlyph + i, size);
+        }
+    }
+
+    @Override public void getGlyphBoundingBoxes(int firstGlyph, float[] boxes) {
+        FontResource resource = getFontStrike().getFontResource();
+        float size = font.getSize();
+        float[] bb = new float[4];
+        for (int i = 0; i < boxes.length / 4; i++) {
+            bb = resource.getGlyphBoundingBox(firstGlyph + i, size, bb);
+            boxes[4 * i] = bb[0];
+            boxes[4 * i + 1] = -bb[3];
+            boxes[4 * i + 2] = bb[2];
+            boxes[4 * i + 3] = bb[3] - bb[1];
+        }
+    }
+
     @Override public float getXHeight() {
         return getFontStrike().getMetrics().getXHeight();
     }
@@ -128,6 +163,29 @@ final class WCFontImpl extends WCFont {
         return false;
     }
 
+    @Override public void getGlyphCodes(ByteBuffer chars, ByteBuffer glyphs, int length) {
+        char[] array = new char[length];
+        chars.order(ByteOrder.nativeOrder()).asCharBuffer().get(array);
+        String key = new String(array);
+        FontResource resource = getFontStrike().getFontResource();
+        int[] codes;
+        synchronized (GLYPH_CODES) {
+            Map<String, int[]> pages = GLYPH_CODES.computeIfAbsent(resource,
+                    r -> new LinkedHashMap<String, int[]>(16, 0.75f, true) {
+                        @Override
+                        protected boolean removeEldestEntry(Map.Entry<String, int[]> eldest) {
+                            return size() > MAX_CACHED_GLYPH_PAGES;
+                        }
+                    });
+            codes = pages.get(key);
+            if (codes == null) {
+                codes = getGlyphCodes(array);
+                pages.put(key, codes);
+            }
+        }
+        glyphs.order(ByteOrder.nativeOrder()).asIntBuffer().put(codes);
+    }
+
     @Override public int[] getGlyphCodes(char[] chars) {
         int[] glyphs = new int[chars.length];
         CharToGlyphMapper mapper = getFontStrike().getFontResource().getGlyphMapper();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -158,8 +158,12 @@ public final class WebPage {
                     "com.sun.webkit.useCSS3D", "false"));
             useCSS3D = useCSS3D && Platform.isSupported(ConditionalFeature.SCENE3D);
 
+            // Edge length of the tiles composited layers are split into.
+            final int tileSize = Integer.getInteger(
+                    "com.sun.webkit.tileSize", 512);
+
             // Initialize WTF, WebCore and JavaScriptCore.
-            twkInitWebCore(useJIT, useDFGJIT, useCSS3D);
+            twkInitWebCore(useJIT, useDFGJIT, useCSS3D, tileSize);
 
             // Inform the native webkit code when either the JVM or the
             // JavaFX runtime is being shutdown
@@ -2621,7 +2625,7 @@ public final class WebPage {
     // Native methods
     // *************************************************************************
 
-    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useCSS3D);
+    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useCSS3D, int tileSize);
     private native long twkCreatePage(boolean editable);
     private native void twkInit(long pPage, boolean usePlugins, float devicePixelScale);
     private native void twkDestroyPage(long pPage);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -86,6 +86,7 @@ public final class GraphicsDecoder  {
     @Native public final static int SET_MITER_LIMIT        = 54;
     @Native public final static int SET_TEXT_MODE          = 55;
     @Native public final static int SET_PERSPECTIVE_TRANSFORM = 56;
+    @Native public final static int DRAWSTRING_INLINE      = 57;
 
     private final static PlatformLogger log =
             PlatformLogger.getLogger(GraphicsDecoder.class.getName());
@@ -310,6 +311,9 @@ public final class GraphicsDecoder  {
                         buf.getFloat(),
                         buf.getFloat());
                     break;
+                case DRAWSTRING_INLINE:
+                    drawStringInline(gm, gc, buf);
+                    break;
                 case DRAWWIDGET:
                     gc.drawWidget((RenderTheme)(gm.getRef(buf.getInt())),
                         gm.getRef(buf.getInt()), buf.getInt(), buf.getInt());
@@ -448,6 +452,20 @@ public final class GraphicsDecoder  {
         }
     }
 
+    private static void drawStringInline(WCGraphicsManager gm, WCGraphicsContext gc, ByteBuffer buf) {
+        WCFont font = (WCFont) gm.getRef(buf.getInt());
+        float x = buf.getFloat();
+        float y = buf.getFloat();
+        int count = buf.getInt();
+        int[] glyphs = new int[count];
+        buf.asIntBuffer().get(glyphs);
+        buf.position(buf.position() + count * Integer.BYTES);
+        float[] advances = new float[count];
+        buf.asFloatBuffer().get(advances);
+        buf.position(buf.position() + count * Float.BYTES);
+        gc.drawString(font, glyphs, advances, x, y);
+    }
+
     private static boolean getBoolean(ByteBuffer buf) {
         return 0 != buf.getInt();
     }
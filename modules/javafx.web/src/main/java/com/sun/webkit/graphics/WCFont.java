@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,9 @@
 
 package com.sun.webkit.graphics;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
 public abstract class WCFont extends Ref {
 
     public abstract Object getPlatformFont();
@@ -35,12 +38,57 @@ public abstract class WCFont extends Ref {
 
     public abstract int[] getGlyphCodes(char[] chars);
 
+    /**
+     * Maps {@code length} characters stored in {@code chars} to glyph codes
+     * and stores one glyph code per character in {@code glyphs}. Both
+     * buffers are direct and in the native byte order.
+     * NB: This method is called from native code!
+     *
+     * @param chars the buffer holding the UTF-16 characters to map
+     * @param glyphs the buffer to store the glyph codes
+     * @param length the number of characters to map
+     */
+    public void getGlyphCodes(ByteBuffer chars, ByteBuffer glyphs, int length) {
+        char[] array = new char[length];
+        chars.order(ByteOrder.nativeOrder()).asCharBuffer().get(array);
+        glyphs.order(ByteOrder.nativeOrder()).asIntBuffer().put(getGlyphCodes(array));
+    }
+
     public abstract float getXHeight();
 
     public abstract double getGlyphWidth(int glyph);
 
     public abstract float[] getGlyphBoundingBox(int glyph);
 
+    /**
+     * Fills {@code widths} with the advances of consecutive glyphs
+     * starting at {@code firstGlyph}.
+     * NB: This method is called from native code!
+     *
+     * @param firstGlyph the code of the first glyph
+     * @param widths the array to store one advance per glyph
+     */
+    public void getGlyphWidths(int firstGlyph, float[] widths) {
+        for (int i = 0; i < widths.length; i++) {
+            widths[i] = (float) getGlyphWidth(firstGlyph + i);
+        }
+    }
+
+    /**
+     * Fills {@code boxes} with the bounding boxes of consecutive glyphs
+     * starting at {@code firstGlyph}, four elements per glyph in the
+     * format of {@link #getGlyphBoundingBox}.
+     * NB: This method is called from native code!
+     *
+     * @param firstGlyph the code of the first glyph
+     * @param boxes the array to store four elements per glyph
+     */
+    public void getGlyphBoundingBoxes(int firstGlyph, float[] boxes) {
+        for (int i = 0; i < boxes.length / 4; i++) {
+            System.arraycopy(getGlyphBoundingBox(firstGlyph + i), 0, boxes, 4 * i, 4);
+        }
+    }
+
     /**
      * Returns a hash code value for the object.
      * NB: This method is called from native code!
@@ -53,6 +53,20 @@ public abstract class WCPath<P> extends Ref {
      */
     @Native public static final int RULE_EVENODD = 1;
 
+    /* Operation codes of the packed path representation passed by
+     * the native PathJava to {@link #addOperations}.
+     */
+    @Native public static final int OP_MOVETO    = 0;
+    @Native public static final int OP_LINETO    = 1;
+    @Native public static final int OP_QUADTO    = 2;
+    @Native public static final int OP_CUBICTO   = 3;
+    @Native public static final int OP_ARCTO     = 4;
+    @Native public static final int OP_ARC       = 5;
+    @Native public static final int OP_ELLIPSE   = 6;
+    @Native public static final int OP_RECT      = 7;
+    @Native public static final int OP_CLOSE     = 8;
+    @Native public static final int OP_TRANSFORM = 9;
+
     public abstract void addRect(double x, double y, double w, double h);
 
     public abstract void addEllipse(double x, double y, double w, double h);
@@ -98,6 +112,67 @@ public abstract class WCPath<P> extends Ref {
 
     public abstract WCPathIterator getPathIterator();
 
+    /**
+     * Appends a batch of operations recorded by the native path.
+     * Every element of {@code ops} consumes the number of values
+     * from {@code coords} required by the corresponding method.
+     * NB: This method is called from native code!
+     *
+     * @param ops the operation codes
+     * @param coords the operation arguments
+     */
+    public void addOperations(int[] ops, double[] coords) {
+        int i = 0;
+        for (int op : ops) {
+            switch (op) {
+                case OP_MOVETO:
+                    moveTo(coords[i], coords[i + 1]);
+                    i += 2;
+                    break;
+                case OP_LINETO:
+                    addLineTo(coords[i], coords[i + 1]);
+                    i += 2;
+                    break;
+                case OP_QUADTO:
+                    addQuadCurveTo(coords[i], coords[i + 1], coords[i + 2], coords[i + 3]);
+                    i += 4;
+                    break;
+                case OP_CUBICTO:
+                    addBezierCurveTo(coords[i], coords[i + 1], coords[i + 2],
+                                     coords[i + 3], coords[i + 4], coords[i + 5]);
+                    i += 6;
+                    break;
+                case OP_ARCTO:
+                    addArcTo(coords[i], coords[i + 1], coords[i + 2], coords[i + 3], coords[i + 4]);
+                    i += 5;
+                    break;
+                case OP_ARC:
+                    addArc(coords[i], coords[i + 1], coords[i + 2], coords[i + 3],
+                           coords[i + 4], coords[i + 5] != 0);
+                    i += 6;
+                    break;
+                case OP_ELLIPSE:
+                    addEllipse(coords[i], coords[i + 1], coords[i + 2], coords[i + 3]);
+                    i += 4;
+                    break;
+                case OP_RECT:
+                    addRect(coords[i], coords[i + 1], coords[i + 2], coords[i + 3]);
+                    i += 4;
+                    break;
+                case OP_CLOSE:
+                    closeSubpath();
+                    break;
+                case OP_TRANSFORM:
+                    transform(coords[i], coords[i + 1], coords[i + 2],
+                              coords[i + 3], coords[i + 4], coords[i + 5]);
+                    i += 6;
+                    break;
+                default:
+                    throw new IllegalArgumentException("Unknown path operation: " + op);
+            }
+        }
+    }
+
     public abstract boolean strokeContains(double x, double y,
                                            double thickness, double miterLimit,
                                            int cap, int join, double dashOffset,
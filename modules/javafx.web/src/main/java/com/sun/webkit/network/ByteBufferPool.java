@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -63,6 +63,13 @@ final class ByteBufferPool {
         return new ByteBufferPool(bufferSize);
     }
 
+    /**
+     * Returns the size of the buffers in this pool.
+     */
+    int getBufferSize() {
+        return bufferSize;
+    }
+
     /**
      * Creates a new allocator associated with this pool.
      * The allocator will allow its client to allocate and release
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,9 @@
 
 package com.sun.webkit.network;
 
+import com.sun.javafx.logging.PlatformLogger;
+import com.sun.javafx.logging.PlatformLogger.Level;
+
 import java.io.IOException;
 import java.net.CookieHandler;
 import java.net.URI;
@@ -38,9 +41,60 @@ import java.util.Map;
 
 final class CookieJar {
 
+    private static final PlatformLogger logger =
+            PlatformLogger.getLogger(CookieJar.class.getName());
+
+    /**
+     * Set once the native cookie cache has asked for cookies, that is,
+     * once there is a native cache to invalidate.
+     */
+    private static volatile boolean nativeCacheInUse;
+
+    /**
+     * The default cookie handler seen by the last {@code fwkGet}. Cookies
+     * cached natively came from this handler.
+     */
+    private static volatile CookieHandler lastHandler;
+
+    /**
+     * The longest time, in milliseconds, a result of {@code fwkGet} may be
+     * cached natively. Bounds how long cache hits may miss a change of the
+     * default handler, which is only noticed by {@code fwkGet}.
+     */
+    private static final long CACHE_TIME_TO_LIVE = 2000;
+
     private CookieJar() {
     }
 
+    /**
+     * Drops the cookie strings cached natively. Must be called whenever
+     * the contents of the cookie store may have changed.
+     */
+    static void cookiesChanged() {
+        if (nativeCacheInUse) {
+            twkInvalidateCache();
+            if (logger.isLoggable(Level.FINER)) {
+                logger.finer("Cookie cache invalidated, hits: {0}, misses: {1}",
+                        new Object[] {getCacheHitCount(), getCacheMissCount()});
+            }
+        }
+    }
+
+    /**
+     * Returns the number of cookie lookups served by the native cache.
+     */
+    static long getCacheHitCount() {
+        return nativeCacheInUse ? twkGetCacheHitCount() : 0L;
+    }
+
+    /**
+     * Returns the number of cookie lookups that had to call into
+     * {@code fwkGet}.
+     */
+    static long getCacheMissCount() {
+        return nativeCacheInUse ? twkGetCacheMissCount() : 0L;
+    }
+
     private static void fwkPut(String url, String cookie) {
         @SuppressWarnings("removal")
         CookieHandler handler =
@@ -62,13 +116,36 @@ final class CookieJar {
                 handler.put(uri, headers);
             } catch (IOException e) {
             }
+            // The handler is not necessarily a CookieManager
+            cookiesChanged();
         }
     }
 
-    private static String fwkGet(String url, boolean includeHttpOnlyCookies) {
+    /**
+     * Returns the cookies for the given URL. The time until which the
+     * result may be cached natively is stored in {@code validUntil[0]};
+     * it is left at zero when the default handler is not a
+     * {@link CookieManager}, as changes to other handlers cannot be
+     * tracked, and is otherwise at most {@link #CACHE_TIME_TO_LIVE} ahead,
+     * sooner if one of the cookies expires before.
+     * <p>
+     * Cache hits do not reach {@link CookieManager}, so they neither
+     * notice a new default handler before the result expires nor update
+     * the last access time of the cookies they return. The latter only
+     * affects which cookies are evicted first from a full store.
+     */
+    private static String fwkGet(String url, boolean includeHttpOnlyCookies,
+                                 long[] validUntil)
+    {
+        nativeCacheInUse = true;
         @SuppressWarnings("removal")
         CookieHandler handler =
             AccessController.doPrivileged((PrivilegedAction<CookieHandler>) CookieHandler::getDefault);
+        if (handler != lastHandler) {
+            // Cookies cached from the previous handler no longer apply
+            lastHandler = handler;
+            cookiesChanged();
+        }
         if (handler != null) {
             URI uri = null;
             try {
@@ -80,6 +157,13 @@ final class CookieJar {
                 return null;
             }
 
+            if (handler instanceof CookieManager) {
+                String cookies = ((CookieManager) handler).get(uri, validUntil);
+                validUntil[0] = Math.min(validUntil[0],
+                        System.currentTimeMillis() + CACHE_TIME_TO_LIVE);
+                return cookies != null ? cookies : "";
+            }
+
             Map<String, List<String>> headers = new HashMap<>();
             Map<String, List<String>> val = null;
             try {
@@ -120,4 +204,8 @@ final class CookieJar {
                 uri.getRawSchemeSpecificPart(),
                 uri.getRawFragment());
     }
+
+    private static native void twkInvalidateCache();
+    private static native long twkGetCacheHitCount();
+    private static native long twkGetCacheMissCount();
 }
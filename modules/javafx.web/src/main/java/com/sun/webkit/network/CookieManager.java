@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -94,6 +94,19 @@ public final class CookieManager extends CookieHandler {
      * Returns the cookie string for a given URI.
      */
     private String get(URI uri) {
+        return get(uri, null);
+    }
+
+    /**
+     * Returns the cookie string for a given URI. If {@code validUntil} is
+     * not {@code null}, its first element is set to the time, in
+     * milliseconds since the epoch, at which the first of the returned
+     * cookies expires, or to {@code Long.MAX_VALUE} if none of them does.
+     */
+    String get(URI uri, long[] validUntil) {
+        if (validUntil != null) {
+            validUntil[0] = Long.MAX_VALUE;
+        }
         String host = uri.getHost();
         if (host == null || host.length() == 0) {
             logger.finest("Null or empty URI host, returning null");
@@ -115,6 +128,10 @@ public final class CookieManager extends CookieHandler {
 
         StringBuilder sb = new StringBuilder();
         for (Cookie cookie : cookieList) {
+            if (validUntil != null) {
+                validUntil[0] = Math.min(validUntil[0],
+                        cookie.getExpiryTime());
+            }
             if (sb.length() > 0) {
                 sb.append("; ");
             }
@@ -231,6 +248,7 @@ public final class CookieManager extends CookieHandler {
 
             store.put(cookie);
         }
+        CookieJar.cookiesChanged();
 
         logger.finest("Stored: {0}", cookie);
     }
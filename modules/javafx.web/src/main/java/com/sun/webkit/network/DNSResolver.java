@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit.network;
+
+import com.sun.javafx.logging.PlatformLogger;
+import com.sun.javafx.logging.PlatformLogger.Level;
+
+import java.net.InetAddress;
+import java.net.Proxy;
+import java.net.ProxySelector;
+import java.net.URI;
+import java.net.UnknownHostException;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
+import java.security.Security;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.function.Consumer;
+import java.util.function.LongSupplier;
+
+/**
+ * Resolves host names on a small pool of background threads on behalf of
+ * WebCore's {@code DNSResolveQueue}. Prefetching warms the JVM's own
+ * {@link InetAddress} cache, which is what the loaders consult when they
+ * connect. Results are also remembered here so that repeated prefetches of
+ * the same host do not occupy the pool.
+ */
+final class DNSResolver {
+
+    private static final PlatformLogger logger =
+            PlatformLogger.getLogger(DNSResolver.class.getName());
+
+    /**
+     * Looks up the addresses of a host.
+     */
+    interface Lookup {
+        InetAddress[] lookup(String host) throws UnknownHostException;
+    }
+
+    /**
+     * The maximum number of concurrent lookups.
+     */
+    private static final int THREAD_POOL_SIZE = 4;
+
+    /**
+     * The maximum number of lookups waiting for a thread.
+     */
+    private static final int MAX_QUEUED_LOOKUPS = 64;
+
+    /**
+     * The thread pool keep alive time.
+     */
+    private static final long THREAD_POOL_KEEP_ALIVE_TIME = 10000L;
+
+    /**
+     * The maximum number of cached host names.
+     */
+    private static final int MAX_CACHED_HOSTS = 256;
+
+    /**
+     * The default TTLs, in seconds, of successful and failed lookups. They
+     * match the defaults of the "networkaddress.cache.ttl" and
+     * "networkaddress.cache.negative.ttl" security properties.
+     */
+    private static final long DEFAULT_TTL = 30;
+    private static final long DEFAULT_NEGATIVE_TTL = 10;
+
+    private static final URI PROXY_PROBE_URI = URI.create("http://example.com/");
+
+    private static final DNSResolver instance = new DNSResolver(
+            InetAddress::getAllByName, System::nanoTime,
+            securityTTL("networkaddress.cache.ttl", DEFAULT_TTL),
+            securityTTL("networkaddress.cache.negative.ttl", DEFAULT_NEGATIVE_TTL));
+
+    private static final class Entry {
+        private final String[] addresses;
+        private final long expiresAt;
+
+        private Entry(String[] addresses, long expiresAt) {
+            this.addresses = addresses;
+            this.expiresAt = expiresAt;
+        }
+    }
+
+    private final Lookup lookup;
+    private final LongSupplier clock;
+    private final long ttl;
+    private final long negativeTtl;
+    private final ThreadPoolExecutor threadPool;
+    private final Map<String, Entry> cache = new ConcurrentHashMap<>();
+
+    private final LongAdder hits = new LongAdder();
+    private final LongAdder misses = new LongAdder();
+    private final LongAdder lookups = new LongAdder();
+    private final LongAdder failures = new LongAdder();
+    private final LongAdder lookupNanos = new LongAdder();
+
+    /**
+     * Creates a resolver.
+     *
+     * @param lookup the name service to query
+     * @param clock the source of the current time in nanoseconds
+     * @param ttl how long successful lookups are cached, in nanoseconds
+     * @param negativeTtl how long failed lookups are cached, in nanoseconds
+     */
+    DNSResolver(Lookup lookup, LongSupplier clock, long ttl, long negativeTtl) {
+        this.lookup = lookup;
+        this.clock = clock;
+        this.ttl = ttl;
+        this.negativeTtl = negativeTtl;
+        threadPool = new ThreadPoolExecutor(
+                THREAD_POOL_SIZE,
+                THREAD_POOL_SIZE,
+                THREAD_POOL_KEEP_ALIVE_TIME,
+                TimeUnit.MILLISECONDS,
+                new LinkedBlockingQueue<>(MAX_QUEUED_LOOKUPS),
+                new DNSResolverThreadFactory());
+        threadPool.allowCoreThreadTimeOut(true);
+    }
+
+    static DNSResolver getInstance() {
+        return instance;
+    }
+
+    /**
+     * Resolves a host name in the background, if its addresses are not
+     * already cached. {@code done} is always called once, possibly on the
+     * calling thread.
+     */
+    void prefetch(String host, Runnable done) {
+        resolve(host, addresses -> done.run());
+    }
+
+    /**
+     * Resolves a host name. {@code done} is called once with the textual
+     * addresses of the host, or with {@code null} if it cannot be resolved,
+     * possibly on the calling thread.
+     */
+    void resolve(String host, Consumer<String[]> done) {
+        Entry entry = cache.get(host);
+        if (entry != null && entry.expiresAt - clock.getAsLong() > 0) {
+            hits.increment();
+            done.accept(entry.addresses);
+            return;
+        }
+        misses.increment();
+        try {
+            threadPool.execute(() -> done.accept(lookup(host)));
+        } catch (RejectedExecutionException ex) {
+            logger.finest("Too many pending lookups, dropping {0}", host);
+            done.accept(null);
+        }
+    }
+
+    private String[] lookup(String host) {
+        long start = clock.getAsLong();
+        String[] addresses = null;
+        try {
+            @SuppressWarnings("removal")
+            InetAddress[] result = AccessController.doPrivileged(
+                    (PrivilegedAction<InetAddress[]>) () -> {
+                try {
+                    return lookup.lookup(host);
+                } catch (UnknownHostException ex) {
+                    return null;
+                }
+            });
+            if (result != null) {
+                addresses = new String[result.length];
+                for (int i = 0; i < result.length; i++) {
+                    addresses[i] = result[i].getHostAddress();
+                }
+            }
+        } catch (SecurityException ex) {
+            logger.finest("Lookup of " + host + " not permitted", ex);
+        }
+
+        long now = clock.getAsLong();
+        lookups.increment();
+        lookupNanos.add(now - start);
+        if (addresses == null) {
+            failures.increment();
+        }
+        if (cache.size() >= MAX_CACHED_HOSTS) {
+            cache.values().removeIf(e -> e.expiresAt - now <= 0);
+            if (cache.size() >= MAX_CACHED_HOSTS) {
+                cache.clear();
+            }
+        }
+        cache.put(host, new Entry(addresses,
+                now + (addresses != null ? ttl : negativeTtl)));
+
+        if (logger.isLoggable(Level.FINEST)) {
+            logger.finest("Resolved {0} in {1} ms, hits: {2}, misses: {3}",
+                    new Object[] {host, (now - start) / 1000000L,
+                    getHitCount(), getMissCount()});
+        }
+        return addresses;
+    }
+
+    /**
+     * Returns the number of requests served from the cache.
+     */
+    long getHitCount() {
+        return hits.sum();
+    }
+
+    /**
+     * Returns the number of requests that needed a lookup.
+     */
+    long getMissCount() {
+        return misses.sum();
+    }
+
+    /**
+     * Returns the number of lookups that failed.
+     */
+    long getFailureCount() {
+        return failures.sum();
+    }
+
+    /**
+     * Returns the average duration of completed lookups, in nanoseconds.
+     */
+    long getAverageLookupNanos() {
+        long count = lookups.sum();
+        return count > 0 ? lookupNanos.sum() / count : 0L;
+    }
+
+    /**
+     * Reads a TTL in seconds from a security property and returns it in
+     * nanoseconds. Negative values, which mean "cache forever", are
+     * capped to a day.
+     */
+    private static long securityTTL(String name, long defaultValue) {
+        @SuppressWarnings("removal")
+        String value = AccessController.doPrivileged(
+                (PrivilegedAction<String>) () -> Security.getProperty(name));
+        long seconds = defaultValue;
+        if (value != null) {
+            try {
+                seconds = Long.parseLong(value.trim());
+            } catch (NumberFormatException ex) {
+                logger.finest("Invalid value of " + name, ex);
+            }
+        }
+        if (seconds < 0) {
+            seconds = TimeUnit.DAYS.toSeconds(1);
+        }
+        return TimeUnit.SECONDS.toNanos(seconds);
+    }
+
+    private static boolean fwkIsUsingProxy() {
+        @SuppressWarnings("removal")
+        ProxySelector selector = AccessController.doPrivileged(
+                (PrivilegedAction<ProxySelector>) ProxySelector::getDefault);
+        if (selector == null) {
+            return false;
+        }
+        try {
+            List<Proxy> proxies = selector.select(PROXY_PROBE_URI);
+            for (Proxy proxy : proxies) {
+                if (proxy.type() != Proxy.Type.DIRECT) {
+                    return true;
+                }
+            }
+        } catch (RuntimeException ex) {
+            logger.finest("Proxy selection failed", ex);
+            return true;
+        }
+        return false;
+    }
+
+    private static void fwkPrefetch(String host) {
+        instance.prefetch(host, DNSResolver::twkDidPrefetch);
+    }
+
+    private static void fwkResolve(String host, long identifier) {
+        instance.resolve(host,
+                addresses -> twkDidResolve(identifier, addresses));
+    }
+
+    private static native void twkDidPrefetch();
+    private static native void twkDidResolve(long identifier,
+                                             String[] addresses);
+
+    private static final class DNSResolverThreadFactory
+            implements ThreadFactory
+    {
+        private final ThreadGroup group;
+        private final AtomicInteger index = new AtomicInteger(1);
+
+        private DNSResolverThreadFactory() {
+            @SuppressWarnings("removal")
+            SecurityManager sm = System.getSecurityManager();
+            group = (sm != null) ? sm.getThreadGroup()
+                    : Thread.currentThread().getThreadGroup();
+        }
+
+        @Override
+        public Thread newThread(Runnable r) {
+            Thread t = new Thread(group, r, "DNSResolver-"
+                    + index.getAndIncrement());
+            t.setDaemon(true);
+            if (t.getPriority() != Thread.NORM_PRIORITY) {
+                t.setPriority(Thread.NORM_PRIORITY);
+            }
+            return t;
+        }
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,12 +25,15 @@
 
 package com.sun.webkit.network;
 
+import com.sun.webkit.Disposer;
+import com.sun.webkit.DisposerRecord;
 import java.io.BufferedInputStream;
 import java.io.ByteArrayInputStream;
 import java.io.File;
 import java.io.FileInputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.ByteBuffer;
 
 /**
  * A form data element, such as a byte array or a local file.
@@ -106,12 +109,30 @@ abstract class FormDataElement {
     }
 
     /**
-     * Creates a new FormDataElement from a file.
+     * Creates a new FormDataElement from native memory. The element keeps
+     * the native form data alive until it becomes unreachable.
      */
-    private static FormDataElement fwkCreateFromFile(String fileName) {
-        return new FileElement(fileName);
+    private static FormDataElement fwkCreateFromByteBuffer(
+            ByteBuffer byteBuffer, long data)
+    {
+        FormDataElement element = new ByteBufferElement(byteBuffer);
+        Disposer.addRecord(element, new FormDataDisposer(data));
+        return element;
     }
 
+    /**
+     * Creates a new FormDataElement from a range of a file. A negative
+     * {@code length} stands for the rest of the file.
+     */
+    private static FormDataElement fwkCreateFromFile(String fileName,
+                                                     long start,
+                                                     long length)
+    {
+        return new FileElement(fileName, start, length);
+    }
+
+    private static native void twkReleaseFormData(long data);
+
     /**
      * A form data element based on a byte array.
      */
@@ -137,26 +158,178 @@ abstract class FormDataElement {
     }
 
     /**
-     * A form data element based on a file.
+     * A form data element based on a direct byte buffer that maps
+     * native memory. The content is copied out in the chunks the loader
+     * asks for, and never held on the Java heap as a whole.
+     */
+    private static final class ByteBufferElement extends FormDataElement {
+
+        private final ByteBuffer byteBuffer;
+
+
+        private ByteBufferElement(ByteBuffer byteBuffer) {
+            this.byteBuffer = byteBuffer;
+        }
+
+
+        @Override
+        protected InputStream createInputStream() {
+            return new ByteBufferInputStream(byteBuffer.duplicate());
+        }
+
+        @Override
+        protected long doGetSize() {
+            return byteBuffer.capacity();
+        }
+
+        /**
+         * An input stream over the buffer. Being an inner class, it keeps
+         * the element, and so the native memory, alive while it is read.
+         */
+        private final class ByteBufferInputStream extends InputStream {
+
+            private final ByteBuffer buffer;
+
+
+            private ByteBufferInputStream(ByteBuffer buffer) {
+                this.buffer = buffer;
+            }
+
+
+            @Override
+            public int read() {
+                return buffer.hasRemaining() ? buffer.get() & 0xff : -1;
+            }
+
+            @Override
+            public int read(byte[] b, int off, int len) {
+                if (len == 0) {
+                    return 0;
+                }
+                if (!buffer.hasRemaining()) {
+                    return -1;
+                }
+                int count = Math.min(len, buffer.remaining());
+                buffer.get(b, off, count);
+                return count;
+            }
+
+            @Override
+            public long skip(long n) {
+                int count = (int) Math.max(0, Math.min(n, buffer.remaining()));
+                buffer.position(buffer.position() + count);
+                return count;
+            }
+
+            @Override
+            public int available() {
+                return buffer.remaining();
+            }
+        }
+    }
+
+    /**
+     * Drops the reference a {@code ByteBufferElement} holds to the native
+     * form data. Disposal runs on the event thread.
+     */
+    private static final class FormDataDisposer implements DisposerRecord {
+
+        private long data;
+
+
+        private FormDataDisposer(long data) {
+            this.data = data;
+        }
+
+
+        @Override
+        public void dispose() {
+            if (data != 0) {
+                twkReleaseFormData(data);
+                data = 0;
+            }
+        }
+    }
+
+    /**
+     * A form data element based on a file or a range of a file.
      */
     private static final class FileElement extends FormDataElement {
 
         private final File file;
+        private final long start;
+        private final long length;
 
 
-        private FileElement(String filename) {
+        private FileElement(String filename, long start, long length) {
             file = new File(filename);
+            this.start = Math.max(0, start);
+            this.length = length;
         }
 
 
         @Override
         protected InputStream createInputStream() throws IOException {
-            return new BufferedInputStream(new FileInputStream(file));
+            FileInputStream in = new FileInputStream(file);
+            if (start > 0) {
+                in.getChannel().position(start);
+            }
+            return new BufferedInputStream(length < 0
+                    ? in : new BoundedInputStream(in, length));
         }
 
         @Override
         protected long doGetSize() {
-            return file.length();
+            long available = Math.max(0, file.length() - start);
+            return length < 0 ? available : Math.min(length, available);
+        }
+    }
+
+    /**
+     * An input stream that ends after a given number of bytes.
+     */
+    private static final class BoundedInputStream extends InputStream {
+
+        private final InputStream in;
+        private long remaining;
+
+
+        private BoundedInputStream(InputStream in, long remaining) {
+            this.in = in;
+            this.remaining = remaining;
+        }
+
+
+        @Override
+        public int read() throws IOException {
+            if (remaining <= 0) {
+                return -1;
+            }
+            int b = in.read();
+            if (b >= 0) {
+                remaining--;
+            }
+            return b;
+        }
+
+        @Override
+        public int read(byte[] b, int off, int len) throws IOException {
+            if (len == 0) {
+                return 0;
+            }
+            if (remaining <= 0) {
+                return -1;
+            }
+            int count = in.read(b, off, (int) Math.min(len, remaining));
+            if (count > 0) {
+                remaining -= count;
+            }
+            return count;
+        }
+
+        @Override
+        public void close() throws IOException {
+            in.close();
         }
     }
 }
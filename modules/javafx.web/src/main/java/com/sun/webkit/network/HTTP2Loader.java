@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2019, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -55,6 +55,7 @@ import java.security.AccessControlException;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import java.time.Duration;
+import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
 import java.util.Locale;
@@ -87,6 +88,11 @@ final class HTTP2Loader extends URLLoaderBase {
     private FormDataElement[] formDataElements;
     private final long data;
     private volatile boolean canceled = false;
+    // Capacity of the native buffers received bytes are copied into
+    private final int receiveBufferSize;
+    // Bytes passed to WebCore by this loader, only touched on the event thread
+    private long bytesInPlace;
+    private long bytesCopied;
 
     private final CompletableFuture<Void> response;
     // Use singleton instance of HttpClient to get the maximum benefits
@@ -98,17 +104,6 @@ final class HTTP2Loader extends URLLoaderBase {
                 .connectTimeout(Duration.ofSeconds(30)) // FIXME: Add a property to control the timeout
                 .cookieHandler(CookieHandler.getDefault())
                 .build());
-    // Singleton instance of direct ByteBuffer to transfer downloaded bytes from
-    // Java to native
-    private static final int DEFAULT_BUFSIZE = 40 * 1024;
-    private final static ByteBuffer BUFFER;
-    static {
-       @SuppressWarnings("removal")
-       int bufSize  = AccessController.doPrivileged(
-                        (PrivilegedAction<Integer>) () ->
-                            Integer.valueOf(System.getProperty("jdk.httpclient.bufsize", Integer.toString(DEFAULT_BUFSIZE))));
-       BUFFER = ByteBuffer.allocateDirect(bufSize);
-    }
 
     /**
      * Creates a new {@code HTTP2Loader}.
@@ -367,6 +362,7 @@ final class HTTP2Loader extends URLLoaderBase {
               long data)
     {
         this.webPage = webPage;
+        this.receiveBufferSize = byteBufferPool.getBufferSize();
         this.asynchronous = asynchronous;
         this.url = url;
         this.method = method;
@@ -510,48 +506,92 @@ final class HTTP2Loader extends URLLoaderBase {
         });
     }
 
-    private ByteBuffer getDirectBuffer(int size) {
-        ByteBuffer dbb = BUFFER;
-        // Though the chance of reaching here is rare, handle the
-        // case by allocating a tmp direct buffer.
-        if (size > dbb.capacity()) {
-            dbb = ByteBuffer.allocateDirect(size);
+    /**
+     * Copies received bytes into native receive buffers, see
+     * {@link URLLoaderBase#twkAllocateReceiveBuffer}, which WebCore then
+     * adopts without another copy. This is the only copy the bytes go
+     * through on their way from the HttpClient to WebCore.
+     */
+    private List<ByteBuffer> copyToReceiveBuffers(final List<ByteBuffer> chunks) {
+        final List<ByteBuffer> blocks = new ArrayList<>();
+        ByteBuffer block = null;
+        for (ByteBuffer chunk : chunks) {
+            while (chunk.hasRemaining()) {
+                if (block == null || !block.hasRemaining()) {
+                    block = twkAllocateReceiveBuffer(receiveBufferSize);
+                    if (block == null) {
+                        releaseReceiveBuffers(blocks);
+                        throw new OutOfMemoryError("Cannot allocate receive buffer");
+                    }
+                    blocks.add(block);
+                }
+                final int count = Math.min(chunk.remaining(), block.remaining());
+                block.put(block.position(), chunk, chunk.position(), count);
+                block.position(block.position() + count);
+                chunk.position(chunk.position() + count);
+            }
         }
-        return dbb.clear();
+        blocks.forEach(ByteBuffer::flip);
+        return blocks;
     }
 
-    private ByteBuffer copyToDirectBuffer(final ByteBuffer bb) {
-        return getDirectBuffer(bb.limit()).put(bb).flip();
+    private static void releaseReceiveBuffers(final List<ByteBuffer> blocks) {
+        blocks.forEach(URLLoaderBase::twkReleaseReceiveBuffer);
     }
 
     // another variant to use from createZIPEncodedBodySubscriber
     private void didReceiveData(final byte[] bytes, int size) {
-        callBackIfNotCanceled(() -> {
-            notifyDidReceiveData(getDirectBuffer(size).put(bytes, 0, size).flip());
-        });
+        didReceiveData(List.of(ByteBuffer.wrap(bytes, 0, size)));
     }
 
     private void didReceiveData(final List<ByteBuffer> bytes) {
-        callBackIfNotCanceled(() -> bytes.stream()
-                                          .map(this::copyToDirectBuffer)
-                                          .forEach(this::notifyDidReceiveData)
-        );
+        final List<ByteBuffer> blocks;
+        try {
+            blocks = copyToReceiveBuffers(bytes);
+        } catch (OutOfMemoryError ex) {
+            // Fail the load and drop whatever is received after this
+            callBackIfNotCanceled(() -> {
+                notifyDidFail(LoadListenerClient.UNKNOWN_ERROR, url, ex.getMessage());
+                canceled = true;
+            });
+            return;
+        }
+        Invoker.getInvoker().invokeOnEventThread(() -> {
+            if (canceled) {
+                releaseReceiveBuffers(blocks);
+            } else {
+                blocks.forEach(this::notifyDidReceiveData);
+            }
+        });
     }
 
     private void notifyDidReceiveData(ByteBuffer byteBuffer) {
         Invoker.getInvoker().checkEventThread();
+        final int remaining = byteBuffer.remaining();
+        // Mostly empty buffers are cheaper to copy than to keep, as in URLLoader
+        final boolean adopt =
+                remaining >= byteBuffer.capacity() / MIN_ADOPTED_FRACTION;
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format(
                     "byteBuffer: [%s], "
                     + "position: [%s], "
                     + "remaining: [%s], "
+                    + "adopt: [%s], "
                     + "data: [0x%016X]",
                     byteBuffer,
                     byteBuffer.position(),
-                    byteBuffer.remaining(),
+                    remaining,
+                    adopt,
                     data));
         }
-        twkDidReceiveData(byteBuffer, byteBuffer.position(), byteBuffer.remaining(), data);
+        if (adopt) {
+            bytesInPlace += remaining;
+            twkDidReceiveBuffer(byteBuffer, byteBuffer.position(), remaining, data);
+        } else {
+            bytesCopied += remaining;
+            twkDidReceiveData(byteBuffer, byteBuffer.position(), remaining, data);
+            twkReleaseReceiveBuffer(byteBuffer);
+        }
     }
 
     private void didFinishLoading() {
@@ -563,6 +603,13 @@ final class HTTP2Loader extends URLLoaderBase {
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format("data: [0x%016X]", data));
         }
+        if (logger.isLoggable(Level.FINE)) {
+            logger.fine(String.format(
+                    "url: [%s], received: [%d] bytes, without copy: [%d]",
+                    url,
+                    bytesInPlace + bytesCopied,
+                    bytesInPlace));
+        }
         twkDidFinishLoading(data);
     }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -57,6 +57,7 @@ import java.security.PrivilegedAction;
 import java.util.List;
 import java.util.Locale;
 import java.util.Map;
+import java.util.concurrent.Semaphore;
 import java.util.zip.GZIPInputStream;
 import java.util.zip.InflaterInputStream;
 import javax.net.ssl.SSLHandshakeException;
@@ -83,6 +84,9 @@ final class URLLoader extends URLLoaderBase implements Runnable {
     private FormDataElement[] formDataElements;
     private final long data;
     private volatile boolean canceled = false;
+    // Bytes passed to WebCore by this loader, only touched on the event thread
+    private long bytesInPlace;
+    private long bytesCopied;
 
 
     /**
@@ -509,8 +513,8 @@ final class URLLoader extends URLLoaderBase implements Runnable {
             }
         }
 
-        ByteBufferAllocator allocator =
-                byteBufferPool.newAllocator(MAX_BUF_COUNT);
+        ReceiveBufferAllocator allocator =
+                new ReceiveBufferAllocator(byteBufferPool.getBufferSize());
         ByteBuffer byteBuffer = null;
         try {
             if (inputStream != null) {
@@ -730,14 +734,26 @@ final class URLLoader extends URLLoaderBase implements Runnable {
     }
 
     private void didReceiveData(final ByteBuffer byteBuffer,
-                                final ByteBufferAllocator allocator)
+                                final ReceiveBufferAllocator allocator)
     {
         callBack(() -> {
             if (!canceled) {
+                int remaining = byteBuffer.remaining();
+                // Mostly empty buffers are cheaper to copy than to keep
+                if (remaining >= byteBuffer.capacity() / MIN_ADOPTED_FRACTION) {
+                    notifyDidReceiveData(
+                            byteBuffer,
+                            byteBuffer.position(),
+                            remaining,
+                            true);
+                    allocator.handedOff();
+                    return;
+                }
                 notifyDidReceiveData(
                         byteBuffer,
                         byteBuffer.position(),
-                        byteBuffer.remaining());
+                        remaining,
+                        false);
             }
             allocator.release(byteBuffer);
         });
@@ -745,20 +761,29 @@ final class URLLoader extends URLLoaderBase implements Runnable {
 
     private void notifyDidReceiveData(ByteBuffer byteBuffer,
                                       int position,
-                                      int remaining)
+                                      int remaining,
+                                      boolean adopt)
     {
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format(
                     "byteBuffer: [%s], "
                     + "position: [%s], "
                     + "remaining: [%s], "
+                    + "adopt: [%s], "
                     + "data: [0x%016X]",
                     byteBuffer,
                     position,
                     remaining,
+                    adopt,
                     data));
         }
-        twkDidReceiveData(byteBuffer, position, remaining, data);
+        if (adopt) {
+            bytesInPlace += remaining;
+            twkDidReceiveBuffer(byteBuffer, position, remaining, data);
+        } else {
+            bytesCopied += remaining;
+            twkDidReceiveData(byteBuffer, position, remaining, data);
+        }
     }
 
     private void didFinishLoading() {
@@ -773,6 +798,13 @@ final class URLLoader extends URLLoaderBase implements Runnable {
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format("data: [0x%016X]", data));
         }
+        if (logger.isLoggable(Level.FINE)) {
+            logger.fine(String.format(
+                    "url: [%s], received: [%d] bytes, without copy: [%d]",
+                    url,
+                    bytesInPlace + bytesCopied,
+                    bytesInPlace));
+        }
         twkDidFinishLoading(data);
     }
 
@@ -892,4 +924,44 @@ final class URLLoader extends URLLoaderBase implements Runnable {
         }
         return url;
     }
+
+    /**
+     * Allocates the native receive buffers this loader fills, see
+     * {@link URLLoaderBase#twkAllocateReceiveBuffer}, and like the
+     * {@link ByteBufferPool} allocators bounds how many are in flight.
+     */
+    private static final class ReceiveBufferAllocator {
+
+        private final Semaphore semaphore = new Semaphore(MAX_BUF_COUNT);
+        private final int bufferSize;
+
+        private ReceiveBufferAllocator(int bufferSize) {
+            this.bufferSize = bufferSize;
+        }
+
+        ByteBuffer allocate() throws InterruptedException {
+            semaphore.acquire();
+            ByteBuffer byteBuffer = twkAllocateReceiveBuffer(bufferSize);
+            if (byteBuffer == null) {
+                semaphore.release();
+                throw new OutOfMemoryError("Cannot allocate receive buffer");
+            }
+            return byteBuffer;
+        }
+
+        /**
+         * Returns a buffer that was not handed to WebCore.
+         */
+        void release(ByteBuffer byteBuffer) {
+            twkReleaseReceiveBuffer(byteBuffer);
+            semaphore.release();
+        }
+
+        /**
+         * Accounts for a buffer WebCore took over.
+         */
+        void handedOff() {
+            semaphore.release();
+        }
+    }
 }
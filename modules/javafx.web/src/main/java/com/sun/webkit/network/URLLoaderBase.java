@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,10 @@ import java.nio.ByteBuffer;
 abstract class URLLoaderBase {
     @Native public static final int ALLOW_UNASSIGNED = java.net.IDN.ALLOW_UNASSIGNED;
 
+    // Receive buffers filled to less than 1/MIN_ADOPTED_FRACTION of their
+    // capacity are copied by WebCore rather than adopted
+    protected static final int MIN_ADOPTED_FRACTION = 4;
+
     /**
      * Cancels the loader.
      */
@@ -61,6 +65,29 @@ abstract class URLLoaderBase {
                                                  int remaining,
                                                  long data);
 
+    /**
+     * Passes the contents of a buffer obtained from
+     * {@link #twkAllocateReceiveBuffer} to WebCore without copying it.
+     * The buffer belongs to WebCore afterwards and must not be used again.
+     */
+    protected static native void twkDidReceiveBuffer(ByteBuffer byteBuffer,
+                                                   int position,
+                                                   int remaining,
+                                                   long data);
+
+    /**
+     * Returns a direct buffer over recycled native memory that can be
+     * handed to {@link #twkDidReceiveBuffer}, or {@code null} if the
+     * memory cannot be allocated.
+     */
+    protected static native ByteBuffer twkAllocateReceiveBuffer(int capacity);
+
+    /**
+     * Returns a buffer from {@link #twkAllocateReceiveBuffer} that was not
+     * handed to WebCore.
+     */
+    protected static native void twkReleaseReceiveBuffer(ByteBuffer byteBuffer);
+
     protected static native void twkDidFinishLoading(long data);
 
     protected static native void twkDidFail(int errorCode,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,6 +28,7 @@ package com.sun.webkit.perf;
 import com.sun.javafx.logging.PlatformLogger;
 import com.sun.webkit.graphics.WCFont;
 import com.sun.webkit.graphics.WCTextRun;
+import java.nio.ByteBuffer;
 
 public final class WCFontPerfLogger extends WCFont {
     private static final PlatformLogger log =
@@ -106,6 +107,27 @@ public final class WCFontPerfLogger extends WCFont {
         return res;
     }
 
+    @Override
+    public void getGlyphCodes(ByteBuffer chars, ByteBuffer glyphs, int length) {
+        logger.resumeCount("GETGLYPHCODES");
+        fnt.getGlyphCodes(chars, glyphs, length);
+        logger.suspendCount("GETGLYPHCODES");
+    }
+
+    @Override
+    public void getGlyphWidths(int firstGlyph, float[] widths) {
+        logger.resumeCount("GETGLYPHWIDTHS");
+        fnt.getGlyphWidths(firstGlyph, widths);
+        logger.suspendCount("GETGLYPHWIDTHS");
+    }
+
+    @Override
+    public void getGlyphBoundingBoxes(int firstGlyph, float[] boxes) {
+        logger.resumeCount("GETGLYPHBOUNDINGBOXES");
+        fnt.getGlyphBoundingBoxes(firstGlyph, boxes);
+        logger.suspendCount("GETGLYPHBOUNDINGBOXES");
+    }
+
     @Override
     public int hashCode() {
         logger.resumeCount("HASH");
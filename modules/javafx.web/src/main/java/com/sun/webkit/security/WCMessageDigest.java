@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2019, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,6 +28,8 @@ package com.sun.webkit.security;
 import com.sun.javafx.webkit.WCMessageDigestImpl;
 import com.sun.webkit.perf.WCMessageDigestPerfLogger;
 import java.nio.ByteBuffer;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
 
 public abstract class WCMessageDigest {
     /**
@@ -43,6 +45,19 @@ public abstract class WCMessageDigest {
         }
     }
 
+    /**
+     * Returns whether WebCore computes digests natively instead of through
+     * this class. Setting the "com.sun.webkit.nativeDigest" system property
+     * to false routes them through {@code java.security.MessageDigest}.
+     * NB: This method is called from native code!
+     */
+    @SuppressWarnings("removal")
+    private static boolean fwkUseNativeDigest() {
+        return Boolean.valueOf(AccessController.doPrivileged(
+                (PrivilegedAction<String>) () -> System.getProperty(
+                        "com.sun.webkit.nativeDigest", "true")));
+    }
+
     /**
      * Update the digest using the specified ByteBuffer.
      */
@@ -228,7 +228,7 @@ void RunLoop::assertIsCurrent() const
 }
 #endif
 
-#if PLATFORM(JAVA)
+#if PLATFORM(JAVA) && !USE(GENERIC_EVENT_LOOP)
 void RunLoop::dispatchFunctionsFromMainThread()
 {
     performWork();
@@ -99,6 +99,13 @@ public:
 #endif
 #if PLATFORM(JAVA)
     WTF_EXPORT_PRIVATE void dispatchFunctionsFromMainThread();
+#if USE(GENERIC_EVENT_LOOP)
+    // The main RunLoop is never run on the Java port, the FX thread runs the
+    // toolkit event loop instead. Its timers are fired by
+    // dispatchFunctionsFromMainThread(), which then reports the fire date of
+    // the earliest pending timer to the scheduler.
+    WTF_EXPORT_PRIVATE void setTimerScheduler(Function<void(MonotonicTime)>&&);
+#endif
 #endif
 
     WTF_EXPORT_PRIVATE static void run();
@@ -280,6 +287,9 @@ private:
     Vector<Status*> m_mainLoops;
     bool m_shutdown { false };
     bool m_pendingTasks { false };
+#if PLATFORM(JAVA)
+    Function<void(MonotonicTime)> m_timerScheduler;
+#endif
 #endif
 
 #if USE(GENERIC_EVENT_LOOP) || USE(WINDOWS_EVENT_LOOP)
@@ -236,6 +236,30 @@ void RunLoop::run()
     RunLoop::current().runImpl(RunMode::Drain);
 }
 
+#if PLATFORM(JAVA)
+void RunLoop::dispatchFunctionsFromMainThread()
+{
+    ASSERT(this == &RunLoop::main());
+
+    // Fire the expired timers and perform the dispatched functions once.
+    runImpl(RunMode::Iterate);
+
+    MonotonicTime nextFireDate = MonotonicTime::infinity();
+    {
+        Locker locker { m_loopLock };
+        if (!m_schedules.isEmpty())
+            nextFireDate = m_schedules.first()->scheduledTimePoint();
+    }
+    if (m_timerScheduler)
+        m_timerScheduler(nextFireDate);
+}
+
+void RunLoop::setTimerScheduler(Function<void(MonotonicTime)>&& scheduler)
+{
+    m_timerScheduler = WTFMove(scheduler);
+}
+#endif
+
 void RunLoop::setWakeUpCallback(WTF::Function<void()>&& function)
 {
     RunLoop::current().m_wakeUpCallback = WTFMove(function);
@@ -263,14 +287,23 @@ void RunLoop::wakeUpWithLock()
     m_pendingTasks = true;
     m_readyToRun.notifyOne();
 
+#if !PLATFORM(JAVA)
     if (m_wakeUpCallback)
         m_wakeUpCallback();
+#endif
 }
 
 void RunLoop::wakeUp()
 {
-    Locker locker { m_loopLock };
-    wakeUpWithLock();
+    {
+        Locker locker { m_loopLock };
+        wakeUpWithLock();
+    }
+#if PLATFORM(JAVA)
+    // The callback calls into Java, so it must not run under m_loopLock.
+    if (m_wakeUpCallback)
+        m_wakeUpCallback();
+#endif
 }
 
 RunLoop::CycleResult RunLoop::cycle(RunLoopMode)
@@ -311,11 +344,17 @@ RunLoop::TimerBase::~TimerBase()
 
 void RunLoop::TimerBase::start(Seconds interval, bool repeating)
 {
-    Locker locker { m_runLoop->m_loopLock };
-    stopWithLock();
-    m_scheduledTask->activate(interval, repeating);
-    m_runLoop->scheduleWithLock(m_scheduledTask.get());
-    m_runLoop->wakeUpWithLock();
+    {
+        Locker locker { m_runLoop->m_loopLock };
+        stopWithLock();
+        m_scheduledTask->activate(interval, repeating);
+        m_runLoop->scheduleWithLock(m_scheduledTask.get());
+        m_runLoop->wakeUpWithLock();
+    }
+#if PLATFORM(JAVA)
+    if (m_runLoop->m_wakeUpCallback)
+        m_runLoop->m_wakeUpCallback();
+#endif
 }
 
 void RunLoop::TimerBase::stopWithLock()
@@ -30,6 +30,8 @@
 #include <wtf/MainThread.h>
 #include <wtf/RunLoop.h>
 
+#include <atomic>
+
 #if OS(UNIX)
 #include <pthread.h>
 #endif
@@ -38,6 +40,10 @@ namespace WTF {
 static JGClass jMainThreadCls;
 static jmethodID fwkScheduleDispatchFunctions;
 
+// Set while a dispatch request is pending on the Java side, so that a burst
+// of wake-ups from other threads costs a single upcall.
+static std::atomic<bool> s_dispatchScheduled { false };
+
 #if OS(UNIX)
 static pthread_t s_mainThread;
 #elif OS(WINDOWS)
@@ -46,11 +52,18 @@ static ThreadIdentifier s_mainThread { 0 };
 
 void scheduleDispatchFunctionsOnMainThread()
 {
+    if (s_dispatchScheduled.exchange(true))
+        return;
+
     AttachThreadAsNonDaemonToJavaEnv autoAttach;
     JNIEnv* env = autoAttach.env();
     if (env) {
         env->CallStaticVoidMethod(jMainThreadCls, fwkScheduleDispatchFunctions);
-        WTF::CheckAndClearException(env);
+        // The request did not reach the Java side, let the next one try again.
+        if (WTF::CheckAndClearException(env))
+            s_dispatchScheduled.store(false);
+    } else {
+        s_dispatchScheduled.store(false);
     }
 }
 
@@ -93,6 +106,13 @@ void initializeMainThreadPlatform()
 #elif OS(WINDOWS)
     s_mainThread = Thread::currentID();
 #endif
+
+#if USE(GENERIC_EVENT_LOOP)
+    // Timers scheduled on the main RunLoop wake it up through this callback.
+    RunLoop::setWakeUpCallback([] {
+        scheduleDispatchFunctionsOnMainThread();
+    });
+#endif
 }
 
 #if OS(UNIX)
@@ -117,6 +137,9 @@ extern "C" {
 JNIEXPORT void JNICALL Java_com_sun_webkit_MainThread_twkScheduleDispatchFunctions
   (JNIEnv*, jobject)
 {
+    // Reset before dispatching, so that functions dispatched meanwhile
+    // schedule a new request.
+    s_dispatchScheduled.store(false);
     RunLoop::main().dispatchFunctionsFromMainThread();
 }
 
@@ -11,6 +11,7 @@ list(APPEND PAL_INCLUDE_DIRECTORIES
 
 list(APPEND PAL_SOURCES
     crypto/java/CryptoDigestJava.cpp
+    crypto/java/SHADigest.cpp
 )
 
 add_definitions(-DSTATICALLY_LINKED_WITH_JavaScriptCore)
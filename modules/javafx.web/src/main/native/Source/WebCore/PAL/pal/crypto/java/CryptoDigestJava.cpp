@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2017, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,6 +26,8 @@
 #include "config.h"
 
 #include "CryptoDigest.h"
+#include "SHADigest.h"
+#include <atomic>
 #include <jni.h>
 #include <wtf/java/JavaEnv.h>
 #include <wtf/java/JavaRef.h>
@@ -86,9 +88,40 @@ jstring toJavaMessageDigestAlgorithm(CryptoDigest::Algorithm algorithm)
     return env->NewStringUTF(algorithmStr);
 }
 
+bool useNativeDigest()
+{
+    enum : int { Undecided, Native, Java };
+    static std::atomic<int> choice { Undecided };
+
+    int current = choice.load();
+    if (current == Native)
+        return true;
+
+    // Threads without a JNIEnv, such as workers, can only hash natively.
+    // They must not decide for the threads that can reach Java.
+    JNIEnv* env = WTF::GetJavaEnv();
+    if (!env)
+        return true;
+    if (current == Java)
+        return false;
+
+    static jmethodID midUseNativeDigest = env->GetStaticMethodID(
+        GetMessageDigestClass(env),
+        "fwkUseNativeDigest",
+        "()Z");
+    ASSERT(midUseNativeDigest);
+    jboolean result = env->CallStaticBooleanMethod(GetMessageDigestClass(env), midUseNativeDigest);
+    if (WTF::CheckAndClearException(env))
+        return true;
+
+    choice.store(result == JNI_TRUE ? Native : Java);
+    return result == JNI_TRUE;
+}
+
 } // namespace CryptoDigestInternal
 
 struct CryptoDigestContext {
+    std::unique_ptr<SHADigest> nativeDigest;
     JGObject jDigest { };
 };
 
@@ -105,6 +138,10 @@ std::unique_ptr<CryptoDigest> CryptoDigest::create(CryptoDigest::Algorithm algor
 {
     using namespace CryptoDigestInternal;
     auto digest = std::unique_ptr<CryptoDigest>(new CryptoDigest);
+    if (useNativeDigest()) {
+        digest->m_context->nativeDigest = makeUnique<SHADigest>(algorithm);
+        return digest;
+    }
     digest->m_context->jDigest = GetMessageDigestInstance(toJavaMessageDigestAlgorithm(algorithm));
     return digest;
 }
@@ -113,6 +150,11 @@ void CryptoDigest::addBytes(const void* input, size_t length)
 {
     using namespace CryptoDigestInternal;
 
+    if (m_context->nativeDigest) {
+        m_context->nativeDigest->addBytes(static_cast<const uint8_t*>(input), length);
+        return;
+    }
+
     JNIEnv* env = WTF::GetJavaEnv();
     if (!m_context->jDigest || !env) {
         return;
@@ -130,6 +172,10 @@ Vector<uint8_t> CryptoDigest::computeHash()
 {
     using namespace CryptoDigestInternal;
 
+    if (m_context->nativeDigest) {
+        return m_context->nativeDigest->computeHash();
+    }
+
     JNIEnv* env = WTF::GetJavaEnv();
     if (!m_context->jDigest || !env) {
         return { };
@@ -0,0 +1,505 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "SHADigest.h"
+
+#if CPU(X86_64) && (COMPILER(GCC_COMPATIBLE) || COMPILER(MSVC))
+#define SHA_DIGEST_X86_SHA_EXTENSIONS 1
+#if COMPILER(MSVC)
+#include <intrin.h>
+#define SHA_DIGEST_TARGET
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA_DIGEST_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
+namespace PAL {
+
+namespace SHADigestInternal {
+
+static const uint32_t sha1InitialState[5] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+static const uint32_t sha224InitialState[8] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+};
+
+static const uint32_t sha256InitialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint64_t sha384InitialState[8] = {
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+};
+
+static const uint64_t sha512InitialState[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+alignas(16) static const uint32_t sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint64_t sha512K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+static inline uint32_t rotl32(uint32_t x, unsigned n) { return (x << n) | (x >> (32 - n)); }
+static inline uint32_t rotr32(uint32_t x, unsigned n) { return (x >> n) | (x << (32 - n)); }
+static inline uint64_t rotr64(uint64_t x, unsigned n) { return (x >> n) | (x << (64 - n)); }
+
+static inline uint32_t loadBigEndian32(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+static inline uint64_t loadBigEndian64(const uint8_t* p)
+{
+    return (uint64_t(loadBigEndian32(p)) << 32) | loadBigEndian32(p + 4);
+}
+
+static inline void storeBigEndian32(uint8_t* p, uint32_t value)
+{
+    p[0] = value >> 24;
+    p[1] = value >> 16;
+    p[2] = value >> 8;
+    p[3] = value;
+}
+
+static inline void storeBigEndian64(uint8_t* p, uint64_t value)
+{
+    storeBigEndian32(p, value >> 32);
+    storeBigEndian32(p + 4, value);
+}
+
+static void sha1Blocks(uint32_t* state, const uint8_t* data, size_t count)
+{
+    for (; count; --count, data += 64) {
+        uint32_t w[80];
+        for (unsigned t = 0; t < 16; ++t)
+            w[t] = loadBigEndian32(data + 4 * t);
+        for (unsigned t = 16; t < 80; ++t)
+            w[t] = rotl32(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for (unsigned t = 0; t < 80; ++t) {
+            uint32_t f, k;
+            if (t < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5a827999;
+            } else if (t < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ed9eba1;
+            } else if (t < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8f1bbcdc;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xca62c1d6;
+            }
+            uint32_t temp = rotl32(a, 5) + f + e + k + w[t];
+            e = d;
+            d = c;
+            c = rotl32(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+}
+
+static void sha256Blocks(uint32_t* state, const uint8_t* data, size_t count)
+{
+    for (; count; --count, data += 64) {
+        uint32_t w[64];
+        for (unsigned t = 0; t < 16; ++t)
+            w[t] = loadBigEndian32(data + 4 * t);
+        for (unsigned t = 16; t < 64; ++t) {
+            uint32_t s0 = rotr32(w[t - 15], 7) ^ rotr32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = rotr32(w[t - 2], 17) ^ rotr32(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (unsigned t = 0; t < 64; ++t) {
+            uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t temp1 = h + s1 + ch + sha256K[t] + w[t];
+            uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t temp2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+static void sha512Blocks(uint64_t* state, const uint8_t* data, size_t count)
+{
+    for (; count; --count, data += 128) {
+        uint64_t w[80];
+        for (unsigned t = 0; t < 16; ++t)
+            w[t] = loadBigEndian64(data + 8 * t);
+        for (unsigned t = 16; t < 80; ++t) {
+            uint64_t s0 = rotr64(w[t - 15], 1) ^ rotr64(w[t - 15], 8) ^ (w[t - 15] >> 7);
+            uint64_t s1 = rotr64(w[t - 2], 19) ^ rotr64(w[t - 2], 61) ^ (w[t - 2] >> 6);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (unsigned t = 0; t < 80; ++t) {
+            uint64_t s1 = rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41);
+            uint64_t ch = (e & f) ^ (~e & g);
+            uint64_t temp1 = h + s1 + ch + sha512K[t] + w[t];
+            uint64_t s0 = rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39);
+            uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint64_t temp2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if defined(SHA_DIGEST_X86_SHA_EXTENSIONS)
+static bool detectSHAExtensions()
+{
+#if COMPILER(MSVC)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool hasSSE41 = info[2] & (1 << 19);
+    bool hasSSSE3 = info[2] & (1 << 9);
+    __cpuidex(info, 7, 0);
+    bool hasSHA = info[1] & (1 << 29);
+#else
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    bool hasSSE41 = ecx & bit_SSE4_1;
+    bool hasSSSE3 = ecx & bit_SSSE3;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    bool hasSHA = ebx & (1 << 29);
+#endif
+    return hasSHA && hasSSE41 && hasSSSE3;
+}
+
+SHA_DIGEST_TARGET static void sha1BlocksSHAExtensions(uint32_t* state, const uint8_t* data, size_t count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1b);
+    __m128i e = _mm_set_epi32(state[4], 0, 0, 0);
+
+    for (; count; --count, data += 64) {
+        __m128i abcdSave = abcd;
+        __m128i eSave = e;
+
+        // Four message words per group of four rounds, keeping the last
+        // four groups around to extend the schedule.
+        __m128i w[4];
+        for (unsigned i = 0; i < 4; ++i)
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteSwap);
+
+        e = _mm_add_epi32(e, w[0]);
+        __m128i previousABCD = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e, 0);
+
+        for (unsigned i = 1; i < 20; ++i) {
+            if (i >= 4)
+                w[i % 4] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w[i % 4], w[(i + 1) % 4]), w[(i + 2) % 4]), w[(i + 3) % 4]);
+            e = _mm_sha1nexte_epu32(previousABCD, w[i % 4]);
+            previousABCD = abcd;
+            switch (i / 5) {
+            case 0:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 0);
+                break;
+            case 1:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 1);
+                break;
+            case 2:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 2);
+                break;
+            default:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 3);
+                break;
+            }
+        }
+
+        e = _mm_sha1nexte_epu32(previousABCD, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = _mm_extract_epi32(e, 3);
+}
+
+SHA_DIGEST_TARGET static void sha256BlocksSHAExtensions(uint32_t* state, const uint8_t* data, size_t count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The instructions keep the state as ABEF and CDGH.
+    __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xb1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8(dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, dcba, 0xf0);
+
+    for (; count; --count, data += 64) {
+        __m128i abefSave = abef;
+        __m128i cdghSave = cdgh;
+
+        __m128i w[4];
+        for (unsigned i = 0; i < 16; ++i) {
+            if (i < 4)
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteSwap);
+            else {
+                __m128i sum = _mm_add_epi32(_mm_sha256msg1_epu32(w[i % 4], w[(i + 1) % 4]), _mm_alignr_epi8(w[(i + 3) % 4], w[(i + 2) % 4], 4));
+                w[i % 4] = _mm_sha256msg2_epu32(sum, w[(i + 3) % 4]);
+            }
+
+            __m128i message = _mm_add_epi32(w[i % 4], _mm_load_si128(reinterpret_cast<const __m128i*>(sha256K + 4 * i)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0e));
+        }
+
+        abef = _mm_add_epi32(abef, abefSave);
+        cdgh = _mm_add_epi32(cdgh, cdghSave);
+    }
+
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+#endif
+
+} // namespace SHADigestInternal
+
+bool SHADigest::hasHardwareSupport()
+{
+#if defined(SHA_DIGEST_X86_SHA_EXTENSIONS)
+    static const bool hasSHAExtensions = SHADigestInternal::detectSHAExtensions();
+    return hasSHAExtensions;
+#else
+    return false;
+#endif
+}
+
+SHADigest::SHADigest(CryptoDigest::Algorithm algorithm)
+    : m_algorithm(algorithm)
+{
+    using namespace SHADigestInternal;
+
+    switch (algorithm) {
+    case CryptoDigest::Algorithm::SHA_1:
+        m_blockSize = 64;
+        m_hashSize = 20;
+        std::copy(std::begin(sha1InitialState), std::end(sha1InitialState), m_state32);
+        break;
+    case CryptoDigest::Algorithm::SHA_224:
+        m_blockSize = 64;
+        m_hashSize = 28;
+        std::copy(std::begin(sha224InitialState), std::end(sha224InitialState), m_state32);
+        break;
+    case CryptoDigest::Algorithm::SHA_256:
+        m_blockSize = 64;
+        m_hashSize = 32;
+        std::copy(std::begin(sha256InitialState), std::end(sha256InitialState), m_state32);
+        break;
+    case CryptoDigest::Algorithm::SHA_384:
+        m_blockSize = 128;
+        m_hashSize = 48;
+        std::copy(std::begin(sha384InitialState), std::end(sha384InitialState), m_state64);
+        break;
+    case CryptoDigest::Algorithm::SHA_512:
+        m_blockSize = 128;
+        m_hashSize = 64;
+        std::copy(std::begin(sha512InitialState), std::end(sha512InitialState), m_state64);
+        break;
+    }
+}
+
+void SHADigest::processBlocks(const uint8_t* data, size_t count)
+{
+    using namespace SHADigestInternal;
+
+    switch (m_algorithm) {
+    case CryptoDigest::Algorithm::SHA_1:
+#if defined(SHA_DIGEST_X86_SHA_EXTENSIONS)
+        if (hasHardwareSupport()) {
+            sha1BlocksSHAExtensions(m_state32, data, count);
+            return;
+        }
+#endif
+        sha1Blocks(m_state32, data, count);
+        return;
+    case CryptoDigest::Algorithm::SHA_224:
+    case CryptoDigest::Algorithm::SHA_256:
+#if defined(SHA_DIGEST_X86_SHA_EXTENSIONS)
+        if (hasHardwareSupport()) {
+            sha256BlocksSHAExtensions(m_state32, data, count);
+            return;
+        }
+#endif
+        sha256Blocks(m_state32, data, count);
+        return;
+    case CryptoDigest::Algorithm::SHA_384:
+    case CryptoDigest::Algorithm::SHA_512:
+        sha512Blocks(m_state64, data, count);
+        return;
+    }
+}
+
+void SHADigest::addBytes(const uint8_t* input, size_t length)
+{
+    m_totalBytes += length;
+
+    if (m_cursor) {
+        size_t toCopy = std::min(length, m_blockSize - m_cursor);
+        memcpy(m_buffer + m_cursor, input, toCopy);
+        m_cursor += toCopy;
+        input += toCopy;
+        length -= toCopy;
+        if (m_cursor < m_blockSize)
+            return;
+        processBlocks(m_buffer, 1);
+        m_cursor = 0;
+    }
+
+    // Whole blocks are hashed straight from the input.
+    size_t blocks = length / m_blockSize;
+    if (blocks) {
+        processBlocks(input, blocks);
+        input += blocks * m_blockSize;
+        length -= blocks * m_blockSize;
+    }
+
+    memcpy(m_buffer, input, length);
+    m_cursor = length;
+}
+
+Vector<uint8_t> SHADigest::computeHash()
+{
+    using namespace SHADigestInternal;
+
+    // Pad with a one bit, zeros and the message length in bits, which takes
+    // the last 8 bytes of a 64-byte block and the last 16 of a 128-byte one.
+    size_t lengthSize = m_blockSize / 8;
+    uint64_t totalBits = m_totalBytes * 8;
+
+    m_buffer[m_cursor++] = 0x80;
+    if (m_cursor > m_blockSize - lengthSize) {
+        memset(m_buffer + m_cursor, 0, m_blockSize - m_cursor);
+        processBlocks(m_buffer, 1);
+        m_cursor = 0;
+    }
+    memset(m_buffer + m_cursor, 0, m_blockSize - 8 - m_cursor);
+    storeBigEndian64(m_buffer + m_blockSize - 8, totalBits);
+    processBlocks(m_buffer, 1);
+    m_cursor = 0;
+
+    Vector<uint8_t> result(m_hashSize);
+    if (m_blockSize == 64) {
+        for (size_t i = 0; i < m_hashSize / 4; ++i)
+            storeBigEndian32(result.data() + 4 * i, m_state32[i]);
+    } else {
+        for (size_t i = 0; i < m_hashSize / 8; ++i)
+            storeBigEndian64(result.data() + 8 * i, m_state64[i]);
+    }
+    return result;
+}
+
+} // namespace PAL
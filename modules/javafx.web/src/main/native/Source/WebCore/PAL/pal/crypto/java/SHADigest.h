@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include "CryptoDigest.h"
+#include <wtf/FastMalloc.h>
+#include <wtf/Vector.h>
+
+namespace PAL {
+
+// Native SHA-1 and SHA-2 digests. SHA-1 and SHA-224/256 use the x86 SHA
+// extensions when the CPU has them; everything else runs portable code.
+class SHADigest {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit SHADigest(CryptoDigest::Algorithm);
+
+    void addBytes(const uint8_t*, size_t);
+    Vector<uint8_t> computeHash();
+
+    static bool hasHardwareSupport();
+
+private:
+    static constexpr size_t maxBlockSize = 128;
+
+    void processBlocks(const uint8_t*, size_t count);
+
+    CryptoDigest::Algorithm m_algorithm;
+    size_t m_blockSize;
+    size_t m_hashSize;
+    union {
+        uint32_t m_state32[8];
+        uint64_t m_state64[8];
+    };
+    uint8_t m_buffer[maxBlockSize];
+    size_t m_cursor { 0 };
+    uint64_t m_totalBytes { 0 };
+};
+
+} // namespace PAL
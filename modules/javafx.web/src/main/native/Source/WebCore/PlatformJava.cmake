@@ -74,6 +74,14 @@ set(WebCore_USER_AGENT_SCRIPTS_DEPENDENCIES ${WEBCORE_DIR}/platform/java/RenderT
 
 add_definitions(-DIMAGEIO=1)
 
+if (USE_SCALABLE_IMAGE_DECODER)
+    include(platform/ImageDecoders.cmake)
+
+    list(APPEND WebCore_SOURCES
+        platform/graphics/java/ImageBackingStoreJava.cpp
+    )
+endif ()
+
 list(APPEND WebCore_LIBRARIES
     ${JAVA_JVM_LIBRARY}
 )
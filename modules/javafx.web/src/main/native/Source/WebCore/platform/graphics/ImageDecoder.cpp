@@ -25,7 +25,7 @@
 
 #include "config.h"
 #include "ImageDecoder.h"
-#if !PLATFORM(JAVA) && (!USE(CG) || USE(AVIF))
+#if (!PLATFORM(JAVA) && (!USE(CG) || USE(AVIF))) || (PLATFORM(JAVA) && USE(SCALABLE_IMAGE_DECODER))
 #include "ScalableImageDecoder.h"
 #endif
 #include <wtf/NeverDestroyed.h>
@@ -115,6 +115,15 @@ RefPtr<ImageDecoder> ImageDecoder::create(FragmentedSharedBuffer& data, const St
 #elif USE(DIRECT2D)
     return ImageDecoderDirect2D::create(data, alphaOption, gammaAndColorProfileOption);
 #elif PLATFORM(JAVA)
+#if USE(SCALABLE_IMAGE_DECODER)
+    // Decode natively when the signature is recognized; anything else still goes through ImageIO.
+    // Wait for enough data to sniff the signature before settling on the ImageIO fallback.
+    static constexpr size_t lengthOfLongestSignature = 14;
+    if (data.size() < lengthOfLongestSignature)
+        return nullptr;
+    if (auto imageDecoder = ScalableImageDecoder::create(data, alphaOption, gammaAndColorProfileOption))
+        return imageDecoder;
+#endif
     return ImageDecoderJava::create(data, alphaOption, gammaAndColorProfileOption);
 #else
     return ScalableImageDecoder::create(data, alphaOption, gammaAndColorProfileOption);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -40,6 +40,25 @@ namespace WebCore {
 void FontCascade::drawGlyphs(GraphicsContext& context, const Font& font, const GlyphBufferGlyph* glyphs,
     const GlyphBufferAdvance* advances, unsigned numGlyphs, const FloatPoint& point, FontSmoothingMode)
 {
+    // Runs that fit into a single queue buffer are encoded inline:
+    // opcode, font, x, y, count, count glyph ids and count advances.
+    int inlineSize = (5 + 2 * numGlyphs) * sizeof(jint);
+    if (inlineSize <= context.platformContext()->rq().capacity()) {
+        RenderingQueue& rq = context.platformContext()->rq().freeSpace(inlineSize);
+        rq  << (jint)com_sun_webkit_graphics_GraphicsDecoder_DRAWSTRING_INLINE
+            << font.platformData().nativeFontData()
+            << (jfloat)point.x()
+            << (jfloat)point.y()
+            << (jint)numGlyphs;
+        for (unsigned i = 0; i < numGlyphs; ++i) {
+            rq << (jint)glyphs[i];
+        }
+        for (unsigned i = 0; i < numGlyphs; ++i) {
+            rq << (jfloat)advances[i].width();
+        }
+        return;
+    }
+
     // we need to call freeSpace() before refIntArr() and refFloatArr(), see RT-19695.
     RenderingQueue& rq = context.platformContext()->rq().freeSpace(24);
 
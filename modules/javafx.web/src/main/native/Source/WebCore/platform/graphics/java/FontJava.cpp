@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -122,6 +122,14 @@ RefPtr<Font> Font::platformCreateScaledFont(const FontDescription&, float scaleF
     return Font::create(*m_platformData.derive(scaleFactor), origin(), Interstitial::No);
 }
 
+// Glyph metrics are requested from WCFont in batches of consecutive glyphs
+// and stored into the GlyphMetricsMap caches of the font, so that laying out
+// text in large scripts does not cost a JNI upcall per glyph. Bounds are
+// more expensive to compute on the Java side and are needed less often,
+// hence the smaller batch.
+static constexpr unsigned glyphWidthBatchSize = 256;
+static constexpr unsigned glyphBoundsBatchSize = 32;
+
 float Font::platformWidthForGlyph(Glyph c) const
 {
     JNIEnv* env = WTF::GetJavaEnv();
@@ -130,14 +138,25 @@ float Font::platformWidthForGlyph(Glyph c) const
     if (!jFont)
         return 0.0f;
 
-    static jmethodID getGlyphWidth_mID = env->GetMethodID(PG_GetFontClass(env),
-        "getGlyphWidth", "(I)D");
-    ASSERT(getGlyphWidth_mID);
+    static jmethodID getGlyphWidths_mID = env->GetMethodID(PG_GetFontClass(env),
+        "getGlyphWidths", "(I[F)V");
+    ASSERT(getGlyphWidths_mID);
 
-    float res = env->CallDoubleMethod(*jFont, getGlyphWidth_mID, (jint)c);
-    WTF::CheckAndClearException(env);
+    Glyph firstGlyph = c - c % glyphWidthBatchSize;
+    JLocalRef<jfloatArray> jWidths(env->NewFloatArray(glyphWidthBatchSize));
+    ASSERT(jWidths);
+    env->CallVoidMethod(*jFont, getGlyphWidths_mID, (jint)firstGlyph, (jfloatArray)jWidths);
+    if (WTF::CheckAndClearException(env))
+        return 0.0f;
 
-    return res;
+    std::array<jfloat, glyphWidthBatchSize> widths;
+    env->GetFloatArrayRegion(jWidths, 0, glyphWidthBatchSize, widths.data());
+    for (unsigned i = 0; i < glyphWidthBatchSize; ++i) {
+        Glyph glyph = firstGlyph + i;
+        if (glyph != c && m_glyphToWidthMap.metricsForGlyph(glyph) == cGlyphSizeUnknown)
+            m_glyphToWidthMap.setMetricsForGlyph(glyph, widths[i]);
+    }
+    return widths[c - firstGlyph];
 }
 
 FloatRect Font::platformBoundsForGlyph(Glyph c) const
@@ -149,15 +168,28 @@ FloatRect Font::platformBoundsForGlyph(Glyph c) const
         return {};
     }
 
-    static jmethodID getGlyphBoundingBox_mID = env->GetMethodID(PG_GetFontClass(env), "getGlyphBoundingBox", "(I)[F");
-    ASSERT(getGlyphBoundingBox_mID);
+    static jmethodID getGlyphBoundingBoxes_mID = env->GetMethodID(PG_GetFontClass(env),
+        "getGlyphBoundingBoxes", "(I[F)V");
+    ASSERT(getGlyphBoundingBoxes_mID);
 
-    jfloatArray boundingBox = (jfloatArray)env->CallObjectMethod(*jFont, getGlyphBoundingBox_mID, (jint)c);
-    jfloat *bBox = env->GetFloatArrayElements(boundingBox,0);
-    auto bb = FloatRect { bBox[0], bBox[1], bBox[2], bBox[3] };
-    env->ReleaseFloatArrayElements(boundingBox, bBox, 0);
-    WTF::CheckAndClearException(env);
-    return bb;
+    Glyph firstGlyph = c - c % glyphBoundsBatchSize;
+    JLocalRef<jfloatArray> jBoxes(env->NewFloatArray(4 * glyphBoundsBatchSize));
+    ASSERT(jBoxes);
+    env->CallVoidMethod(*jFont, getGlyphBoundingBoxes_mID, (jint)firstGlyph, (jfloatArray)jBoxes);
+    if (WTF::CheckAndClearException(env))
+        return {};
+
+    std::array<jfloat, 4 * glyphBoundsBatchSize> boxes;
+    env->GetFloatArrayRegion(jBoxes, 0, 4 * glyphBoundsBatchSize, boxes.data());
+    if (!m_glyphToBoundsMap)
+        m_glyphToBoundsMap = makeUnique<GlyphMetricsMap<FloatRect>>();
+    for (unsigned i = 0; i < glyphBoundsBatchSize; ++i) {
+        Glyph glyph = firstGlyph + i;
+        if (glyph != c && m_glyphToBoundsMap->metricsForGlyph(glyph).width() == cGlyphSizeUnknown)
+            m_glyphToBoundsMap->setMetricsForGlyph(glyph, FloatRect { boxes[4 * i], boxes[4 * i + 1], boxes[4 * i + 2], boxes[4 * i + 3] });
+    }
+    unsigned index = 4 * (c - firstGlyph);
+    return FloatRect { boxes[index], boxes[index + 1], boxes[index + 2], boxes[index + 3] };
 }
 
 Path Font::platformPathForGlyph(Glyph) const
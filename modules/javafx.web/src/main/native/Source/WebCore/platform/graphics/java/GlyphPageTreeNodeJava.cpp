@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -39,28 +39,6 @@ bool GlyphPage::fill(UChar* buffer, unsigned bufferLength)
     if (!jFont)
         return false;
 
-    JLocalRef<jcharArray> jchars(env->NewCharArray(bufferLength));
-    WTF::CheckAndClearException(env); // OOME
-    ASSERT(jchars);
-    if (!jchars)
-        return false;
-
-    jchar* chars = (jchar*)env->GetPrimitiveArrayCritical(jchars, NULL);
-    ASSERT(chars);
-    memcpy(chars, buffer, bufferLength * 2);
-    env->ReleasePrimitiveArrayCritical(jchars, chars, 0);
-
-    static jmethodID mid = env->GetMethodID(PG_GetFontClass(env), "getGlyphCodes", "([C)[I");
-    ASSERT(mid);
-    JLocalRef<jintArray> jglyphs(static_cast<jintArray>(env->CallObjectMethod(*jFont, mid, (jcharArray)jchars)));
-    WTF::CheckAndClearException(env);
-    ASSERT(jglyphs);
-    if (!jglyphs)
-        return false;
-
-    Glyph* glyphs = (Glyph*)env->GetPrimitiveArrayCritical(jglyphs, NULL);
-    ASSERT(glyphs);
-
     unsigned step;  // 1 for BMP, 2 for non-BMP
     if (bufferLength == GlyphPage::size) {
         step = 1;
@@ -68,8 +46,29 @@ bool GlyphPage::fill(UChar* buffer, unsigned bufferLength)
         step = 2;
     } else {
         ASSERT_NOT_REACHED();
+        return false;
     }
 
+    // Pages are only filled on the main thread, so one pair of direct
+    // buffers, wrapped once, is shared by every page of every font.
+    static UChar chars[2 * GlyphPage::size];
+    static Glyph glyphs[2 * GlyphPage::size];
+    static JGObject jchars(env->NewDirectByteBuffer(chars, sizeof(chars)));
+    static JGObject jglyphs(env->NewDirectByteBuffer(glyphs, sizeof(glyphs)));
+    WTF::CheckAndClearException(env); // OOME
+    ASSERT(jchars && jglyphs);
+    if (!jchars || !jglyphs)
+        return false;
+
+    memcpy(chars, buffer, bufferLength * sizeof(UChar));
+
+    static jmethodID mid = env->GetMethodID(PG_GetFontClass(env),
+        "getGlyphCodes", "(Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;I)V");
+    ASSERT(mid);
+    env->CallVoidMethod(*jFont, mid, (jobject)jchars, (jobject)jglyphs, (jint)bufferLength);
+    if (WTF::CheckAndClearException(env))
+        return false;
+
     bool haveGlyphs = false;
     for (unsigned i = 0; i < GlyphPage::size; i++) {
         Glyph glyph = glyphs[i * step];
@@ -79,7 +78,6 @@ bool GlyphPage::fill(UChar* buffer, unsigned bufferLength)
         } else
             setGlyphForIndex(i, 0, this->font().colorGlyphType(glyph));
     }
-    env->ReleasePrimitiveArrayCritical(jglyphs, glyphs, JNI_ABORT);
 
     return haveGlyphs;
 }
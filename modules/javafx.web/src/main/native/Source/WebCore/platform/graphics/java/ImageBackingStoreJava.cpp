@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "ImageBackingStore.h"
+
+#include "ImageJava.h"
+#include "PlatformJavaClasses.h"
+#include "RQRef.h"
+
+namespace WebCore {
+
+// Called from the image decoding queue as well as from the main thread; the
+// generic WorkQueue attaches its threads to the JVM for us.
+PlatformImagePtr ImageBackingStore::image() const
+{
+    JNIEnv* env = WTF::GetJavaEnv();
+    if (!env || !m_pixels)
+        return nullptr;
+
+    static jmethodID midCreateFrame = env->GetMethodID(
+        PG_GetGraphicsManagerClass(env),
+        "createFrame",
+        "(IILjava/nio/ByteBuffer;)Lcom/sun/webkit/graphics/WCImageFrame;");
+    ASSERT(midCreateFrame);
+
+    // The decoded pixels are premultiplied 32-bit ARGB in native byte order,
+    // which is what Prism expects, so the backing store is exposed as is and
+    // copied only once on the Java side.
+    JLObject data(env->NewDirectByteBuffer(
+        const_cast<uint8_t*>(m_pixels->data()),
+        m_pixels->size()));
+    if (WTF::CheckAndClearException(env) || !data)
+        return nullptr;
+
+    JLObject frame(env->CallObjectMethod(
+        PL_GetGraphicsManager(env),
+        midCreateFrame,
+        m_size.width(),
+        m_size.height(),
+        (jobject)data));
+    if (WTF::CheckAndClearException(env) || !frame)
+        return nullptr;
+
+    return ImageJava::create(RQRef::create(frame), nullptr, m_size.width(), m_size.height());
+}
+
+} // namespace WebCore
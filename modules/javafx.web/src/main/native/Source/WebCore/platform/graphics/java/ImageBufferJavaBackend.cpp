@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -140,11 +140,18 @@ Vector<uint8_t> ImageBufferJavaBackend::toDataJava(const String& mimeType, std::
 
 void *ImageBufferJavaBackend::getData() const
 {
+    RenderingQueue& rq = context().platformContext()->rq();
+
+    // Nothing has been drawn since the last read back, so the pixels Java
+    // handed out then are still current.
+    if (m_pixelData && rq.modificationCount() == m_pixelDataModificationCount)
+        return m_pixelData;
+
     JNIEnv* env = WTF::GetJavaEnv();
 
     //RenderQueue need to be processed before pixel buffer extraction.
     //For that purpose it has to be in actual state.
-    context().platformContext()->rq().flushBuffer();
+    rq.flushBuffer();
 
     static jmethodID midGetBGRABytes = env->GetMethodID(
         PG_GetImageClass(env),
@@ -154,24 +161,32 @@ void *ImageBufferJavaBackend::getData() const
 
     jobject pixelBuf = env->CallObjectMethod(getWCImage(), midGetBGRABytes);
     if (WTF::CheckAndClearException(env) || !pixelBuf) {
+        m_pixelData = nullptr;
         return NULL;
     }
     JLObject byteBuffer(pixelBuf);
 
-    return env->GetDirectBufferAddress(byteBuffer);
+    m_pixelBuffer = byteBuffer;
+    m_pixelData = env->GetDirectBufferAddress(byteBuffer);
+    m_pixelDataModificationCount = rq.modificationCount();
+    return m_pixelData;
 }
 
-void ImageBufferJavaBackend::update() const
+void ImageBufferJavaBackend::update(const IntRect& dirtyRect) const
 {
+    if (dirtyRect.isEmpty())
+        return;
+
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID midUpdateByteBuffer = env->GetMethodID(
         PG_GetImageClass(env),
         "drawPixelBuffer",
-        "()V");
+        "(IIII)V");
     ASSERT(midUpdateByteBuffer);
 
-    env->CallObjectMethod(getWCImage(), midUpdateByteBuffer);
+    env->CallVoidMethod(getWCImage(), midUpdateByteBuffer,
+        dirtyRect.x(), dirtyRect.y(), dirtyRect.width(), dirtyRect.height());
     WTF::CheckAndClearException(env);
 }
 
@@ -218,8 +233,17 @@ void ImageBufferJavaBackend::getPixelBuffer(const IntRect& srcRect, void* data,
 void ImageBufferJavaBackend::putPixelBuffer(const PixelBuffer& sourcePixelBuffer, const IntRect& srcRect, const IntPoint& destPoint, AlphaPremultiplication destFormat, void* destination)
 {
     ImageBufferBackend::putPixelBuffer(sourcePixelBuffer, srcRect, destPoint, destFormat, destination);
-    update();
 
+    // Upload only the rectangle the base class wrote to.
+    auto destinationRect = intersection({ IntPoint::zero(), sourcePixelBuffer.size() }, srcRect);
+    destinationRect.moveBy(destPoint);
+    if (srcRect.x() < 0)
+        destinationRect.setX(destinationRect.x() - srcRect.x());
+    if (srcRect.y() < 0)
+        destinationRect.setY(destinationRect.y() - srcRect.y());
+    destinationRect.intersect({ IntPoint::zero(), m_backendSize });
+
+    update(destinationRect);
 }
 
 void ImageBufferJavaBackend::putPixelBuffer(const PixelBuffer& sourcePixelBuffer, const IntRect& srcRect, const IntPoint& destPoint, AlphaPremultiplication destFormat)
@@ -228,8 +252,6 @@ void ImageBufferJavaBackend::putPixelBuffer(const PixelBuffer& sourcePixelBuffer
     if (!data)
         return;
     putPixelBuffer(sourcePixelBuffer, srcRect, destPoint, destFormat, data);
-    update();
-
 }
 
 size_t ImageBufferJavaBackend::calculateMemoryCost(const Parameters& parameters)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -47,7 +47,7 @@ public:
     JLObject getWCImage() const;
     Vector<uint8_t> toDataJava(const String& mimeType, std::optional<double>) override;
     void* getData() const;
-    void update() const;
+    void update(const IntRect& dirtyRect) const;
 
     GraphicsContext& context() const override;
     void flushContext() override;
@@ -76,6 +76,12 @@ protected:
     PlatformImagePtr m_image;
     std::unique_ptr<GraphicsContext> m_context;
     IntSize m_backendSize;
+
+    // The pixels of the image as last read back from Java. They stay valid
+    // until another operation is recorded into the rendering queue.
+    mutable JGObject m_pixelBuffer;
+    mutable void* m_pixelData { nullptr };
+    mutable unsigned m_pixelDataModificationCount { 0 };
 };
 
 } // namespace WebCore
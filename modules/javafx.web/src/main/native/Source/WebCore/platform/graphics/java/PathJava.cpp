@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -39,6 +39,7 @@
 #include <wtf/text/WTFString.h>
 #include <wtf/java/JavaRef.h>
 
+#include "com_sun_webkit_graphics_WCPath.h"
 #include "com_sun_webkit_graphics_WCPathIterator.h"
 
 namespace WebCore {
@@ -98,102 +99,90 @@ RefPtr<RQRef> copyPath(RefPtr<RQRef> p)
     return RQRef::create(ref);
 }
 
-UniqueRef<PathJava> PathJava::create(RefPtr<RQRef>&& platformPath, std::unique_ptr<PathStream>&& elementsStream)
-{
-    return makeUniqueRef<PathJava>(WTFMove(platformPath), WTFMove(elementsStream));
-}
+PathJava::PathJava() = default;
 
-PathJava::PathJava()
-    : m_platformPath(createEmptyPath())
-    , m_elementsStream(PathStream::create().moveToUniquePtr())
+PathJava::PathJava(const PathJava& other)
+    : PathImpl()
+    , m_ops(other.m_ops)
+    , m_coords(other.m_coords)
+    , m_hasCurrentPoint(other.m_hasCurrentPoint)
 {
 }
 
-PathJava::PathJava(RefPtr<RQRef>&& platformPath, std::unique_ptr<PathStream>&& elementsStream)
-    : m_platformPath(WTFMove(platformPath))
-    , m_elementsStream(WTFMove(elementsStream))
+UniqueRef<PathImpl> PathJava::clone() const
 {
-    ASSERT(m_platformPath);
+    return makeUniqueRef<PathJava>(*this);
 }
 
-UniqueRef<PathImpl> PathJava::clone() const
+PlatformPathPtr PathJava::platformPath() const
 {
-    RefPtr<RQRef> platformPathCopy(copyPath(platformPath()));
+    if (!m_platformPath) {
+        m_platformPath = createEmptyPath();
+    }
+    if (m_flushedOpCount == m_ops.size()) {
+        return m_platformPath;
+    }
 
-    auto elementsStream = m_elementsStream ? m_elementsStream->clone().moveToUniquePtr() : nullptr;
+    JNIEnv* env = WTF::GetJavaEnv();
 
-    return PathJava::create(WTFMove(platformPathCopy), std::unique_ptr<PathStream> { downcast<PathStream>(elementsStream.release()) });
-}
+    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addOperations",
+        "([I[D)V");
+    ASSERT(mid);
 
-PlatformPathPtr PathJava::platformPath() const
-{
-    return m_platformPath.get();
+    size_t opCount = m_ops.size() - m_flushedOpCount;
+    JLocalRef<jintArray> ops(env->NewIntArray(opCount));
+    env->SetIntArrayRegion(ops, 0, opCount, m_ops.data() + m_flushedOpCount);
+
+    size_t coordCount = m_coords.size() - m_flushedCoordCount;
+    JLocalRef<jdoubleArray> coords(env->NewDoubleArray(coordCount));
+    env->SetDoubleArrayRegion(coords, 0, coordCount, m_coords.data() + m_flushedCoordCount);
+
+    env->CallVoidMethod(*m_platformPath, mid, (jintArray)ops, (jdoubleArray)coords);
+    WTF::CheckAndClearException(env);
+
+    m_flushedOpCount = m_ops.size();
+    m_flushedCoordCount = m_coords.size();
+    return m_platformPath;
 }
 
 bool PathJava::operator==(const PathImpl& other) const
 {
     if (!is<PathJava>(other))
         return false;
-    return m_platformPath == downcast<PathJava>(other).m_platformPath;
+    auto& otherPath = downcast<PathJava>(other);
+    return m_ops == otherPath.m_ops && m_coords == otherPath.m_coords;
 }
 
-void PathJava::moveTo(const FloatPoint& p)
+void PathJava::appendOperation(jint op, std::initializer_list<jdouble> coords)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "moveTo",
-        "(DD)V");
-    ASSERT(mid);
+    m_ops.append(op);
+    m_coords.append(coords.begin(), coords.size());
+    if (op != com_sun_webkit_graphics_WCPath_OP_CLOSE && op != com_sun_webkit_graphics_WCPath_OP_TRANSFORM) {
+        m_hasCurrentPoint = true;
+    }
+}
 
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+void PathJava::moveTo(const FloatPoint& p)
+{
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_MOVETO, { p.x(), p.y() });
 }
 
 void PathJava::addLineTo(const FloatPoint& p)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addLineTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_LINETO, { p.x(), p.y() });
 }
 
 void PathJava::addQuadCurveTo(const FloatPoint& cp, const FloatPoint& p)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addQuadCurveTo",
-                                            "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)cp.x(), (jdouble)cp.y(), (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_QUADTO, { cp.x(), cp.y(), p.x(), p.y() });
 }
 
 void PathJava::addBezierCurveTo(const FloatPoint& controlPoint1, const FloatPoint& controlPoint2, const FloatPoint& endPoint)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "addBezierCurveTo", "(DDDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)controlPoint1.x(), (jdouble)controlPoint1.y(),
-                        (jdouble)controlPoint2.x(), (jdouble)controlPoint2.y(),
-                        (jdouble)endPoint.x(), (jdouble)endPoint.y());
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_CUBICTO, {
+        controlPoint1.x(), controlPoint1.y(),
+        controlPoint2.x(), controlPoint2.y(),
+        endPoint.x(), endPoint.y() });
 }
 
 static inline float areaOfTriangleFormedByPoints(const FloatPoint& p1, const FloatPoint& p2, const FloatPoint& p3)
@@ -203,23 +192,11 @@ static inline float areaOfTriangleFormedByPoints(const FloatPoint& p1, const Flo
 
 void PathJava::addArcTo(const FloatPoint& p1, const FloatPoint& p2, float radius)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArcTo",
-        "(DDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)p1.x(), (jdouble)p1.y(),
-                        (jdouble)p2.x(), (jdouble)p2.y(), (jdouble)radius);
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_ARCTO, { p1.x(), p1.y(), p2.x(), p2.y(), radius });
 }
 
 void PathJava::addArc(const FloatPoint& p, float radius, float startAngle, float endAngle, RotationDirection direction)
 {
-    ASSERT(m_platformPath);
     bool clockwise = false;
     if (direction == RotationDirection::Counterclockwise) {
         clockwise = true;
@@ -227,16 +204,8 @@ void PathJava::addArc(const FloatPoint& p, float radius, float startAngle, float
         clockwise = false;
     }
 
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArc",
-        "(DDDDDZ)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)p.x(), (jdouble)p.y(),
-        (jdouble)radius, (jdouble)startAngle, (jdouble)endAngle,
-        bool_to_jbool(clockwise));
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_ARC, {
+        p.x(), p.y(), radius, startAngle, endAngle, clockwise ? 1.0 : 0.0 });
 }
 
 void PathJava::addEllipse(const FloatPoint& point, float radiusX, float radiusY, float rotation, float startAngle, float endAngle, RotationDirection direction)
@@ -246,32 +215,12 @@ void PathJava::addEllipse(const FloatPoint& point, float radiusX, float radiusY,
 
 void PathJava::addEllipseInRect(const FloatRect& r)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addEllipse",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)r.x(), (jdouble)r.y(),
-                        (jdouble)r.width(), (jdouble)r.height());
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_ELLIPSE, { r.x(), r.y(), r.width(), r.height() });
 }
 
 void PathJava::addRect(const FloatRect& r)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addRect",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)r.x(), (jdouble)r.y(),
-                              (jdouble)r.width(), (jdouble)r.height());
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_RECT, { r.x(), r.y(), r.width(), r.height() });
 }
 
 void PathJava::addRoundedRect(const FloatRoundedRect& roundedRect, PathRoundedRect::Strategy)
@@ -281,16 +230,7 @@ void PathJava::addRoundedRect(const FloatRoundedRect& roundedRect, PathRoundedRe
 
 void PathJava::closeSubpath()
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "closeSubpath", "()V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid);
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_CLOSE, { });
 }
 
 void PathJava::addPath(const PathJava& path, const AffineTransform& transform)
@@ -333,18 +273,7 @@ bool PathJava::applyElements(const PathElementApplier& applier) const
 
 bool PathJava::isEmpty() const
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                                            "isEmpty", "()Z");
-    ASSERT(mid);
-
-    jboolean res = env->CallBooleanMethod(*m_platformPath, mid);
-    WTF::CheckAndClearException(env);
-
-    return jbool_to_bool(res);
+    return !m_hasCurrentPoint;
 }
 
 FloatPoint PathJava::currentPoint() const
@@ -356,19 +285,10 @@ FloatPoint PathJava::currentPoint() const
 
 bool PathJava::transform(const AffineTransform& transform)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "transform", "(DDDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)transform.a(), (jdouble)transform.b(),
-                        (jdouble)transform.c(), (jdouble)transform.d(),
-                        (jdouble)transform.e(), (jdouble)transform.f());
-    WTF::CheckAndClearException(env);
+    appendOperation(com_sun_webkit_graphics_WCPath_OP_TRANSFORM, {
+        transform.a(), transform.b(),
+        transform.c(), transform.d(),
+        transform.e(), transform.f() });
     return true;
 }
 
@@ -377,15 +297,13 @@ bool PathJava::contains(const FloatPoint &point, WindRule rule) const
     if (isEmpty() || !std::isfinite(point.x()) || !std::isfinite(point.y()))
         return false;
 
-    ASSERT(m_platformPath);
-
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "contains",
         "(IDD)Z");
     ASSERT(mid);
 
-    jboolean res = env->CallBooleanMethod(*m_platformPath, mid, (jint)rule,
+    jboolean res = env->CallBooleanMethod(*platformPath(), mid, (jint)rule,
         (jdouble)point.x(), (jdouble)point.y());
     WTF::CheckAndClearException(env);
 
@@ -394,7 +312,6 @@ bool PathJava::contains(const FloatPoint &point, WindRule rule) const
 
 bool PathJava::strokeContains(const FloatPoint& p, const Function<void(GraphicsContext&)>& strokeStyleApplier) const
 {
-    ASSERT(m_platformPath);
     ASSERT(strokeStyleApplier);
 
     GraphicsContext& gc = scratchContext();
@@ -426,7 +343,7 @@ bool PathJava::strokeContains(const FloatPoint& p, const Function<void(GraphicsC
     JLocalRef<jdoubleArray> dashArray(env->NewDoubleArray(size));
     env->SetDoubleArrayRegion(dashArray, 0, size, dashes.data());
 
-    jboolean res = env->CallBooleanMethod(*m_platformPath, mid, (jdouble)p.x(),
+    jboolean res = env->CallBooleanMethod(*platformPath(), mid, (jdouble)p.x(),
         (jdouble)p.y(), (jdouble) thickness, (jdouble) miterLimit,
         (jint) cap, (jint) join, (jdouble) dashOffset, (jdoubleArray) dashArray);
 
@@ -447,7 +364,8 @@ FloatRect PathJava::boundingRect() const
 
 FloatRect PathJava::strokeBoundingRect(const Function<void(GraphicsContext&)>& strokeStyleApplier) const
 {
-    ASSERT(m_platformPath);
+    if (isEmpty())
+        return FloatRect();
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -455,7 +373,7 @@ FloatRect PathJava::strokeBoundingRect(const Function<void(GraphicsContext&)>& s
             "()Lcom/sun/webkit/graphics/WCRectangle;");
     ASSERT(mid);
 
-    JLObject rect(env->CallObjectMethod(*m_platformPath, mid));
+    JLObject rect(env->CallObjectMethod(*platformPath(), mid));
     WTF::CheckAndClearException(env);
     if (rect) {
         static jfieldID rectxFID = env->GetFieldID(PG_GetRectangleClass(env), "x", "F");
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2023, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -40,10 +40,9 @@ class PathJava final : public PathImpl {
 public:
     static UniqueRef<PathJava> create();
     static UniqueRef<PathJava> create(const PathStream&);
-    static UniqueRef<PathJava> create(RefPtr<RQRef>&&, std::unique_ptr<PathStream>&& = nullptr);
 
     PathJava();
-    PathJava(RefPtr<RQRef>&&, std::unique_ptr<PathStream>&&);
+    PathJava(const PathJava&);
 
     PlatformPathPtr platformPath() const;
 
@@ -87,8 +86,18 @@ private:
     FloatRect fastBoundingRect() const final;
     FloatRect boundingRect() const final;
 
-    RefPtr<RQRef> m_platformPath;
-    std::unique_ptr<PathStream> m_elementsStream;
+    void appendOperation(jint op, std::initializer_list<jdouble> coords);
+
+    // The path is recorded natively in a packed form (operation codes and
+    // their arguments, see WCPath.OP_*). The Java WCPath is only created and
+    // brought up to date, in a single upcall, when platformPath() is needed.
+    Vector<jint> m_ops;
+    Vector<jdouble> m_coords;
+    bool m_hasCurrentPoint { false };
+
+    mutable RefPtr<RQRef> m_platformPath;
+    mutable size_t m_flushedOpCount { 0 };
+    mutable size_t m_flushedCoordCount { 0 };
 };
 
 } // namespace WebCore
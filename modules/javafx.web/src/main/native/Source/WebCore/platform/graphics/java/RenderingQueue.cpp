@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,7 @@
 
 #include "config.h"
 
+#include "Logging.h"
 #include "PlatformJavaClasses.h"
 #include "RenderingQueue.h"
 #include "RQRef.h"
@@ -37,7 +38,12 @@
 
 namespace WebCore {
 
-typedef HashMap<char*, RefPtr<ByteBuffer> > Addr2ByteBuffer;
+struct PooledByteBuffer {
+    RefPtr<ByteBuffer> buffer;
+    RefPtr<ByteBufferPool> pool;
+};
+
+typedef HashMap<char*, PooledByteBuffer> Addr2ByteBuffer;
 
 static Addr2ByteBuffer& getAddr2ByteBuffer()
 {
@@ -45,6 +51,39 @@ static Addr2ByteBuffer& getAddr2ByteBuffer()
     return container.get();
 }
 
+RefPtr<ByteBuffer> ByteBufferPool::take(int size)
+{
+    RefPtr<ByteBuffer> buffer;
+    if (size <= m_capacity && !m_freeList.isEmpty()) {
+        buffer = m_freeList.takeLast();
+        ++m_hits;
+    } else {
+        buffer = ByteBuffer::create(std::max(m_capacity, size));
+        ++m_misses;
+    }
+    m_peakLiveCount = std::max(m_peakLiveCount, ++m_liveCount);
+    return buffer;
+}
+
+void ByteBufferPool::recycle(RefPtr<ByteBuffer>&& buffer)
+{
+    ASSERT(buffer);
+    ASSERT(m_liveCount);
+    --m_liveCount;
+    // Oversized buffers allocated for a single big command are not reused.
+    if (buffer->capacity() != m_capacity || m_freeList.size() >= m_maxCount) {
+        return;
+    }
+    buffer->reset();
+    m_freeList.append(WTFMove(buffer));
+}
+
+void ByteBufferPool::logStatistics() const
+{
+    LOG(PerformanceLogging, "ByteBufferPool %p: capacity %d, hits %zu, misses %zu, live %zu, peak live %zu, free %zu (max %zu)",
+        this, m_capacity, m_hits, m_misses, m_liveCount, m_peakLiveCount, m_freeList.size(), m_maxCount);
+}
+
 /*static*/
 RefPtr<RenderingQueue> RenderingQueue::create(
     const JLObject &jRQ,
@@ -58,6 +97,7 @@ RefPtr<RenderingQueue> RenderingQueue::create(
 }
 
 RenderingQueue& RenderingQueue::freeSpace(int size) {
+    ++m_modificationCount;
     if (m_buffer && !m_buffer->hasFreeSpace(size)) {
         flushBuffer();
         if (m_autoFlush) {
@@ -65,7 +105,7 @@ RenderingQueue& RenderingQueue::freeSpace(int size) {
         }
     }
     if (!m_buffer) {
-        m_buffer = RefPtr<ByteBuffer>(ByteBuffer::create(std::max(m_capacity, size)));
+        m_buffer = m_bufferPool->take(size);
     }
     return *this;
 }
@@ -110,7 +150,7 @@ RenderingQueue& RenderingQueue::flushBuffer() {
     ASSERT(midFwkAddBuffer);
 
     Addr2ByteBuffer &a2bb = getAddr2ByteBuffer();
-    a2bb.set(m_buffer->bufferAddress(), m_buffer);
+    a2bb.set(m_buffer->bufferAddress(), PooledByteBuffer { m_buffer, m_bufferPool.ptr() });
     env->CallVoidMethod(
         getWCRenderingQueue(),
         midFwkAddBuffer,
@@ -131,15 +171,18 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_graphics_WCRenderQueue_twkRelease
     /*
      * This method should be called on the Event thread to synchronize with JavaScript
      * by thread. JavaScript may access resources kept in ByteBuffer::m_refList,
-     * so when a resource is dereferenced (as a result of ByteBuffer destruction)
-     * it should be thread safe.
+     * so when a resource is dereferenced (as a result of ByteBuffer recycling
+     * or destruction) it should be thread safe.
      */
     Addr2ByteBuffer& a2bb = getAddr2ByteBuffer();
     for (int i = 0; i < env->GetArrayLength(bufs); ++i) {
         char *key = (char *)env->GetDirectBufferAddress(
             JLObject(env->GetObjectArrayElement(bufs, i)));
         if (key != 0) {
-            a2bb.remove(key);
+            PooledByteBuffer pooled = a2bb.take(key);
+            if (pooled.buffer && pooled.pool) {
+                pooled.pool->recycle(WTFMove(pooled.buffer));
+            }
         }
     }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -76,6 +76,16 @@ public:
 
     bool isEmpty() { return m_position == 0; }
 
+    int capacity() { return m_capacity; }
+
+    // Drops the content and the resources referenced by the buffer,
+    // so that the underlying memory can be reused for a new batch.
+    void reset() {
+        m_position = 0;
+        m_nio_holder.clear();
+        m_refList.clear();
+    }
+
     ~ByteBuffer() {
         delete[] m_buffer;
     }
@@ -94,6 +104,50 @@ private:
     Vector< RefPtr<RQRef> > m_refList;
 };
 
+/*
+ * A bounded free-list of fixed-capacity ByteBuffers owned by a RenderingQueue.
+ * Buffers handed to Java are returned here by WCRenderQueue.twkRelease instead
+ * of being deallocated. Both sides run on the Event thread, so no locking is
+ * needed. The pool may outlive its RenderingQueue while flushed buffers are
+ * still held by Java.
+ */
+class ByteBufferPool : public RefCounted<ByteBufferPool> {
+    RQ_LOG_INSTANCE_COUNT(ByteBufferPool)
+public:
+    static Ref<ByteBufferPool> create(int capacity, size_t maxCount) {
+        return adoptRef(*new ByteBufferPool(capacity, maxCount));
+    }
+
+    RefPtr<ByteBuffer> take(int size);
+    void recycle(RefPtr<ByteBuffer>&&);
+
+    int capacity() const { return m_capacity; }
+    size_t freeCount() const { return m_freeList.size(); }
+
+    // Statistics used to tune RenderingQueue::MAX_BUFFER_COUNT, reported
+    // through the PerformanceLogging channel when the queue is disposed.
+    size_t hits() const { return m_hits; }
+    size_t misses() const { return m_misses; }
+    size_t liveCount() const { return m_liveCount; }
+    size_t peakLiveCount() const { return m_peakLiveCount; }
+    void logStatistics() const;
+
+private:
+    ByteBufferPool(int capacity, size_t maxCount) :
+        m_capacity(capacity),
+        m_maxCount(maxCount)
+    {}
+
+    int m_capacity;
+    size_t m_maxCount;
+    Vector<RefPtr<ByteBuffer>> m_freeList;
+
+    size_t m_hits { 0 };
+    size_t m_misses { 0 };
+    size_t m_liveCount { 0 };
+    size_t m_peakLiveCount { 0 };
+};
+
 /*
  * A lifecycle of an instance of RenderingQueue (RQ) used to draw to ImageBufferJava
  * may continue after the RQ is flushed to java (e.g. when it's used for html5 canvas).
@@ -138,6 +192,12 @@ public:
         return m_buffer == nullptr || m_buffer->isEmpty();
     }
 
+    // Incremented for every recorded operation, so that readers of the
+    // target image can tell whether it may have changed since they looked.
+    unsigned modificationCount() const {
+        return m_modificationCount;
+    }
+
     JLObject getWCRenderingQueue() {
         return m_rqoRenderingQueue->cloneLocalCopy();
     }
@@ -149,6 +209,10 @@ public:
     }
 
     ~RenderingQueue() {
+        m_bufferPool->logStatistics();
+        if (m_buffer) {
+            m_bufferPool->recycle(WTFMove(m_buffer));
+        }
         disposeGraphics();
     }
 
@@ -157,7 +221,8 @@ private:
         m_rqoRenderingQueue(RQRef::create(jRQ)),
         m_capacity(capacity),
         m_autoFlush(autoFlush),
-        m_buffer(nullptr)
+        m_buffer(nullptr),
+        m_bufferPool(ByteBufferPool::create(capacity, MAX_BUFFER_COUNT))
     {}
 
     void flush();
@@ -170,6 +235,8 @@ private:
     int m_capacity;
     bool m_autoFlush;
     RefPtr<ByteBuffer> m_buffer; // ref to the current ByteBuffer
+    Ref<ByteBufferPool> m_bufferPool; // recycled buffers of m_capacity size
+    unsigned m_modificationCount { 0 };
 
 };
 } // namespace WebCore
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,19 +26,50 @@
 #include "config.h"
 
 #include "BitmapTextureJava.h"
+#include "ByteArrayPixelBuffer.h"
+#include "CSSFilter.h"
+#include "FilterOperations.h"
+#include "FilterResults.h"
 #include "GraphicsLayer.h"
-#include "NotImplemented.h"
 #include "PlatformContextJava.h"
 #include "TextureMapperJava.h"
 
 namespace WebCore {
 
-void BitmapTextureJava::updateContents(const void*, const IntRect&, const IntPoint&, int)
+void BitmapTextureJava::updateContents(const void* data, const IntRect& targetRect, const IntPoint& sourceOffset, int bytesPerLine)
 {
+    if (!m_image || targetRect.isEmpty())
+        return;
+
+    // The raw contents are premultiplied BGRA, the layout of m_image, so the
+    // rows are copied as is and handed to the buffer in a single put.
+    PixelBufferFormat format { AlphaPremultiplication::Premultiplied, PixelFormat::BGRA8, DestinationColorSpace::SRGB() };
+    auto pixelBuffer = ByteArrayPixelBuffer::tryCreate(format, targetRect.size());
+    if (!pixelBuffer)
+        return;
+
+    const unsigned rowBytes = targetRect.width() * 4;
+    const uint8_t* source = static_cast<const uint8_t*>(data) + sourceOffset.y() * bytesPerLine + sourceOffset.x() * 4;
+    uint8_t* destination = pixelBuffer->bytes();
+    for (int y = 0; y < targetRect.height(); ++y) {
+        memcpy(destination, source, rowBytes);
+        source += bytesPerLine;
+        destination += rowBytes;
+    }
+
+    m_image->putPixelBuffer(*pixelBuffer, IntRect({ }, targetRect.size()), targetRect.location());
 }
 
 void BitmapTextureJava::didReset()
 {
+    // Pooled surfaces and recycled tiles are reset every frame, usually to
+    // the size they already have; keep the backing instead of creating a new
+    // Java image for each of them.
+    if (m_image && m_image->truncatedLogicalSize() == contentSize()) {
+        m_image->context().clearRect(FloatRect({ }, contentSize()));
+        return;
+    }
+
     float devicePixelRatio = 1.0;
     m_image = ImageBuffer::create(contentSize(), RenderingPurpose::Unspecified, devicePixelRatio,
                      DestinationColorSpace::SRGB(), PixelFormat::BGRA8);
@@ -49,10 +80,52 @@ void BitmapTextureJava::updateContents(Image* image, const IntRect& targetRect,
     m_image->context().drawImage(*image, targetRect, IntRect(offset, targetRect.size()), CompositeOperator::Copy);
 }
 
-RefPtr<BitmapTexture> BitmapTextureJava::applyFilters(TextureMapper&, const FilterOperations&, bool)
+void BitmapTextureJava::updateContents(GraphicsLayer* sourceLayer, const IntRect& targetRect, const IntPoint& offset, float scale)
+{
+    if (!m_image)
+        return;
+
+    // Paint straight into the backing rather than into an intermediate
+    // buffer that would then be copied in.
+    IntRect sourceRect(targetRect);
+    sourceRect.setLocation(offset);
+    sourceRect.scale(1 / scale);
+
+    GraphicsContext& context = m_image->context();
+    context.save();
+    context.clip(targetRect);
+    context.clearRect(targetRect);
+    context.setImageInterpolationQuality(InterpolationQuality::Default);
+    context.setTextDrawingMode(TextDrawingMode::Fill);
+    context.translate(targetRect.x(), targetRect.y());
+    context.applyDeviceScaleFactor(scale);
+    context.translate(-sourceRect.x(), -sourceRect.y());
+
+    sourceLayer->paintGraphicsLayerContents(context, sourceRect);
+
+    context.restore();
+}
+
+RefPtr<BitmapTexture> BitmapTextureJava::applyFilters(TextureMapper& textureMapper, const FilterOperations& filters, bool)
 {
-    notImplemented();
-    return this;
+    if (filters.isEmpty() || !m_image)
+        return this;
+
+    FloatRect rect({ }, contentSize());
+    auto filter = CSSFilter::create(filters, rect);
+    if (!filter)
+        return this;
+
+    // The whole chain runs in one pass over the source buffer; the result is
+    // drawn into a surface from the pool, which starts out cleared.
+    auto resultTexture = textureMapper.acquireTextureFromPool(contentSize(), BitmapTexture::SupportsAlpha);
+    auto* context = static_cast<BitmapTextureJava&>(*resultTexture).graphicsContext();
+    if (!context)
+        return this;
+
+    FilterResults results;
+    context->drawFilteredImageBuffer(m_image.get(), rect, *filter, results);
+    return resultTexture;
 }
 
 } // namespace WebCore
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -36,7 +36,31 @@
 #if USE(TEXTURE_MAPPER)
 namespace WebCore {
 
-static const int s_maximumAllowedImageBufferDimension = 256;
+// Tiles are clipped to the layer bounds, so layers smaller than a tile get a
+// single backing of their own size and only large layers are split.
+static const int s_minimumTileSize = 256;
+static const int s_maximumTileSize = 4096;
+static int s_tileSize = 512;
+
+void TextureMapperJava::setTileSize(int tileSize)
+{
+    s_tileSize = std::clamp(tileSize, s_minimumTileSize, s_maximumTileSize);
+}
+
+static void setPerspectiveTransform(GraphicsContext& context, const TransformationMatrix& transform)
+{
+    // The state restored after each draw starts out with an identity
+    // perspective transform, so there is nothing to send for flat layers.
+    if (transform.isIdentity())
+        return;
+
+    context.platformContext()->rq().freeSpace(68)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
+        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
+        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
+        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
+        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+}
 
 std::unique_ptr<TextureMapper> TextureMapper::platformCreateAccelerated()
 {
@@ -50,7 +74,7 @@ TextureMapperJava::TextureMapperJava()
 
 IntSize TextureMapperJava::maxTextureSize() const
 {
-    return IntSize(s_maximumAllowedImageBufferDimension, s_maximumAllowedImageBufferDimension);
+    return IntSize(s_tileSize, s_tileSize);
 }
 
 void TextureMapperJava::beginClip(const TransformationMatrix& matrix, const FloatRoundedRect& rect)
@@ -76,12 +100,7 @@ void TextureMapperJava::drawTexture(const BitmapTexture& texture, const FloatRec
     context->save();
     context->setCompositeOperation(isInMaskMode() ? CompositeOperator::DestinationIn : CompositeOperator::SourceOver);
     context->setAlpha(opacity);
-    context->platformContext()->rq().freeSpace(68)
-        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
-        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
-        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
-        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
-        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+    setPerspectiveTransform(*context, transform);
     context->drawImageBuffer(*image, targetRect);
     context->restore();
 }
@@ -94,12 +113,7 @@ void TextureMapperJava::drawSolidColor(const FloatRect& rect, const Transformati
 
     context->save();
     context->setCompositeOperation(isInMaskMode() ? CompositeOperator::DestinationIn : CompositeOperator::SourceOver);
-    context->platformContext()->rq().freeSpace(68)
-        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
-        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
-        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
-        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
-        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+    setPerspectiveTransform(*context, transform);
 
     context->fillRect(rect, color);
     context->restore();
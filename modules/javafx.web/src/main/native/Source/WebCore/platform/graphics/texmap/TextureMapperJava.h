@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -37,6 +37,9 @@ class TextureMapperJava final : public TextureMapper {
 public:
     TextureMapperJava();
 
+    // Sets the edge length of the tiles composited layers are split into.
+    static void setTileSize(int);
+
     // TextureMapper implementation
     void drawBorder(const Color&, float borderWidth, const FloatRect&, const TransformationMatrix&) final;
     void drawNumber(int number, const Color&, const FloatPoint&, const TransformationMatrix&) final;
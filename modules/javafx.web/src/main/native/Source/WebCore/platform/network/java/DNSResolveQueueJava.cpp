@@ -28,30 +28,152 @@
 
 #if PLATFORM(JAVA)
 
-#include "NotImplemented.h"
+#include "PlatformJavaClasses.h"
+#include "com_sun_webkit_network_DNSResolver.h"
+#include <wtf/CompletionHandler.h>
+#include <wtf/MainThread.h>
 
 namespace WebCore {
 
+namespace DNSResolverJava {
+
+static JGClass resolverClass;
+static jmethodID isUsingProxyMethod;
+static jmethodID prefetchMethod;
+static jmethodID resolveMethod;
+
+static void initRefs(JNIEnv* env)
+{
+    if (!resolverClass) {
+        resolverClass = JLClass(env->FindClass(
+                "com/sun/webkit/network/DNSResolver"));
+        ASSERT(resolverClass);
+
+        isUsingProxyMethod = env->GetStaticMethodID(
+                resolverClass,
+                "fwkIsUsingProxy",
+                "()Z");
+        ASSERT(isUsingProxyMethod);
+
+        prefetchMethod = env->GetStaticMethodID(
+                resolverClass,
+                "fwkPrefetch",
+                "(Ljava/lang/String;)V");
+        ASSERT(prefetchMethod);
+
+        resolveMethod = env->GetStaticMethodID(
+                resolverClass,
+                "fwkResolve",
+                "(Ljava/lang/String;J)V");
+        ASSERT(resolveMethod);
+    }
+}
+
+} // namespace DNSResolverJava
+
 void DNSResolveQueueJava::updateIsUsingProxy()
 {
-    notImplemented();
+    using namespace DNSResolverJava;
+    JNIEnv* env = WTF::GetJavaEnv();
+    initRefs(env);
+
+    jboolean isUsingProxy = env->CallStaticBooleanMethod(
+            resolverClass,
+            isUsingProxyMethod);
+    m_isUsingProxy = WTF::CheckAndClearException(env) || jbool_to_bool(isUsingProxy);
+}
+
+void DNSResolveQueueJava::platformResolve(const String& hostname)
+{
+    using namespace DNSResolverJava;
+    JNIEnv* env = WTF::GetJavaEnv();
+    initRefs(env);
+
+    // DNSResolver.fwkPrefetch reports completion through twkDidPrefetch.
+    env->CallStaticVoidMethod(
+            resolverClass,
+            prefetchMethod,
+            (jstring) hostname.toJavaString(env));
+    if (WTF::CheckAndClearException(env))
+        decrementRequestCount();
 }
 
-void DNSResolveQueueJava::platformResolve(const String& /* hostname */)
+void DNSResolveQueueJava::resolve(const String& hostname, uint64_t identifier, DNSCompletionHandler&& completionHandler)
 {
-    notImplemented();
+    using namespace DNSResolverJava;
+    JNIEnv* env = WTF::GetJavaEnv();
+    initRefs(env);
+
+    m_pendingRequests.set(identifier, WTFMove(completionHandler));
+    env->CallStaticVoidMethod(
+            resolverClass,
+            resolveMethod,
+            (jstring) hostname.toJavaString(env),
+            static_cast<jlong>(identifier));
+    if (WTF::CheckAndClearException(env))
+        didResolve(identifier, std::nullopt);
 }
 
-void DNSResolveQueueJava::resolve(const String& /* hostname */, uint64_t /* identifier */, DNSCompletionHandler&& /* completionHandler */)
+void DNSResolveQueueJava::stopResolve(uint64_t identifier)
 {
-    notImplemented();
+    // The lookup itself cannot be interrupted; its result is dropped.
+    if (auto completionHandler = m_pendingRequests.take(identifier))
+        completionHandler(makeUnexpected(DNSError::Cancelled));
 }
 
-void DNSResolveQueueJava::stopResolve(uint64_t /* identifier */)
+void DNSResolveQueueJava::didResolve(uint64_t identifier, std::optional<Vector<String>>&& addresses)
 {
-    notImplemented();
+    ASSERT(isMainThread());
+    auto completionHandler = m_pendingRequests.take(identifier);
+    if (!completionHandler)
+        return;
+
+    if (!addresses)
+        return completionHandler(makeUnexpected(DNSError::CannotResolve));
+
+    Vector<IPAddress> result;
+    for (auto& address : *addresses) {
+        if (auto ipAddress = IPAddress::fromString(address))
+            result.append(WTFMove(*ipAddress));
+    }
+    if (result.isEmpty())
+        return completionHandler(makeUnexpected(DNSError::CannotResolve));
+
+    completionHandler(WTFMove(result));
 }
 
+} // namespace WebCore
+
+extern "C" {
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_DNSResolver_twkDidPrefetch
+  (JNIEnv*, jclass)
+{
+    WebCore::DNSResolveQueue::singleton().decrementRequestCount();
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_DNSResolver_twkDidResolve
+  (JNIEnv* env, jclass, jlong identifier, jobjectArray jaddresses)
+{
+    using namespace WebCore;
+    std::optional<Vector<String>> addresses;
+    if (jaddresses) {
+        Vector<String> result;
+        jsize count = env->GetArrayLength(jaddresses);
+        for (jsize i = 0; i < count; ++i) {
+            JLString address(static_cast<jstring>(env->GetObjectArrayElement(jaddresses, i)));
+            if (address)
+                result.append(String(env, address));
+        }
+        addresses = WTFMove(result);
+    }
+
+    // Called on a DNSResolver thread, or on the main thread for cached hosts.
+    callOnMainThread([identifier, addresses = crossThreadCopy(WTFMove(addresses))]() mutable {
+        static_cast<DNSResolveQueueJava&>(DNSResolveQueue::singleton()).didResolve(identifier, WTFMove(addresses));
+    });
 }
 
-#endif
+} // extern "C"
+
+#endif // PLATFORM(JAVA)
@@ -26,18 +26,25 @@
 #pragma once
 
 #include "DNSResolveQueue.h"
+#include <wtf/HashMap.h>
 
 namespace WebCore {
 
+// Host names are resolved by com.sun.webkit.network.DNSResolver on its own
+// thread pool, so that the JVM's address cache used by the loaders is warmed.
 class DNSResolveQueueJava final : public DNSResolveQueue {
 public:
     DNSResolveQueueJava() = default;
     void resolve(const String& hostname, uint64_t identifier, DNSCompletionHandler&&) final;
     void stopResolve(uint64_t identifier) final;
 
+    void didResolve(uint64_t identifier, std::optional<Vector<String>>&& addresses);
+
 private:
     void updateIsUsingProxy() final;
     void platformResolve(const String&) final;
+
+    HashMap<uint64_t, DNSCompletionHandler> m_pendingRequests;
 };
 
 using DNSResolveQueuePlatform = DNSResolveQueueJava;
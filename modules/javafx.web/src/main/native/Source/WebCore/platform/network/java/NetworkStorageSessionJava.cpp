@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -33,10 +33,14 @@
 #include "NotImplemented.h"
 #include "ResourceHandle.h"
 
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
 #include <wtf/MainThread.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/URL.h>
+#include <wtf/WallTime.h>
 #include "PlatformJavaClasses.h"
+#include "com_sun_webkit_network_CookieJar.h"
 
 namespace WebCore {
 
@@ -56,7 +60,7 @@ static void initRefs(JNIEnv* env)
         getMethod = env->GetStaticMethodID(
                 cookieJarClass,
                 "fwkGet",
-                "(Ljava/lang/String;Z)Ljava/lang/String;");
+                "(Ljava/lang/String;Z[J)Ljava/lang/String;");
         ASSERT(getMethod);
 
         putMethod = env->GetStaticMethodID(
@@ -67,20 +71,131 @@ static void initRefs(JNIEnv* env)
     }
 }
 
+// Cookie strings returned by the Java CookieJar, keyed by host. CookieJar
+// bumps the generation whenever the cookie store changes, which drops
+// every cached host lazily on its next lookup, as does a new default
+// CookieHandler once fwkGet sees it. Each entry also expires after a few
+// seconds, or earlier with the first cookie it contains that expires, so
+// a replaced CookieHandler is noticed soon even without further misses.
+class CookieCache {
+public:
+    static CookieCache& singleton()
+    {
+        static NeverDestroyed<CookieCache> cache;
+        return cache;
+    }
+
+    std::optional<String> lookup(const URL& url, bool includeHttpOnlyCookies)
+    {
+        Locker locker { m_lock };
+        auto it = m_hosts.find(url.host().convertToASCIILowercase());
+        if (it != m_hosts.end() && it->value.generation == m_generation.load()) {
+            double now = WallTime::now().secondsSinceEpoch().milliseconds();
+            for (auto& entry : it->value.entries) {
+                if (entry.includeHttpOnlyCookies == includeHttpOnlyCookies
+                    && entry.protocol == url.protocol()
+                    && entry.path == url.path()
+                    && entry.validUntil > now) {
+                    ++m_hits;
+                    return entry.cookies;
+                }
+            }
+        }
+        ++m_misses;
+        return std::nullopt;
+    }
+
+    void store(const URL& url, bool includeHttpOnlyCookies, uint64_t generation, const String& cookies, jlong validUntil)
+    {
+        Locker locker { m_lock };
+        // The jar changed while the cookies were being read.
+        if (generation != m_generation.load())
+            return;
+
+        auto host = url.host().convertToASCIILowercase();
+        auto it = m_hosts.find(host);
+        if (it == m_hosts.end()) {
+            if (m_hosts.size() >= maxHosts)
+                m_hosts.clear();
+            it = m_hosts.add(host, HostCookies { }).iterator;
+        }
+
+        auto& hostCookies = it->value;
+        if (hostCookies.generation != generation) {
+            hostCookies.entries.clear();
+            hostCookies.generation = generation;
+        }
+        hostCookies.entries.removeFirstMatching([&](auto& entry) {
+            return entry.includeHttpOnlyCookies == includeHttpOnlyCookies
+                && entry.protocol == url.protocol()
+                && entry.path == url.path();
+        });
+        if (hostCookies.entries.size() >= maxEntriesPerHost)
+            hostCookies.entries.remove(0);
+        hostCookies.entries.append({ url.protocol().toString(), url.path().toString(),
+            includeHttpOnlyCookies, cookies, static_cast<double>(validUntil) });
+    }
+
+    uint64_t generation() const { return m_generation.load(); }
+    void invalidate() { ++m_generation; }
+
+    jlong hits() const { return m_hits.load(); }
+    jlong misses() const { return m_misses.load(); }
+
+private:
+    static constexpr size_t maxHosts = 64;
+    static constexpr size_t maxEntriesPerHost = 16;
+
+    struct Entry {
+        String protocol;
+        String path;
+        bool includeHttpOnlyCookies;
+        String cookies;
+        double validUntil;
+    };
+
+    struct HostCookies {
+        uint64_t generation { 0 };
+        Vector<Entry> entries;
+    };
+
+    Lock m_lock;
+    HashMap<String, HostCookies> m_hosts WTF_GUARDED_BY_LOCK(m_lock);
+    std::atomic<uint64_t> m_generation { 1 };
+    std::atomic<jlong> m_hits { 0 };
+    std::atomic<jlong> m_misses { 0 };
+};
+
 static String getCookies(const URL& url, bool includeHttpOnlyCookies)
 {
     using namespace CookieInternalJava;
+    auto& cache = CookieCache::singleton();
+    if (auto cookies = cache.lookup(url, includeHttpOnlyCookies))
+        return *cookies;
+
     JNIEnv* env = WTF::GetJavaEnv();
     initRefs(env);
 
+    uint64_t generation = cache.generation();
+    JLocalRef<jlongArray> validUntil(env->NewLongArray(1));
+    if (WTF::CheckAndClearException(env) || !validUntil)
+        return emptyString();
+
     JLString result = static_cast<jstring>(env->CallStaticObjectMethod(
             cookieJarClass,
             getMethod,
             (jstring) url.string().toJavaString(env),
-            bool_to_jbool(includeHttpOnlyCookies)));
-    WTF::CheckAndClearException(env);
+            bool_to_jbool(includeHttpOnlyCookies),
+            (jlongArray) validUntil));
+    if (WTF::CheckAndClearException(env) || !result)
+        return emptyString();
 
-    return result ? String(env, result) : emptyString();
+    String cookies(env, result);
+    jlong validUntilTime = 0;
+    env->GetLongArrayRegion(validUntil, 0, 1, &validUntilTime);
+    if (validUntilTime > 0)
+        cache.store(url, includeHttpOnlyCookies, generation, cookies, validUntilTime);
+    return cookies;
 }
 }
 
@@ -181,3 +296,24 @@ Vector<Cookie> NetworkStorageSession::getCookies(const URL&)
 
 } // namespace WebCore
 
+extern "C" {
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_CookieJar_twkInvalidateCache
+  (JNIEnv*, jclass)
+{
+    WebCore::CookieInternalJava::CookieCache::singleton().invalidate();
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_network_CookieJar_twkGetCacheHitCount
+  (JNIEnv*, jclass)
+{
+    return WebCore::CookieInternalJava::CookieCache::singleton().hits();
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_network_CookieJar_twkGetCacheMissCount
+  (JNIEnv*, jclass)
+{
+    return WebCore::CookieInternalJava::CookieCache::singleton().misses();
+}
+
+} // extern "C"
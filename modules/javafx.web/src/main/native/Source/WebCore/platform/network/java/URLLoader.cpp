@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,7 @@
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
 
+#include "FormData.h"
 #include "FrameNetworkingContext.h"
 #include "HTTPParsers.h"
 #include "MIMETypeRegistry.h"
@@ -45,8 +46,12 @@
 #include "URLLoader.h"
 #include "NetworkLoadMetrics.h"
 #include "com_sun_webkit_LoadListenerClient.h"
+#include "com_sun_webkit_network_FormDataElement.h"
 #include "com_sun_webkit_network_URLLoaderBase.h"
 #include <wtf/CompletionHandler.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
 
 namespace WebCore {
 class Page;
@@ -65,6 +70,7 @@ static jmethodID cancelMethod;
 static JGClass formDataElementClass;
 static jmethodID createFromFileMethod;
 static jmethodID createFromByteArrayMethod;
+static jmethodID createFromByteBufferMethod;
 
 static void initRefs(JNIEnv* env)
 {
@@ -101,15 +107,92 @@ static void initRefs(JNIEnv* env)
                 "([B)Lcom/sun/webkit/network/FormDataElement;");
         ASSERT(createFromByteArrayMethod);
 
+        createFromByteBufferMethod = env->GetStaticMethodID(
+                formDataElementClass,
+                "fwkCreateFromByteBuffer",
+                "(Ljava/nio/ByteBuffer;J)"
+                "Lcom/sun/webkit/network/FormDataElement;");
+        ASSERT(createFromByteBufferMethod);
+
         createFromFileMethod = env->GetStaticMethodID(
                 formDataElementClass,
                 "fwkCreateFromFile",
-                "(Ljava/lang/String;)"
+                "(Ljava/lang/String;JJ)"
                 "Lcom/sun/webkit/network/FormDataElement;");
         ASSERT(createFromFileMethod);
     }
 }
 
+// Receive buffers are native blocks that Java fills through direct
+// ByteBuffers. A filled block is adopted by a DataSegment and comes back
+// here once WebCore releases the segment, so the next ByteBuffer reuses it.
+class ReceiveBufferPool {
+public:
+    static ReceiveBufferPool& singleton()
+    {
+        static NeverDestroyed<ReceiveBufferPool> pool;
+        return pool;
+    }
+
+    uint8_t* take(size_t capacity)
+    {
+        {
+            Locker locker { m_lock };
+            if (capacity == m_capacity && !m_buffers.isEmpty())
+                return m_buffers.takeLast();
+        }
+        uint8_t* buffer = nullptr;
+        if (!tryFastMalloc(capacity).getValue(buffer))
+            return nullptr;
+        return buffer;
+    }
+
+    void recycle(uint8_t* buffer, size_t capacity)
+    {
+        {
+            Locker locker { m_lock };
+            // Only buffers of the most recent size are worth keeping
+            if (capacity != m_capacity) {
+                for (auto* stale : m_buffers)
+                    fastFree(stale);
+                m_buffers.clear();
+                m_capacity = capacity;
+            }
+            if (m_buffers.size() < maxPooledBuffers) {
+                m_buffers.append(buffer);
+                return;
+            }
+        }
+        fastFree(buffer);
+    }
+
+private:
+    static constexpr size_t maxPooledBuffers = 16;
+
+    Lock m_lock;
+    size_t m_capacity WTF_GUARDED_BY_LOCK(m_lock) { 0 };
+    Vector<uint8_t*> m_buffers WTF_GUARDED_BY_LOCK(m_lock);
+};
+
+// Returns the block to the pool when the DataSegment holding it goes away
+class AdoptedReceiveBuffer {
+    WTF_MAKE_NONCOPYABLE(AdoptedReceiveBuffer);
+public:
+    AdoptedReceiveBuffer(uint8_t* buffer, size_t capacity)
+        : m_buffer(buffer), m_capacity(capacity) { }
+    AdoptedReceiveBuffer(AdoptedReceiveBuffer&& other)
+        : m_buffer(std::exchange(other.m_buffer, nullptr)), m_capacity(other.m_capacity) { }
+    ~AdoptedReceiveBuffer()
+    {
+        if (m_buffer)
+            ReceiveBufferPool::singleton().recycle(m_buffer, m_capacity);
+    }
+
+private:
+    uint8_t* m_buffer;
+    size_t m_capacity;
+};
+
 }
 
 URLLoader::URLLoader()
@@ -208,14 +291,18 @@ JLObject URLLoader::load(bool asynchronous,
     return loader;
 }
 
-JLObjectArray URLLoader::toJava(const FormData* formData)
+JLObjectArray URLLoader::toJava(FormData* formData)
 {
     using namespace URLLoaderJavaInternal;
     if (!formData) {
         return nullptr;
     }
 
-    const Vector<FormDataElement>& elements = formData->elements();
+    // Blobs are replaced by the bytes and file ranges they are made of, so
+    // that every element can be streamed by the Java loaders.
+    Ref<FormData> resolvedFormData = formData->resolveBlobReferences();
+
+    const Vector<FormDataElement>& elements = resolvedFormData->elements();
     size_t size = elements.size();
     if (size == 0) {
         return nullptr;
@@ -232,28 +319,43 @@ JLObjectArray URLLoader::toJava(const FormData* formData)
         JLObject resultElement;
         WTF::switchOn(elements[i].data,
             [&] (const Vector<uint8_t>& data) -> void {
-                JLByteArray byteArray = env->NewByteArray(data.size());
-                env->SetByteArrayRegion(
-                        (jbyteArray) byteArray,
-                        (jsize) 0,
-                        (jsize) data.size(),
-                        (const jbyte*) data.data());
+                if (data.isEmpty()) {
+                    JLByteArray byteArray = env->NewByteArray(0);
+                    resultElement = env->CallStaticObjectMethod(
+                            formDataElementClass,
+                            createFromByteArrayMethod,
+                            (jbyteArray) byteArray);
+                    return;
+                }
+                // Java reads the bytes in place through a direct buffer.
+                // The element holds a reference to the form data, which
+                // FormDataElement.twkReleaseFormData drops once it is gone.
+                JLObject byteBuffer(env->NewDirectByteBuffer(
+                        const_cast<uint8_t*>(data.data()),
+                        data.size()));
+                if (WTF::CheckAndClearException(env) || !byteBuffer) {
+                    return;
+                }
+                resolvedFormData->ref();
                 resultElement = env->CallStaticObjectMethod(
                         formDataElementClass,
-                        createFromByteArrayMethod,
-                        (jbyteArray) byteArray);
+                        createFromByteBufferMethod,
+                        (jobject) byteBuffer,
+                        ptr_to_jlong(resolvedFormData.ptr()));
+                if (WTF::CheckAndClearException(env) || !resultElement) {
+                    resolvedFormData->deref();
+                }
             },
             [&] (const FormDataElement::EncodedFileData& data) -> void {
                 resultElement = env->CallStaticObjectMethod(
                         formDataElementClass,
                         createFromFileMethod,
-                        (jstring) data.filename.toJavaString(env));
+                        (jstring) data.filename.toJavaString(env),
+                        (jlong) data.fileStart,
+                        (jlong) data.fileLength);
             },
-            [&] (const FormDataElement::EncodedBlobData& data) -> void {
-                resultElement = env->CallStaticObjectMethod(
-                        formDataElementClass,
-                        createFromFileMethod,
-                        (jstring) data.url.string().toJavaString(env));
+            [&] (const FormDataElement::EncodedBlobData&) -> void {
+                ASSERT_NOT_REACHED();
             }
         );
         env->SetObjectArrayElement(
@@ -508,9 +610,60 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveDa
     ASSERT(target);
     const uint8_t* address =
             static_cast<const uint8_t*>(env->GetDirectBufferAddress(byteBuffer));
-    Ref<FragmentedSharedBuffer> tmp_buf = FragmentedSharedBuffer::create(address,remaining);
-    target->didReceiveData(tmp_buf->makeContiguous().ptr() + position, remaining);
-    //target->didReceiveData((SharedBuffer*)(address) + position, remaining);
+    // The Java buffer is reused once this returns, so take one copy
+    Ref<SharedBuffer> buffer = SharedBuffer::create(address + position, static_cast<size_t>(remaining));
+    target->didReceiveData(buffer.ptr(), remaining);
+}
+
+JNIEXPORT jobject JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkAllocateReceiveBuffer
+  (JNIEnv* env, jclass, jint capacity)
+{
+    using namespace WebCore::URLLoaderJavaInternal;
+    if (capacity <= 0)
+        return nullptr;
+    uint8_t* buffer = ReceiveBufferPool::singleton().take(static_cast<size_t>(capacity));
+    if (!buffer)
+        return nullptr;
+    jobject byteBuffer = env->NewDirectByteBuffer(buffer, capacity);
+    if (!byteBuffer) {
+        ReceiveBufferPool::singleton().recycle(buffer, static_cast<size_t>(capacity));
+        return nullptr;
+    }
+    return byteBuffer;
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkReleaseReceiveBuffer
+  (JNIEnv* env, jclass, jobject byteBuffer)
+{
+    using namespace WebCore::URLLoaderJavaInternal;
+    uint8_t* buffer = static_cast<uint8_t*>(env->GetDirectBufferAddress(byteBuffer));
+    if (buffer) {
+        ReceiveBufferPool::singleton().recycle(buffer,
+                static_cast<size_t>(env->GetDirectBufferCapacity(byteBuffer)));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveBuffer
+  (JNIEnv* env, jclass, jobject byteBuffer, jint position, jint remaining,
+   jlong data)
+{
+    using namespace WebCore;
+    using namespace WebCore::URLLoaderJavaInternal;
+    URLLoader::Target* target =
+            static_cast<URLLoader::Target*>(jlong_to_ptr(data));
+    ASSERT(target);
+    uint8_t* address = static_cast<uint8_t*>(env->GetDirectBufferAddress(byteBuffer));
+    size_t capacity = static_cast<size_t>(env->GetDirectBufferCapacity(byteBuffer));
+    const uint8_t* begin = address + position;
+    size_t size = static_cast<size_t>(remaining);
+
+    // The block came from twkAllocateReceiveBuffer and Java no longer
+    // touches it, so the segment takes it over without a copy
+    Ref<SharedBuffer> buffer = SharedBuffer::create(DataSegment::Provider {
+        [begin] { return begin; },
+        [size, owner = AdoptedReceiveBuffer(address, capacity)] { return size; }
+    });
+    target->didReceiveData(buffer.ptr(), remaining);
 }
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidFinishLoading
@@ -537,3 +690,12 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidFail
             URL(env, url),
             String(env, message)));
 }
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_FormDataElement_twkReleaseFormData
+  (JNIEnv*, jclass, jlong data)
+{
+    using namespace WebCore;
+    FormData* formData = static_cast<FormData*>(jlong_to_ptr(data));
+    ASSERT(formData);
+    formData->deref();
+}
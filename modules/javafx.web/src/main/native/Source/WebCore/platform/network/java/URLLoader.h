@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -70,7 +70,7 @@ private:
                          NetworkingContext* context,
                          const ResourceRequest& request,
                          Target* target);
-    static JLObjectArray toJava(const FormData* formData);
+    static JLObjectArray toJava(FormData* formData);
 
     class AsynchronousTarget : public Target {
     public:
@@ -221,71 +221,69 @@ static RefPtr<SVGFilter> createReferenceFilter(CSSFilter& filter, const Referenc
     return SVGFilter::create(*filterElement, preferredFilterRenderingModes, filter.filterScale(), filterRegion, targetBoundingBox, destinationContext);
 }
 
-bool CSSFilter::buildFilterFunctions(RenderElement& renderer, const FilterOperations& operations, OptionSet<FilterRenderingMode> preferredFilterRenderingModes, const FloatRect& targetBoundingBox, const GraphicsContext& destinationContext)
+// Creates the function for any operation but a reference filter, which needs a renderer.
+static RefPtr<FilterFunction> createFilterFunction(const FilterOperation& operation)
 {
-    RefPtr<FilterFunction> function;
+    switch (operation.type()) {
+    case FilterOperation::Type::AppleInvertLightness:
+        ASSERT_NOT_REACHED(); // AppleInvertLightness is only used in -apple-color-filter.
+        return nullptr;
 
-    for (auto& operation : operations.operations()) {
-        switch (operation->type()) {
-        case FilterOperation::Type::AppleInvertLightness:
-            ASSERT_NOT_REACHED(); // AppleInvertLightness is only used in -apple-color-filter.
-            break;
+    case FilterOperation::Type::Blur:
+        return createBlurEffect(downcast<BlurFilterOperation>(operation));
 
-        case FilterOperation::Type::Blur:
-            function = createBlurEffect(downcast<BlurFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::Brightness:
+        return createBrightnessEffect(downcast<BasicComponentTransferFilterOperation>(operation));
 
-        case FilterOperation::Type::Brightness:
-            function = createBrightnessEffect(downcast<BasicComponentTransferFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::Contrast:
+        return createContrastEffect(downcast<BasicComponentTransferFilterOperation>(operation));
 
-        case FilterOperation::Type::Contrast:
-            function = createContrastEffect(downcast<BasicComponentTransferFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::DropShadow:
+        return createDropShadowEffect(downcast<DropShadowFilterOperation>(operation));
 
-        case FilterOperation::Type::DropShadow:
-            function = createDropShadowEffect(downcast<DropShadowFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::Grayscale:
+        return createGrayScaleEffect(downcast<BasicColorMatrixFilterOperation>(operation));
 
-        case FilterOperation::Type::Grayscale:
-            function = createGrayScaleEffect(downcast<BasicColorMatrixFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::HueRotate:
+        return createHueRotateEffect(downcast<BasicColorMatrixFilterOperation>(operation));
 
-        case FilterOperation::Type::HueRotate:
-            function = createHueRotateEffect(downcast<BasicColorMatrixFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::Invert:
+        return createInvertEffect(downcast<BasicComponentTransferFilterOperation>(operation));
 
-        case FilterOperation::Type::Invert:
-            function = createInvertEffect(downcast<BasicComponentTransferFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::Opacity:
+        return createOpacityEffect(downcast<BasicComponentTransferFilterOperation>(operation));
 
-        case FilterOperation::Type::Opacity:
-            function = createOpacityEffect(downcast<BasicComponentTransferFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::Saturate:
+        return createSaturateEffect(downcast<BasicColorMatrixFilterOperation>(operation));
 
-        case FilterOperation::Type::Saturate:
-            function = createSaturateEffect(downcast<BasicColorMatrixFilterOperation>(*operation));
-            break;
+    case FilterOperation::Type::Sepia:
+        return createSepiaEffect(downcast<BasicColorMatrixFilterOperation>(operation));
 
-        case FilterOperation::Type::Sepia:
-            function = createSepiaEffect(downcast<BasicColorMatrixFilterOperation>(*operation));
-            break;
+    default:
+        return nullptr;
+    }
+}
 
-        case FilterOperation::Type::Reference:
-            function = createReferenceFilter(*this, downcast<ReferenceFilterOperation>(*operation), renderer, preferredFilterRenderingModes, targetBoundingBox, destinationContext);
-            break;
+void CSSFilter::appendFilterFunction(Ref<FilterFunction>&& function)
+{
+    if (m_functions.isEmpty())
+        m_functions.append(SourceGraphic::create());
 
-        default:
-            break;
-        }
+    m_functions.append(WTFMove(function));
+}
 
-        if (!function)
-            continue;
+bool CSSFilter::buildFilterFunctions(RenderElement& renderer, const FilterOperations& operations, OptionSet<FilterRenderingMode> preferredFilterRenderingModes, const FloatRect& targetBoundingBox, const GraphicsContext& destinationContext)
+{
+    for (auto& operation : operations.operations()) {
+        RefPtr<FilterFunction> function;
 
-        if (m_functions.isEmpty())
-            m_functions.append(SourceGraphic::create());
+        if (operation->type() == FilterOperation::Type::Reference)
+            function = createReferenceFilter(*this, downcast<ReferenceFilterOperation>(*operation), renderer, preferredFilterRenderingModes, targetBoundingBox, destinationContext);
+        else
+            function = createFilterFunction(*operation);
 
-        m_functions.append(function.releaseNonNull());
+        if (function)
+            appendFilterFunction(function.releaseNonNull());
     }
 
     // If we didn't make any effects, tell our caller we are not valid.
@@ -296,6 +294,25 @@ bool CSSFilter::buildFilterFunctions(RenderElement& renderer, const FilterOperat
     return true;
 }
 
+#if PLATFORM(JAVA)
+RefPtr<CSSFilter> CSSFilter::create(const FilterOperations& operations, const FloatRect& filterRegion)
+{
+    auto filter = adoptRef(*new CSSFilter({ 1, 1 }, operations.hasFilterThatMovesPixels(), operations.hasFilterThatShouldBeRestrictedBySecurityOrigin()));
+
+    for (auto& operation : operations.operations()) {
+        if (auto function = createFilterFunction(*operation))
+            filter->appendFilterFunction(function.releaseNonNull());
+    }
+
+    if (filter->m_functions.isEmpty())
+        return nullptr;
+
+    filter->m_functions.shrinkToFit();
+    filter->setFilterRegion(filterRegion);
+    return filter;
+}
+#endif
+
 FilterEffectVector CSSFilter::effectsOfType(FilterFunction::Type filterType) const
 {
     FilterEffectVector effects;
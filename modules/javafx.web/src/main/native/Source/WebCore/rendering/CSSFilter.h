@@ -39,6 +39,10 @@ class CSSFilter final : public Filter {
 public:
     static RefPtr<CSSFilter> create(RenderElement&, const FilterOperations&, OptionSet<FilterRenderingMode> preferredFilterRenderingModes, const FloatSize& filterScale, const FloatRect& targetBoundingBox, const GraphicsContext& destinationContext);
     WEBCORE_EXPORT static RefPtr<CSSFilter> create(Vector<Ref<FilterFunction>>&&);
+#if PLATFORM(JAVA)
+    // Builds a filter for composited layers, which never carry reference filters.
+    static RefPtr<CSSFilter> create(const FilterOperations&, const FloatRect& filterRegion);
+#endif
 
     const Vector<Ref<FilterFunction>>& functions() const { return m_functions; }
 
@@ -59,6 +63,7 @@ private:
     CSSFilter(const FloatSize& filterScale, bool hasFilterThatMovesPixels, bool hasFilterThatShouldBeRestrictedBySecurityOrigin);
     CSSFilter(Vector<Ref<FilterFunction>>&&);
 
+    void appendFilterFunction(Ref<FilterFunction>&&);
     bool buildFilterFunctions(RenderElement&, const FilterOperations&, OptionSet<FilterRenderingMode> preferredFilterRenderingModes, const FloatRect& targetBoundingBox, const GraphicsContext& destinationContext);
 
     OptionSet<FilterRenderingMode> supportedFilterRenderingModes() const final;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -104,8 +104,10 @@
 #include <WebCore/TextIterator.h>
 #include <WebCore/TextureMapperJava.h>
 #include <WebCore/TextureMapperLayer.h>
+#include <WebCore/Timer.h>
 #include <WebCore/WorkerThread.h>
 #include <WebCore/platform/graphics/java/GraphicsContextJava.h>
+#include <wtf/NeverDestroyed.h>
 #include <wtf/Ref.h>
 #include <wtf/RunLoop.h>
 #include <wtf/java/JavaRef.h>
@@ -862,15 +864,37 @@ bool s_useJIT;
 bool s_useDFGJIT;
 bool s_useCSS3D;
 
+#if USE(GENERIC_EVENT_LOOP)
+// The main RunLoop is not run on the FX thread, so its timers are fired from
+// a single WebCore timer, which is in turn driven by MainThreadSharedTimer.
+void initializeMainRunLoopTimers()
+{
+    static NeverDestroyed<WebCore::Timer> timer([] {
+        RunLoop::main().dispatchFunctionsFromMainThread();
+    });
+    RunLoop::main().setTimerScheduler([](MonotonicTime fireDate) {
+        if (fireDate == MonotonicTime::infinity())
+            timer.get().stop();
+        else
+            timer.get().startOneShot(std::max(0_s, fireDate - MonotonicTime::now()));
+    });
+}
+#endif
+
 }  // namespace
 
 extern "C" {
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInitWebCore
-    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useCSS3D) {
+    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useCSS3D, jint tileSize) {
     s_useJIT = useJIT;
     s_useDFGJIT = useDFGJIT;
     s_useCSS3D = useCSS3D;
+#if USE(TEXTURE_MAPPER)
+    TextureMapperJava::setTileSize(tileSize);
+#else
+    UNUSED_PARAM(tileSize);
+#endif
 }
 
 JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
@@ -899,6 +923,9 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
         JSC::Options::useJIT() = s_useJIT;
         // Enable DFG only if JIT is enabled.
         JSC::Options::useDFGJIT() = s_useJIT && s_useDFGJIT;
+#if USE(GENERIC_EVENT_LOOP)
+        initializeMainRunLoopTimers();
+#endif
     });
 
     JLObject jlself(self, true);
@@ -78,6 +78,8 @@ else()
 endif()
 
 WEBKIT_OPTION_BEGIN()
+WEBKIT_OPTION_DEFINE(USE_SCALABLE_IMAGE_DECODER "Whether to decode images with WebCore's image decoders instead of Java ImageIO." PRIVATE OFF)
+
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_ACCESSIBILITY PRIVATE OFF)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_CSS_COMPOSITING PRIVATE ON)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_DRAG_SUPPORT PUBLIC ON)
@@ -127,6 +129,20 @@ endif ()
 # this point, and do not attempt to change any option after this point.
 WEBKIT_OPTION_END()
 
+if (USE_SCALABLE_IMAGE_DECODER)
+    find_package(JPEG REQUIRED)
+    find_package(PNG REQUIRED)
+    find_package(WebP COMPONENTS demux)
+    SET_AND_EXPOSE_TO_BUILD(USE_WEBP ${WebP_FOUND})
+
+    if (USE_JPEGXL)
+        find_package(JPEGXL 0.7.0)
+        if (NOT JPEGXL_FOUND)
+            message(FATAL_ERROR "libjxl is required for USE_JPEGXL with USE_SCALABLE_IMAGE_DECODER")
+        endif ()
+    endif ()
+endif ()
+
 
 set(ENABLE_WEBKIT_LEGACY ON)
 set(ENABLE_WEBKIT OFF)
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit.network;
+
+import java.net.InetAddress;
+import java.net.UnknownHostException;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.LongSupplier;
+
+/**
+ * Runs a {@link DNSResolver} against a stub name service backed by a map.
+ */
+public class DNSResolverShim {
+
+    private final DNSResolver resolver;
+    private final AtomicInteger lookupCount = new AtomicInteger();
+
+    public DNSResolverShim(Map<String, InetAddress[]> hosts,
+                           LongSupplier clock, long ttl, long negativeTtl)
+    {
+        resolver = new DNSResolver(host -> {
+            lookupCount.incrementAndGet();
+            InetAddress[] addresses = hosts.get(host);
+            if (addresses == null) {
+                throw new UnknownHostException(host);
+            }
+            return addresses;
+        }, clock, ttl, negativeTtl);
+    }
+
+    public String[] resolve(String host)
+        throws InterruptedException, ExecutionException, TimeoutException
+    {
+        CompletableFuture<String[]> result = new CompletableFuture<>();
+        resolver.resolve(host, result::complete);
+        return result.get(10, TimeUnit.SECONDS);
+    }
+
+    public int getLookupCount() {
+        return lookupCount.get();
+    }
+
+    public long getHitCount() {
+        return resolver.getHitCount();
+    }
+
+    public long getMissCount() {
+        return resolver.getMissCount();
+    }
+
+    public long getFailureCount() {
+        return resolver.getFailureCount();
+    }
+
+    public long getAverageLookupNanos() {
+        return resolver.getAverageLookupNanos();
+    }
+}
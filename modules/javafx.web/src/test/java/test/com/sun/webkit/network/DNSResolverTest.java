@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.webkit.network;
+
+import com.sun.webkit.network.DNSResolverShim;
+import java.net.InetAddress;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicLong;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * A test for the {@link DNSResolver} class.
+ */
+public class DNSResolverTest {
+
+    private static final long TTL = 30_000_000_000L;
+    private static final long NEGATIVE_TTL = 10_000_000_000L;
+
+    private final Map<String, InetAddress[]> hosts = new HashMap<>();
+    private final AtomicLong clock = new AtomicLong(1000L);
+    private DNSResolverShim resolver;
+
+
+    @Before
+    public void before() throws Exception {
+        hosts.put("example.org", new InetAddress[] {
+                InetAddress.getByAddress("example.org",
+                        new byte[] {(byte) 192, 0, 2, 1}),
+                InetAddress.getByAddress("example.org",
+                        new byte[] {(byte) 192, 0, 2, 2})});
+        resolver = new DNSResolverShim(hosts, clock::get, TTL, NEGATIVE_TTL);
+    }
+
+    /**
+     * Tests that a resolved host is served from the cache.
+     */
+    @Test
+    public void testResolveIsCached() throws Exception {
+        String[] expected = {"192.0.2.1", "192.0.2.2"};
+        assertArrayEquals(expected, resolver.resolve("example.org"));
+        assertArrayEquals(expected, resolver.resolve("example.org"));
+        assertEquals(1, resolver.getLookupCount());
+        assertEquals(1, resolver.getHitCount());
+        assertEquals(1, resolver.getMissCount());
+        assertTrue(resolver.getAverageLookupNanos() >= 0);
+    }
+
+    /**
+     * Tests that cached addresses expire after the TTL.
+     */
+    @Test
+    public void testResolveExpires() throws Exception {
+        resolver.resolve("example.org");
+        clock.addAndGet(TTL - 1);
+        resolver.resolve("example.org");
+        assertEquals(1, resolver.getLookupCount());
+        clock.addAndGet(1);
+        resolver.resolve("example.org");
+        assertEquals(2, resolver.getLookupCount());
+        assertEquals(2, resolver.getMissCount());
+    }
+
+    /**
+     * Tests that failed lookups are cached for the negative TTL.
+     */
+    @Test
+    public void testUnknownHost() throws Exception {
+        assertNull(resolver.resolve("unknown.example.org"));
+        assertNull(resolver.resolve("unknown.example.org"));
+        assertEquals(1, resolver.getLookupCount());
+        assertEquals(1, resolver.getFailureCount());
+        clock.addAndGet(NEGATIVE_TTL);
+        assertNull(resolver.resolve("unknown.example.org"));
+        assertEquals(2, resolver.getLookupCount());
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the YCbCr420p to BGRA32 converters of jfxmedia, one line per
+ * implementation available on this machine. Build it against the media
+ * sources, for example on Linux:
+ *
+ *   M=modules/javafx.media/src/main/native/jfxmedia
+ *   cc -O2 -DLINUX -I$M -I$M/Common ColorConvertBenchmark.c \
+ *       $M/Utils/ColorConverter.c -o ColorConvertBenchmark
+ *
+ * Usage: ColorConvertBenchmark [width height [seconds]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <Utils/ColorConverter.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+static double now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+#endif
+}
+
+static uint8_t *allocPlane(size_t size)
+{
+    // Planes and destination are 16 byte aligned, like GStreamer buffers
+    return (uint8_t*)malloc(size + 16);
+}
+
+#define ALIGN16(p) ((uint8_t*)(((uintptr_t)(p) + 15) & ~(uintptr_t)15))
+
+int main(int argc, char **argv)
+{
+    static const struct {
+        int level;
+        const char *name;
+    } variants[] = {
+        { COLOR_CONVERT_GENERIC, "generic" },
+        { COLOR_CONVERT_SSE2, "SSE2" },
+        { COLOR_CONVERT_AVX2, "AVX2" },
+        { COLOR_CONVERT_NEON, "NEON" },
+    };
+    int width = 3840;
+    int height = 2160;
+    double seconds = 2.0;
+    int32_t yStride, cStride, dStride;
+    uint8_t *yBase, *uBase, *vBase, *aBase, *dBase;
+    uint8_t *y, *u, *v, *a, *dst;
+    size_t i;
+    int alpha;
+
+    if (argc >= 3) {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+    }
+    if (argc >= 4) {
+        seconds = atof(argv[3]);
+    }
+    if (width <= 0 || height <= 0 || ((width | height) & 1)) {
+        fprintf(stderr, "width and height must be positive and even\n");
+        return 1;
+    }
+
+    yStride = (width + 15) & ~15;
+    cStride = (width / 2 + 15) & ~15;
+    dStride = width * 4;
+
+    yBase = allocPlane((size_t)yStride * height);
+    aBase = allocPlane((size_t)yStride * height);
+    uBase = allocPlane((size_t)cStride * height / 2);
+    vBase = allocPlane((size_t)cStride * height / 2);
+    dBase = allocPlane((size_t)dStride * height);
+    if (!yBase || !aBase || !uBase || !vBase || !dBase) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    y = ALIGN16(yBase);
+    a = ALIGN16(aBase);
+    u = ALIGN16(uBase);
+    v = ALIGN16(vBase);
+    dst = ALIGN16(dBase);
+
+    srand(42);
+    for (i = 0; i < (size_t)yStride * height; i++) {
+        y[i] = (uint8_t)rand();
+        a[i] = (uint8_t)rand();
+    }
+    for (i = 0; i < (size_t)cStride * height / 2; i++) {
+        u[i] = (uint8_t)rand();
+        v[i] = (uint8_t)rand();
+    }
+
+    printf("%dx%d, MB/s of BGRA32 output, single thread\n", width, height);
+    for (alpha = 0; alpha < 2; alpha++) {
+        for (i = 0; i < sizeof(variants) / sizeof(variants[0]); i++) {
+            double start, elapsed;
+            long frames = 0;
+
+            if (ColorConvert_SetSIMDLevel(variants[i].level) != 0) {
+                continue;
+            }
+
+            start = now();
+            do {
+                if (alpha) {
+                    ColorConvert_YCbCr420p_to_BGRA32(dst, dStride, width, height,
+                            y, v, u, a, yStride, cStride, cStride, yStride);
+                } else {
+                    ColorConvert_YCbCr420p_to_BGRA32_no_alpha(dst, dStride, width, height,
+                            y, v, u, yStride, cStride, cStride);
+                }
+                frames++;
+                elapsed = now() - start;
+            } while (elapsed < seconds);
+
+            printf("%-8s %-9s %9.1f MB/s %8.1f frames/s\n",
+                   variants[i].name, alpha ? "alpha" : "no alpha",
+                   (double)frames * dStride * height / (elapsed * 1024 * 1024),
+                   frames / elapsed);
+        }
+    }
+
+    free(yBase);
+    free(aBase);
+    free(uBase);
+    free(vBase);
+    free(dBase);
+    return 0;
+}
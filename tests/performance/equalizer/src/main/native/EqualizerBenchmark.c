@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the equalizer of gstreamer-lite with the default bands of
+ * javafx.scene.media.AudioEqualizer, stereo, in 10 ms buffers. For the S16
+ * and F32 formats it prints the samples filtered per second and the error
+ * against the F64 format, which filters in double precision throughout.
+ * The F64 speed is printed as well. Build it against gstreamer-lite, for
+ * example on Linux:
+ *
+ *   G=modules/javafx.media/src/main/native/gstreamer/gstreamer-lite
+ *   cc -O2 -DLINUX -DGSTREAMER_LITE -I$G/gstreamer -I$G/gstreamer/libs \
+ *       -I$G/gst-plugins-base/gst-libs -I$G/projects/build/linux/common \
+ *       $(pkg-config --cflags glib-2.0) EqualizerBenchmark.c \
+ *       -L<directory of libgstreamer-lite.so> -lgstreamer-lite \
+ *       $(pkg-config --libs glib-2.0) -lm -o EqualizerBenchmark
+ *
+ * Usage: EqualizerBenchmark [rate [seconds]]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+#include <gst/base/gstbasetransform.h>
+
+#define CHANNELS 2
+#define BANDS 10
+
+static const double bandFreq[BANDS] = {
+    32, 64, 125, 250, 500, 1000, 2000, 4000, 8000, 16000
+};
+static const double bandWidth[BANDS] = {
+    19, 39, 78, 156, 312, 625, 1250, 2500, 5000, 10000
+};
+// Every band is boosted or cut, so none of them is bypassed
+static const double bandGain[BANDS] = {
+    12, -12, 9, -6, 3, -3, 6, -9, 12, -12
+};
+
+static GstElement *createEqualizer(GstAudioFormat format, int rate)
+{
+    GstElement *equalizer = gst_element_factory_make("equalizer-nbands", NULL);
+    GstBaseTransformClass *klass;
+    GstAudioInfo info;
+    GstCaps *caps;
+    gboolean configured;
+    guint i;
+
+    if (!equalizer) {
+        return NULL;
+    }
+
+    g_object_set(equalizer, "num-bands", BANDS, NULL);
+    for (i = 0; i < BANDS; i++) {
+        GObject *band = gst_child_proxy_get_child_by_index(GST_CHILD_PROXY(equalizer), i);
+        g_object_set(band, "freq", bandFreq[i], "bandwidth", bandWidth[i],
+                     "gain", bandGain[i], NULL);
+        g_object_unref(band);
+    }
+
+    gst_audio_info_init(&info);
+    gst_audio_info_set_format(&info, format, rate, CHANNELS, NULL);
+    caps = gst_audio_info_to_caps(&info);
+    klass = GST_BASE_TRANSFORM_GET_CLASS(equalizer);
+    configured = klass->set_caps(GST_BASE_TRANSFORM(equalizer), caps, caps);
+    gst_caps_unref(caps);
+    if (!configured) {
+        gst_object_unref(equalizer);
+        return NULL;
+    }
+    return equalizer;
+}
+
+// Filters the whole signal in buffers of the given size, returns the seconds
+// spent in the equalizer
+static double filter(GstElement *equalizer, guint8 *data, size_t size,
+                     size_t bufferSize)
+{
+    GstBaseTransformClass *klass = GST_BASE_TRANSFORM_GET_CLASS(equalizer);
+    GstBuffer *buffer = gst_buffer_new_allocate(NULL, bufferSize, NULL);
+    double elapsed = 0.0;
+    size_t offset;
+
+    for (offset = 0; offset + bufferSize <= size; offset += bufferSize) {
+        gint64 start;
+
+        gst_buffer_fill(buffer, 0, data + offset, bufferSize);
+        start = g_get_monotonic_time();
+        klass->transform_ip(GST_BASE_TRANSFORM(equalizer), buffer);
+        elapsed += (g_get_monotonic_time() - start) / (double)G_USEC_PER_SEC;
+        gst_buffer_extract(buffer, 0, data + offset, bufferSize);
+    }
+
+    gst_buffer_unref(buffer);
+    return elapsed;
+}
+
+static void printResult(const char *format, size_t samples, double elapsed,
+                        double errorEnergy, double peakError, double signalEnergy)
+{
+    printf("%-4s %8.1f Msamples/s", format, samples / elapsed / 1e6);
+    if (signalEnergy > 0.0) {
+        printf("   error %6.1f dB, peak %.3g LSB",
+               errorEnergy > 0.0 ? 10.0 * log10(errorEnergy / signalEnergy) : -HUGE_VAL,
+               peakError);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    int rate = 96000;
+    double seconds = 10.0;
+    size_t frames, samples, bufferFrames, i;
+    gint16 *s16;
+    gfloat *f32;
+    gdouble *f64;
+    GstElement *equalizer;
+    double elapsed, signalEnergy = 0.0, errorEnergy, peakError;
+
+    gst_init(&argc, &argv);
+    if (argc >= 2) {
+        rate = atoi(argv[1]);
+    }
+    if (argc >= 3) {
+        seconds = atof(argv[2]);
+    }
+    if (rate < 1000 || seconds <= 0.0) {
+        fprintf(stderr, "rate must be at least 1000 and seconds positive\n");
+        return 1;
+    }
+
+    bufferFrames = rate / 100;
+    frames = (size_t)(rate * seconds) / bufferFrames * bufferFrames;
+    samples = frames * CHANNELS;
+    s16 = g_new(gint16, samples);
+    f32 = g_new(gfloat, samples);
+    f64 = g_new(gdouble, samples);
+
+    // Tones near the low bands and noise, well below full scale so that
+    // the boosts do not clip
+    srand(42);
+    for (i = 0; i < samples; i++) {
+        double t = (double)(i / CHANNELS) / rate;
+        double v = 4000.0 * sin(2.0 * G_PI * 40.0 * t) +
+                   3000.0 * sin(2.0 * G_PI * 900.0 * t) +
+                   2000.0 * ((double)rand() / RAND_MAX - 0.5);
+        s16[i] = (gint16)v;
+        f32[i] = s16[i];
+        f64[i] = s16[i];
+    }
+
+    printf("%d Hz, %d channels, %d bands, %.1f s in 10 ms buffers\n",
+           rate, CHANNELS, BANDS, (double)frames / rate);
+
+    equalizer = createEqualizer(GST_AUDIO_FORMAT_F64, rate);
+    if (!equalizer) {
+        fprintf(stderr, "cannot create the F64 equalizer\n");
+        return 1;
+    }
+    elapsed = filter(equalizer, (guint8*)f64, samples * sizeof(gdouble),
+                     bufferFrames * CHANNELS * sizeof(gdouble));
+    gst_object_unref(equalizer);
+    printResult("F64", samples, elapsed, 0.0, 0.0, 0.0);
+
+    equalizer = createEqualizer(GST_AUDIO_FORMAT_F32, rate);
+    if (!equalizer) {
+        fprintf(stderr, "cannot create the F32 equalizer\n");
+        return 1;
+    }
+    elapsed = filter(equalizer, (guint8*)f32, samples * sizeof(gfloat),
+                     bufferFrames * CHANNELS * sizeof(gfloat));
+    gst_object_unref(equalizer);
+    errorEnergy = peakError = 0.0;
+    for (i = 0; i < samples; i++) {
+        double error = f32[i] - f64[i];
+        signalEnergy += f64[i] * f64[i];
+        errorEnergy += error * error;
+        peakError = MAX(peakError, fabs(error));
+    }
+    printResult("F32", samples, elapsed, errorEnergy, peakError, signalEnergy);
+
+    // S16 output is rounded down, so is the reference it is compared with
+    equalizer = createEqualizer(GST_AUDIO_FORMAT_S16, rate);
+    if (!equalizer) {
+        fprintf(stderr, "cannot create the S16 equalizer\n");
+        return 1;
+    }
+    elapsed = filter(equalizer, (guint8*)s16, samples * sizeof(gint16),
+                     bufferFrames * CHANNELS * sizeof(gint16));
+    gst_object_unref(equalizer);
+    errorEnergy = peakError = 0.0;
+    for (i = 0; i < samples; i++) {
+        double error = s16[i] - floor(CLAMP(f64[i], -32768.0, 32767.0));
+        errorEnergy += error * error;
+        peakError = MAX(peakError, fabs(error));
+    }
+    printResult("S16", samples, elapsed, errorEnergy, peakError, signalEnergy);
+
+    g_free(s16);
+    g_free(f32);
+    g_free(f64);
+    return 0;
+}
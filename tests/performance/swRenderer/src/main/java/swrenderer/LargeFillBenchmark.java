@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package swrenderer;
+
+import javafx.animation.AnimationTimer;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.Group;
+import javafx.scene.Scene;
+import javafx.scene.image.Image;
+import javafx.scene.image.PixelWriter;
+import javafx.scene.image.WritableImage;
+import javafx.scene.paint.Color;
+import javafx.scene.paint.CycleMethod;
+import javafx.scene.paint.ImagePattern;
+import javafx.scene.paint.LinearGradient;
+import javafx.scene.paint.Paint;
+import javafx.scene.paint.RadialGradient;
+import javafx.scene.paint.Stop;
+import javafx.scene.shape.Rectangle;
+import javafx.stage.Stage;
+
+/**
+ * Measures the throughput of large gradient and texture fills in the
+ * software pipeline. Run it once per thread count and compare, e.g.
+ * <pre>
+ * java -Dprism.order=sw -Dprism.vsync=false -Djavafx.animation.fullspeed=true \
+ *      -Dprism.sw.threads=1 swrenderer.LargeFillBenchmark [linear|radial|texture]
+ * java -Dprism.order=sw -Dprism.vsync=false -Djavafx.animation.fullspeed=true \
+ *      -Dprism.sw.threads=4 swrenderer.LargeFillBenchmark [linear|radial|texture]
+ * </pre>
+ * Every frame moves a stack of overlapping rectangles that each cover most
+ * of the window, so the whole scene is repainted.
+ */
+public class LargeFillBenchmark extends Application {
+
+    private static final int WIDTH = 1600;
+    private static final int HEIGHT = 1200;
+    private static final int LAYERS = 8;
+    private static final int WARMUP_FRAMES = 60;
+    private static final int MEASURED_FRAMES = 600;
+
+    public static void main(String[] args) {
+        launch(args);
+    }
+
+    private Paint createPaint(String kind, int layer) {
+        Color c0 = Color.hsb(layer * 45, 0.8, 0.9, 0.7);
+        Color c1 = Color.hsb(layer * 45 + 120, 0.6, 0.7, 0.9);
+        switch (kind) {
+            case "radial":
+                return new RadialGradient(0, 0, 0.5, 0.5, 0.4, true, CycleMethod.REFLECT,
+                        new Stop(0, c0), new Stop(1, c1));
+            case "texture":
+                return new ImagePattern(createTexture(c0, c1), 0, 0, 97, 61, false);
+            default:
+                return new LinearGradient(0, 0, 1, 1, true, CycleMethod.REPEAT,
+                        new Stop(0, c0), new Stop(0.5, c1), new Stop(1, c0));
+        }
+    }
+
+    private Image createTexture(Color c0, Color c1) {
+        WritableImage image = new WritableImage(97, 61);
+        PixelWriter writer = image.getPixelWriter();
+        for (int y = 0; y < 61; y++) {
+            for (int x = 0; x < 97; x++) {
+                writer.setColor(x, y, c0.interpolate(c1, ((x ^ y) & 31) / 31.0));
+            }
+        }
+        return image;
+    }
+
+    @Override
+    public void start(Stage stage) {
+        String kind = getParameters().getRaw().isEmpty() ? "linear" : getParameters().getRaw().get(0);
+        Group root = new Group();
+        Rectangle[] layers = new Rectangle[LAYERS];
+        for (int i = 0; i < LAYERS; i++) {
+            layers[i] = new Rectangle(WIDTH * 0.9, HEIGHT * 0.9, createPaint(kind, i));
+            root.getChildren().add(layers[i]);
+        }
+        stage.setScene(new Scene(root, WIDTH, HEIGHT, Color.WHITE));
+        stage.setTitle(getClass().getSimpleName() + " " + kind);
+        stage.show();
+
+        new AnimationTimer() {
+            private int frame;
+            private long startTime;
+
+            @Override
+            public void handle(long now) {
+                if (frame == WARMUP_FRAMES) {
+                    startTime = System.nanoTime();
+                } else if (frame == WARMUP_FRAMES + MEASURED_FRAMES) {
+                    long elapsed = System.nanoTime() - startTime;
+                    System.out.printf("%s %s, prism.sw.threads=%s: %d frames, %.3f ms/frame\n",
+                            getClass().getSimpleName(), kind,
+                            System.getProperty("prism.sw.threads", "1"),
+                            MEASURED_FRAMES, elapsed / 1e6 / MEASURED_FRAMES);
+                    stop();
+                    Platform.exit();
+                    return;
+                }
+                for (int i = 0; i < LAYERS; i++) {
+                    double phase = (frame + i * 17) * 0.05;
+                    layers[i].setX(WIDTH * 0.05 * (1 + Math.sin(phase)));
+                    layers[i].setY(HEIGHT * 0.05 * (1 + Math.cos(phase)));
+                }
+                frame++;
+            }
+        }.start();
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package webview;
+
+/**
+ * Strokes a canvas polyline with tens of thousands of segments on each
+ * frame, so that the frame time is dominated by path construction.
+ */
+public class CanvasPolylineBenchmark extends WebPaintBenchmark {
+
+    private static final int SEGMENTS = 50000;
+
+    @Override
+    protected String getContent() {
+        return "<html><body style='margin:0'>"
+                + "<canvas id='c' width='1600' height='1200'></canvas>"
+                + "<script>"
+                + "var ctx = document.getElementById('c').getContext('2d');"
+                + "function step(frame) {"
+                + "  ctx.clearRect(0, 0, 1600, 1200);"
+                + "  ctx.beginPath();"
+                + "  ctx.moveTo(0, 600);"
+                + "  for (var i = 1; i < " + SEGMENTS + "; i++) {"
+                + "    ctx.lineTo(i * 1600 / " + SEGMENTS + ","
+                + "        600 + 500 * Math.sin((i + frame * 50) / 300));"
+                + "  }"
+                + "  ctx.stroke();"
+                + "}"
+                + "</script></body></html>";
+    }
+
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package webview;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.Base64;
+import java.util.List;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+
+/**
+ * Measures subresource integrity checks on megabyte-scale scripts. Each
+ * round loads a page that includes the scripts, once with and once without
+ * integrity attributes; the difference is the time spent hashing.
+ * <p>
+ * Run it once as is and once with {@code -Dcom.sun.webkit.nativeDigest=false}
+ * to compare the native digests with {@code java.security.MessageDigest}.
+ * The optional arguments are the digest algorithm (SHA-256, SHA-384 or
+ * SHA-512) and the size of each script in megabytes.
+ */
+public class DigestBenchmark extends Application {
+
+    private static final int SCRIPT_COUNT = 8;
+    private static final int WARMUP_ROUNDS = 3;
+    private static final int MEASURED_ROUNDS = 10;
+
+    private WebEngine engine;
+    private Path dir;
+    private String algorithm = "SHA-256";
+    private int megabytes = 4;
+    private Path withIntegrity;
+    private Path withoutIntegrity;
+    private int round;
+    private long startTime;
+    private long checkedTime;
+    private long uncheckedTime;
+
+    public static void main(String[] args) {
+        launch(args);
+    }
+
+    @Override
+    public void start(Stage stage) throws Exception {
+        List<String> args = getParameters().getRaw();
+        if (args.size() > 0) {
+            algorithm = args.get(0);
+        }
+        if (args.size() > 1) {
+            megabytes = Integer.parseInt(args.get(1));
+        }
+        createPages();
+
+        WebView webView = new WebView();
+        engine = webView.getEngine();
+        stage.setScene(new Scene(webView, 400, 300));
+        stage.setTitle(getClass().getSimpleName());
+        stage.show();
+
+        engine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED || n == Worker.State.FAILED) {
+                loaded();
+            }
+        });
+        load();
+    }
+
+    private void createPages() throws IOException, NoSuchAlgorithmException {
+        dir = Files.createTempDirectory("digest-benchmark");
+        dir.toFile().deleteOnExit();
+
+        // A long comment is cheap to parse, so the hash dominates the check
+        StringBuilder filler = new StringBuilder(megabytes << 20);
+        while (filler.length() < megabytes << 20) {
+            filler.append("// The quick brown fox jumps over the lazy dog 0123456789\n");
+        }
+
+        MessageDigest digest = MessageDigest.getInstance(algorithm);
+        String prefix = algorithm.replace("-", "").toLowerCase();
+        StringBuilder checked = new StringBuilder("<html><head>\n");
+        StringBuilder unchecked = new StringBuilder("<html><head>\n");
+        for (int i = 0; i < SCRIPT_COUNT; i++) {
+            byte[] script = (filler + "window.loaded = (window.loaded || 0) + " + (i + 1) + ";\n")
+                    .getBytes(StandardCharsets.UTF_8);
+            Path file = dir.resolve("script" + i + ".js");
+            Files.write(file, script);
+            file.toFile().deleteOnExit();
+
+            String hash = Base64.getEncoder().encodeToString(digest.digest(script));
+            String url = file.toUri().toASCIIString();
+            checked.append(String.format(
+                    "<script src='%s' integrity='%s-%s' crossorigin='anonymous'></script>\n",
+                    url, prefix, hash));
+            unchecked.append(String.format(
+                    "<script src='%s' crossorigin='anonymous'></script>\n", url));
+        }
+        checked.append("</head><body></body></html>\n");
+        unchecked.append("</head><body></body></html>\n");
+
+        // loadContent won't work with CORS, use file:// for the pages too
+        withIntegrity = dir.resolve("checked.html");
+        withoutIntegrity = dir.resolve("unchecked.html");
+        Files.writeString(withIntegrity, checked);
+        Files.writeString(withoutIntegrity, unchecked);
+        withIntegrity.toFile().deleteOnExit();
+        withoutIntegrity.toFile().deleteOnExit();
+    }
+
+    private void load() {
+        startTime = System.nanoTime();
+        engine.load((round % 2 == 0 ? withIntegrity : withoutIntegrity).toUri().toString());
+    }
+
+    private void loaded() {
+        long elapsed = System.nanoTime() - startTime;
+        Object scripts = engine.executeScript("window.loaded");
+        int expected = SCRIPT_COUNT * (SCRIPT_COUNT + 1) / 2;
+        if (!(scripts instanceof Number) || ((Number) scripts).intValue() != expected) {
+            System.err.println("Not all scripts passed the integrity check: " + scripts);
+            Platform.exit();
+            return;
+        }
+
+        if (round >= 2 * WARMUP_ROUNDS) {
+            if (round % 2 == 0) {
+                checkedTime += elapsed;
+            } else {
+                uncheckedTime += elapsed;
+            }
+        }
+        round++;
+        if (round < 2 * (WARMUP_ROUNDS + MEASURED_ROUNDS)) {
+            // Let the listener return before starting the next load
+            Platform.runLater(this::load);
+            return;
+        }
+
+        double checkedMs = checkedTime / 1e6 / MEASURED_ROUNDS;
+        double uncheckedMs = uncheckedTime / 1e6 / MEASURED_ROUNDS;
+        double hashedMB = (double) SCRIPT_COUNT * megabytes;
+        System.out.printf("%s: nativeDigest=%s, %s, %d x %d MB, "
+                + "%.3f ms/page with integrity, %.3f ms/page without, %.1f MB/s hashed\n",
+                getClass().getSimpleName(),
+                System.getProperty("com.sun.webkit.nativeDigest", "true"),
+                algorithm, SCRIPT_COUNT, megabytes, checkedMs, uncheckedMs,
+                hashedMB / Math.max(checkedMs - uncheckedMs, 1e-3) * 1e3);
+        Platform.exit();
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package webview;
+
+/**
+ * Paints a 10k-cell table and changes the text of every cell on each frame,
+ * so that the frame time is dominated by text rendering.
+ */
+public class TablePaintBenchmark extends WebPaintBenchmark {
+
+    private static final int ROWS = 500;
+    private static final int COLUMNS = 20;
+
+    @Override
+    protected String getContent() {
+        return "<html><head><style>"
+                + "td { font: 11px monospace; padding: 0 2px; }"
+                + "</style><script>"
+                + "function step(frame) {"
+                + "  var cells = document.getElementsByTagName('td');"
+                + "  for (var i = 0; i < cells.length; i++) {"
+                + "    cells[i].textContent = 'c' + ((i + frame) % 9973);"
+                + "  }"
+                + "}"
+                + "</script></head><body><table>"
+                + ("<tr>" + "<td></td>".repeat(COLUMNS) + "</tr>").repeat(ROWS)
+                + "</table></body></html>";
+    }
+
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
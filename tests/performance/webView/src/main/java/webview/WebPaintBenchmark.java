@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package webview;
+
+import javafx.animation.AnimationTimer;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+
+/**
+ * Base class for WebView painting benchmarks. The page returned by
+ * {@link #getContent()} must define a global {@code step(frame)} function
+ * that invalidates the content to be measured. The function is called
+ * once per pulse and the average frame time is printed at the end.
+ */
+public abstract class WebPaintBenchmark extends Application {
+
+    private static final int WARMUP_FRAMES = 60;
+    private static final int MEASURED_FRAMES = 600;
+
+    protected abstract String getContent();
+
+    @Override
+    public void start(Stage stage) {
+        WebView webView = new WebView();
+        WebEngine engine = webView.getEngine();
+        stage.setScene(new Scene(webView, 1600, 1200));
+        stage.setTitle(getClass().getSimpleName());
+        stage.show();
+
+        engine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED) {
+                run(engine);
+            }
+        });
+        engine.loadContent(getContent());
+    }
+
+    private void run(WebEngine engine) {
+        new AnimationTimer() {
+            private int frame;
+            private long startTime;
+
+            @Override
+            public void handle(long now) {
+                if (frame == WARMUP_FRAMES) {
+                    startTime = System.nanoTime();
+                } else if (frame == WARMUP_FRAMES + MEASURED_FRAMES) {
+                    long elapsed = System.nanoTime() - startTime;
+                    System.out.printf("%s: %d frames, %.3f ms/frame\n",
+                            getClass().getSimpleName(), MEASURED_FRAMES,
+                            elapsed / 1e6 / MEASURED_FRAMES);
+                    stop();
+                    Platform.exit();
+                    return;
+                }
+                engine.executeScript("step(" + frame + ")");
+                frame++;
+            }
+        }.start();
+    }
+}